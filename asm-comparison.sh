@@ -0,0 +1,136 @@
+#!/bin/bash
+
+# Compiles the typed / raw function pairs from benchmark/type-safety/*AsmComparison.cpp with
+# every available compiler and optimisation level, and fails if a typed function emits more
+# instructions than its raw counterpart, calls or jumps to any function other than its pair's
+# external sinks - instructions left out of line would not be counted - or, for pairs listing
+# forbidden instructions, any instruction whose mnemonic matches that regular expression.
+#
+# Usage: ./asm-comparison.sh [output directory]
+#
+# Environment:
+#   COMPILERS  compilers to try, missing ones are skipped (default: "g++ clang++")
+#   OPT_LEVELS optimisation levels (default: "-O2 -O3")
+#   CXXFLAGS   extra flags passed to every compilation
+#
+# Normalised listings of every function are written to the output directory (default:
+# build/asm-comparison), so that failures can be inspected with diff.
+
+ROOT_DIR=$(cd "$(dirname "$0")" && pwd)
+OUT_DIR=${1:-$ROOT_DIR/build/asm-comparison}
+COMPILERS=${COMPILERS:-"g++ clang++"}
+OPT_LEVELS=${OPT_LEVELS:-"-O2 -O3"}
+
+# file typed-function raw-function external-sinks [forbidden-mnemonics]
+#
+# external-sinks are the comma-separated functions of AsmComparisonSinks.cpp the typed
+# function may call, or - for none.
+PAIRS="
+AngleAsmComparison.cpp angle_test::callAngles angle_test::callFloats externalAngleSink
+UnitAsmComparison.cpp unit_test::callUnit unit_test::callFloats externalUnitSink
+PointAsmComparison.cpp point_test::callPoints point_test::callVec4s externalPointSink
+XformAsmComparison.cpp xform_test::callXforms xform_test::callMatrices externalPointSink
+PacketAsmComparison.cpp packet_test::callValuePackets packet_test::callValueIntrinsics -
+PacketAsmComparison.cpp packet_test::callAnglePackets packet_test::callAngleIntrinsics -
+PacketAsmComparison.cpp packet_test::callVec3Packets packet_test::callVec3Intrinsics -
+SwizzleAsmComparison.cpp swizzle_test::callSwizzles swizzle_test::callShuffles - v?mul|v?fn?madd|v?fn?msub
+SwizzleAsmComparison.cpp swizzle_test::callSwizzledXforms swizzle_test::callPermutedMatrices - v?mul|v?fn?madd|v?fn?msub
+"
+
+# Prints the instructions of the given (demangled) function, including compiler-generated
+# clones such as .cold parts, without directives, labels and comments. Local label numbers
+# are dropped, so that listings of both compilers and of both functions diff cleanly.
+extract_function() {
+	local asm_file=$1
+	local function_name=$2
+
+	c++filt < "$asm_file" | awk -v name="$function_name(" '
+		/^[^ \t.].*:$/ { inside = (index($0, name) == 1); next }
+		/^\.L[A-Za-z0-9_]*:/ { next }
+		inside && /^[ \t]+[a-z]/ {
+			sub(/[ \t]*#.*/, "")
+			gsub(/\.L[A-Za-z]*[0-9]+/, ".L")
+			sub(/^[ \t]+/, "")
+			print
+		}
+	'
+}
+
+# Prints the targets of the calls and jumps in a listing that leave the function, one per line,
+# without the arguments of demangled names.
+external_targets() {
+	awk '
+		/^(call|j[a-z]+)[ \t]/ {
+			sub(/^[a-z]+[ \t]+/, "")
+			sub(/\(.*/, "")
+			sub(/@PLT$/, "")
+			if (index($0, ".L") != 1) {
+				print
+			}
+		}
+	' "$1"
+}
+
+failures=0
+checked=0
+
+printf "%-10s %-4s %-28s %7s %7s\n" "compiler" "opt" "typed function" "typed" "raw"
+
+for compiler in $COMPILERS; do
+	if ! command -v "$compiler" > /dev/null; then
+		echo "$compiler not found, skipping"
+		continue
+	fi
+
+	for opt in $OPT_LEVELS; do
+		listing_dir="$OUT_DIR/$compiler/${opt#-}"
+		mkdir -p "$listing_dir"
+
+		while read -r file typed raw sinks forbidden; do
+			[ -z "$file" ] && continue
+
+			asm_file="$listing_dir/${file%.cpp}.s"
+			if ! "$compiler" -std=c++17 $opt -DNDEBUG -fno-asynchronous-unwind-tables $CXXFLAGS \
+				-I"$ROOT_DIR/src" -S "$ROOT_DIR/benchmark/type-safety/$file" -o "$asm_file"; then
+				echo "$compiler $opt: failed to compile $file"
+				failures=$((failures + 1))
+				continue
+			fi
+
+			extract_function "$asm_file" "$typed" > "$listing_dir/$typed.s"
+			extract_function "$asm_file" "$raw" > "$listing_dir/$raw.s"
+			typed_count=$(wc -l < "$listing_dir/$typed.s")
+			raw_count=$(wc -l < "$listing_dir/$raw.s")
+
+			status=""
+			if [ "$typed_count" -eq 0 ] || [ "$raw_count" -eq 0 ]; then
+				status="  NOT FOUND"
+				failures=$((failures + 1))
+			elif [ "$typed_count" -gt "$raw_count" ]; then
+				status="  OVERHEAD"
+				failures=$((failures + 1))
+			elif external_targets "$listing_dir/$typed.s" | grep -qvxF -e "${sinks//,/$'\n'}"; then
+				status="  CALLS"
+				failures=$((failures + 1))
+			elif [ -n "$forbidden" ] && grep -qE "^($forbidden)" "$listing_dir/$typed.s"; then
+				status="  FORBIDDEN"
+				failures=$((failures + 1))
+			fi
+			checked=$((checked + 1))
+
+			printf "%-10s %-4s %-28s %7d %7d%s\n" "$compiler" "$opt" "$typed" "$typed_count" "$raw_count" "$status"
+		done <<< "$PAIRS"
+	done
+done
+
+if [ "$checked" -eq 0 ]; then
+	echo "No compiler found"
+	exit 1
+fi
+
+if [ "$failures" -ne 0 ]; then
+	echo "$failures comparison(s) failed, listings in $OUT_DIR"
+	exit 1
+fi
+
+echo "All $checked comparisons passed"
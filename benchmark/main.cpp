@@ -1,3 +1,128 @@
 #include <benchmark/benchmark.h>
 
-BENCHMARK_MAIN();
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "type-safety/PerfProbe.hpp"
+
+// Runs the suite like BENCHMARK_MAIN does. JSON results are written with the standard flags:
+//
+//   type-safety-benchmark --benchmark_out=results.json --benchmark_out_format=json
+//
+// With --overhead_threshold=<fraction> every typed benchmark is additionally compared to its
+// raw-float baseline - the benchmark of the same name prefixed with "raw", so angleAddition/1024
+// is compared to rawAngleAddition/1024. The run fails if any typed benchmark takes more than
+// (1 + fraction) times the cpu time of its baseline.
+//
+// With --perf_counters the benchmarks also report hardware counters (cycles, instructions, IPC,
+// L1D/LLC misses and branch misses) on Linux. The counters are opt-in per benchmark: each one
+// constructs a benchmarking::PerfProbe right before its timing loop, and a new benchmark that
+// does not reports none.
+
+namespace /* anonymous */ {
+
+constexpr auto OVERHEAD_THRESHOLD_FLAG = "--overhead_threshold=";
+constexpr auto PERF_COUNTERS_FLAG = "--perf_counters";
+constexpr auto RAW_PREFIX = "raw";
+
+class OverheadReporter : public benchmark::ConsoleReporter {
+public:
+
+	void ReportRuns(const std::vector<Run>& reports) override {
+		benchmark::ConsoleReporter::ReportRuns(reports);
+
+		for (const auto& run : reports) {
+			if (run.run_type != Run::RT_Iteration || run.error_occurred) {
+				continue;
+			}
+
+			// Keep the fastest repetition, which is the least disturbed by noise
+			const auto name = run.benchmark_name();
+			const auto time = run.GetAdjustedCPUTime();
+			const auto it = cpuTimes_.find(name);
+			if (it == cpuTimes_.end()) {
+				cpuTimes_.emplace(name, time);
+			} else {
+				it->second = std::min(it->second, time);
+			}
+		}
+	}
+
+	// Prints typed / raw time ratios and returns the number of pairs over the threshold.
+	int reportOverheads(double threshold) const {
+		const auto prefixLength = std::strlen(RAW_PREFIX);
+		auto exceeded = 0;
+
+		std::cout << "\nTyped vs raw overhead (threshold " << threshold * 100.0 << "%):\n";
+		for (const auto& [rawName, rawTime] : cpuTimes_) {
+			if (rawName.compare(0, prefixLength, RAW_PREFIX) != 0 || rawName.size() <= prefixLength) {
+				continue;
+			}
+
+			auto typedName = rawName.substr(prefixLength);
+			typedName[0] = static_cast<char>(std::tolower(static_cast<unsigned char>(typedName[0])));
+
+			const auto typed = cpuTimes_.find(typedName);
+			if (typed == cpuTimes_.end() || rawTime <= 0.0) {
+				continue;
+			}
+
+			const auto overhead = typed->second / rawTime - 1.0;
+			const auto isExceeded = overhead > threshold;
+			exceeded += isExceeded ? 1 : 0;
+
+			std::cout << std::left << std::setw(48) << typedName << std::right << std::showpos << std::fixed
+				<< std::setprecision(1) << std::setw(8) << overhead * 100.0 << "%" << std::noshowpos
+				<< (isExceeded ? "  EXCEEDED" : "") << '\n';
+		}
+
+		return exceeded;
+	}
+
+private:
+
+	std::map<std::string, double> cpuTimes_;
+
+};
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+	auto threshold = -1.0;
+	auto remaining = 1;
+	for (auto i = 1; i < argc; ++i) {
+		if (std::strncmp(argv[i], OVERHEAD_THRESHOLD_FLAG, std::strlen(OVERHEAD_THRESHOLD_FLAG)) == 0) {
+			threshold = std::atof(argv[i] + std::strlen(OVERHEAD_THRESHOLD_FLAG));
+		} else if (std::strcmp(argv[i], PERF_COUNTERS_FLAG) == 0) {
+			type_safety::benchmarking::perfCountersEnabled() = true;
+		} else {
+			argv[remaining++] = argv[i];
+		}
+	}
+	argc = remaining;
+
+	if (type_safety::benchmarking::perfCountersEnabled() && !type_safety::PerfCounters{}.available()) {
+		std::cerr << "Hardware performance counters are unavailable, running without them\n";
+	}
+
+	benchmark::Initialize(&argc, argv);
+	if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+		return 1;
+	}
+
+	if (threshold < 0.0) {
+		benchmark::RunSpecifiedBenchmarks();
+		return 0;
+	}
+
+	auto reporter = OverheadReporter{};
+	benchmark::RunSpecifiedBenchmarks(&reporter);
+	return reporter.reportOverheads(threshold) == 0 ? 0 : 1;
+}
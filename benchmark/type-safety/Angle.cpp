@@ -1,90 +1,234 @@
 #include <benchmark/benchmark.h>
 
-#include <ctime>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
 
 #include "type-safety/Angle.hpp"
+#include "type-safety/PerfProbe.hpp"
+
+// Every typed benchmark has a raw-float baseline named raw<Name>, see benchmark/main.cpp.
 
 namespace /* anonymous */ {
 
 using namespace type_safety;
 using namespace type_safety::angle_literals;
 
-void angleDefaultConstruction(benchmark::State& state) {
-	std::srand(0);
-	const auto input = static_cast<float>(std::rand());
+std::vector<float> randomFloats(std::size_t count, unsigned int seed) {
+	std::srand(seed);
+	auto result = std::vector<float>{};
+	result.reserve(count);
+	for (auto i = 0u; i < count; ++i) {
+		result.push_back(static_cast<float>(std::rand()) / static_cast<float>(RAND_MAX) * 6.28f - 3.14f);
+	}
+	return result;
+}
+
+std::vector<Angle> randomAngles(std::size_t count, unsigned int seed) {
+	auto result = std::vector<Angle>{};
+	result.reserve(count);
+	for (const auto radians : randomFloats(count, seed)) {
+		result.emplace_back(radiansTag, radians);
+	}
+	return result;
+}
+
+// Reports throughput of an elementwise operation reading inputs and writing one output of
+// ElementT per item.
+template <class ElementT>
+void reportThroughput(benchmark::State& state, int inputs) {
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+	state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<std::int64_t>((inputs + 1) * sizeof(ElementT)));
+}
+
+void angleAddition(benchmark::State& state) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+	const auto lhs = randomAngles(count, 0);
+	const auto rhs = randomAngles(count, 1);
+	auto results = std::vector<Angle>(count);
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		for (auto i = 0u; i < count; ++i) {
+			results[i] = lhs[i] + rhs[i];
+		}
+		benchmark::DoNotOptimize(results.data());
+		benchmark::ClobberMemory();
+	}
+
+	reportThroughput<Angle>(state, 2);
+}
+
+void rawAngleAddition(benchmark::State& state) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+	const auto lhs = randomFloats(count, 0);
+	const auto rhs = randomFloats(count, 1);
+	auto results = std::vector<float>(count);
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		for (auto i = 0u; i < count; ++i) {
+			results[i] = lhs[i] + rhs[i];
+		}
+		benchmark::DoNotOptimize(results.data());
+		benchmark::ClobberMemory();
+	}
+
+	reportThroughput<float>(state, 2);
+}
 
+void angleScaling(benchmark::State& state) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+	const auto angles = randomAngles(count, 0);
+	const auto factors = randomFloats(count, 1);
+	auto results = std::vector<Angle>(count);
+
+	const auto probe = benchmarking::PerfProbe{state};
 	for (auto _ : state) {
-		auto a = Angle{};
-		benchmark::DoNotOptimize(a.radians() == input);
+		for (auto i = 0u; i < count; ++i) {
+			results[i] = angles[i] * factors[i];
+		}
+		benchmark::DoNotOptimize(results.data());
+		benchmark::ClobberMemory();
 	}
+
+	reportThroughput<Angle>(state, 2);
 }
 
-void floatDefaultConstruction(benchmark::State& state) {
-	std::srand(0);
-	const auto input = static_cast<float>(std::rand());
+void rawAngleScaling(benchmark::State& state) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+	const auto angles = randomFloats(count, 0);
+	const auto factors = randomFloats(count, 1);
+	auto results = std::vector<float>(count);
 
+	const auto probe = benchmarking::PerfProbe{state};
 	for (auto _ : state) {
-		auto a = float();
-		benchmark::DoNotOptimize(a == input);
+		for (auto i = 0u; i < count; ++i) {
+			results[i] = angles[i] * factors[i];
+		}
+		benchmark::DoNotOptimize(results.data());
+		benchmark::ClobberMemory();
 	}
+
+	reportThroughput<float>(state, 2);
 }
 
-void angleValueConstruction(benchmark::State& state) {
-	std::srand(0);
-	const auto input = static_cast<float>(std::rand());
+void angleStepping(benchmark::State& state) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+	auto angles = randomAngles(count, 0);
+	const auto step = 0.01_rad;
 
+	const auto probe = benchmarking::PerfProbe{state};
 	for (auto _ : state) {
-		auto a = Angle{radiansTag, 42.0f};
-		benchmark::DoNotOptimize(a.radians() == input);
+		for (auto& angle : angles) {
+			angle += step;
+		}
+		benchmark::DoNotOptimize(angles.data());
+		benchmark::ClobberMemory();
 	}
+
+	reportThroughput<Angle>(state, 1);
 }
 
-void floatValueConstruction(benchmark::State& state) {
-	std::srand(0);
-	const auto input = static_cast<float>(std::rand());
+void rawAngleStepping(benchmark::State& state) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+	auto angles = randomFloats(count, 0);
+	const auto step = 0.01f;
 
+	const auto probe = benchmarking::PerfProbe{state};
 	for (auto _ : state) {
-		auto a = 42.0f;
-		benchmark::DoNotOptimize(a == input);
+		for (auto& angle : angles) {
+			angle += step;
+		}
+		benchmark::DoNotOptimize(angles.data());
+		benchmark::ClobberMemory();
 	}
+
+	reportThroughput<float>(state, 1);
 }
 
-void angleLiteralConstruction(benchmark::State& state) {
-	std::srand(0);
-	const auto input = static_cast<float>(std::rand());
+void angleToDegrees(benchmark::State& state) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+	const auto angles = randomAngles(count, 0);
+	auto results = std::vector<float>(count);
 
+	const auto probe = benchmarking::PerfProbe{state};
 	for (auto _ : state) {
-		auto a = 42.0_rad;
-		benchmark::DoNotOptimize(a.radians() == input);
+		for (auto i = 0u; i < count; ++i) {
+			results[i] = angles[i].degrees();
+		}
+		benchmark::DoNotOptimize(results.data());
+		benchmark::ClobberMemory();
 	}
+
+	reportThroughput<float>(state, 1);
 }
 
-void angleArithmetics(benchmark::State& state) {
-	std::srand(0);
-	const auto input = Angle{radiansTag, static_cast<float>(std::rand())};
+void rawAngleToDegrees(benchmark::State& state) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+	const auto angles = randomFloats(count, 0);
+	auto results = std::vector<float>(count);
 
-	auto a = 42_rad;
+	const auto probe = benchmarking::PerfProbe{state};
 	for (auto _ : state) {
-		benchmark::DoNotOptimize(a += input);
+		for (auto i = 0u; i < count; ++i) {
+			results[i] = angles[i] * (180.0f / PI);
+		}
+		benchmark::DoNotOptimize(results.data());
+		benchmark::ClobberMemory();
 	}
+
+	reportThroughput<float>(state, 1);
+}
+
+void angleComparison(benchmark::State& state) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+	const auto lhs = randomAngles(count, 0);
+	const auto rhs = randomAngles(count, 1);
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		auto smaller = 0;
+		for (auto i = 0u; i < count; ++i) {
+			smaller += lhs[i] < rhs[i] ? 1 : 0;
+		}
+		benchmark::DoNotOptimize(smaller);
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+	state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<std::int64_t>(2 * sizeof(Angle)));
 }
 
-void floatArithmetics(benchmark::State& state) {
-	std::srand(0);
-	const auto input = static_cast<float>(std::rand());
+void rawAngleComparison(benchmark::State& state) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+	const auto lhs = randomFloats(count, 0);
+	const auto rhs = randomFloats(count, 1);
 
-	auto a = 42.0f;
+	const auto probe = benchmarking::PerfProbe{state};
 	for (auto _ : state) {
-		benchmark::DoNotOptimize(a += input);
+		auto smaller = 0;
+		for (auto i = 0u; i < count; ++i) {
+			smaller += lhs[i] < rhs[i] ? 1 : 0;
+		}
+		benchmark::DoNotOptimize(smaller);
 	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+	state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<std::int64_t>(2 * sizeof(float)));
 }
 
-BENCHMARK(angleDefaultConstruction);
-BENCHMARK(floatDefaultConstruction);
-BENCHMARK(angleValueConstruction);
-BENCHMARK(floatValueConstruction);
-BENCHMARK(angleLiteralConstruction);
-BENCHMARK(angleArithmetics);
-BENCHMARK(floatArithmetics);
+constexpr auto MIN_BATCH = 1 << 10;
+constexpr auto MAX_BATCH = 1 << 20;
+
+BENCHMARK(angleAddition)->RangeMultiplier(32)->Range(MIN_BATCH, MAX_BATCH);
+BENCHMARK(rawAngleAddition)->RangeMultiplier(32)->Range(MIN_BATCH, MAX_BATCH);
+BENCHMARK(angleScaling)->RangeMultiplier(32)->Range(MIN_BATCH, MAX_BATCH);
+BENCHMARK(rawAngleScaling)->RangeMultiplier(32)->Range(MIN_BATCH, MAX_BATCH);
+BENCHMARK(angleStepping)->RangeMultiplier(32)->Range(MIN_BATCH, MAX_BATCH);
+BENCHMARK(rawAngleStepping)->RangeMultiplier(32)->Range(MIN_BATCH, MAX_BATCH);
+BENCHMARK(angleToDegrees)->RangeMultiplier(32)->Range(MIN_BATCH, MAX_BATCH);
+BENCHMARK(rawAngleToDegrees)->RangeMultiplier(32)->Range(MIN_BATCH, MAX_BATCH);
+BENCHMARK(angleComparison)->RangeMultiplier(32)->Range(MIN_BATCH, MAX_BATCH);
+BENCHMARK(rawAngleComparison)->RangeMultiplier(32)->Range(MIN_BATCH, MAX_BATCH);
 
 } // anonymous namespace
@@ -1,11 +1,9 @@
 #include "type-safety/Unit.hpp"
 #include "type-safety/Angle.hpp"
+#include "type-safety/Point.hpp"
 
 using namespace type_safety;
 
-using Joulles = decltype(Kilograms{} * Metres{} * Metres{} / (Seconds{} * Seconds{}));
-using Energy = Value<Joulles>;
-
 float externalAngleSink(
 	[[maybe_unused]] Angle pitch,
 	[[maybe_unused]] Angle yaw,
@@ -23,9 +21,17 @@ float externalAngleFloatSink(
 }
 
 float externalUnitSink([[maybe_unused]] Energy e) {
-	return e.value<Joulles>();
+	return e.value<Joules>();
 }
 
 float externalUnitFloatSink([[maybe_unused]] float f) {
 	return f;
 }
+
+float externalPointSink([[maybe_unused]] Position<space::Camera> p) {
+	return p.vector().get(0);
+}
+
+float externalPointVec4Sink([[maybe_unused]] Vec4 p) {
+	return p.get(0);
+}
@@ -0,0 +1,142 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include "type-safety/BinaryAngle.hpp"
+#include "type-safety/PerfProbe.hpp"
+
+namespace /* anonymous */ {
+
+using namespace type_safety;
+using namespace type_safety::angle_literals;
+
+constexpr auto DRIFT_STEPS = 1000000;
+constexpr auto DRIFT_STEP_DEGREES = 0.37;
+
+// Difference in degrees between an angle accumulated DRIFT_STEPS times and the exact result.
+template <class AccumulateT>
+double accumulationDrift(AccumulateT accumulate) {
+	const auto exact = std::fmod(DRIFT_STEPS * DRIFT_STEP_DEGREES, 360.0);
+	const auto accumulated = std::fmod(static_cast<double>(accumulate().wrapped().degrees()), 360.0);
+	const auto difference = std::abs(accumulated - exact);
+	return std::min(difference, 360.0 - difference);
+}
+
+template <class AngleT>
+std::vector<AngleT> randomRotations(std::size_t count) {
+	std::srand(0);
+	auto result = std::vector<AngleT>{};
+	result.reserve(count);
+	for (auto i = 0u; i < count; ++i) {
+		result.emplace_back(Angle{degreesTag, static_cast<float>(std::rand() % 360)});
+	}
+	return result;
+}
+
+template <class AngleT>
+void reportThroughput(benchmark::State& state) {
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+	state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<std::int64_t>(2 * sizeof(AngleT)));
+	state.counters["bytes_per_angle"] = static_cast<double>(sizeof(AngleT));
+}
+
+void angleAccumulation(benchmark::State& state) {
+	auto actors = randomRotations<Angle>(static_cast<std::size_t>(state.range(0)));
+	const auto step = Angle{degreesTag, static_cast<float>(DRIFT_STEP_DEGREES)};
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		for (auto& rotation : actors) {
+			rotation += step;
+		}
+		benchmark::DoNotOptimize(actors.data());
+		benchmark::ClobberMemory();
+	}
+
+	reportThroughput<Angle>(state);
+	state.counters["drift_deg"] = accumulationDrift([step] {
+			auto a = 0_rad;
+			for (auto i = 0; i < DRIFT_STEPS; ++i) {
+				a += step;
+			}
+			return a;
+		});
+}
+
+void angleNormalizedAccumulation(benchmark::State& state) {
+	auto actors = randomRotations<Angle>(static_cast<std::size_t>(state.range(0)));
+	const auto step = Angle{degreesTag, static_cast<float>(DRIFT_STEP_DEGREES)};
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		for (auto& rotation : actors) {
+			rotation = (rotation + step).normalized();
+		}
+		benchmark::DoNotOptimize(actors.data());
+		benchmark::ClobberMemory();
+	}
+
+	reportThroughput<Angle>(state);
+	state.counters["drift_deg"] = accumulationDrift([step] {
+			auto a = 0_rad;
+			for (auto i = 0; i < DRIFT_STEPS; ++i) {
+				a = (a + step).normalized();
+			}
+			return a;
+		});
+}
+
+template <int BITS>
+void binaryAngleAccumulation(benchmark::State& state) {
+	auto actors = randomRotations<BinaryAngle<BITS>>(static_cast<std::size_t>(state.range(0)));
+	const auto step = BinaryAngle<BITS>{Angle{degreesTag, static_cast<float>(DRIFT_STEP_DEGREES)}};
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		for (auto& rotation : actors) {
+			rotation += step;
+		}
+		benchmark::DoNotOptimize(actors.data());
+		benchmark::ClobberMemory();
+	}
+
+	reportThroughput<BinaryAngle<BITS>>(state);
+	state.counters["drift_deg"] = accumulationDrift([step] {
+			auto a = BinaryAngle<BITS>{};
+			for (auto i = 0; i < DRIFT_STEPS; ++i) {
+				a += step;
+			}
+			return a.angle();
+		});
+}
+
+void angleNormalization(benchmark::State& state) {
+	auto actors = randomRotations<Angle>(static_cast<std::size_t>(state.range(0)));
+	for (auto& rotation : actors) {
+		rotation *= 100.0f;
+	}
+	auto normalized = std::vector<Angle>(actors.size());
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		for (auto i = 0u; i < actors.size(); ++i) {
+			normalized[i] = actors[i].normalized();
+		}
+		benchmark::DoNotOptimize(normalized.data());
+		benchmark::ClobberMemory();
+	}
+
+	reportThroughput<Angle>(state);
+}
+
+BENCHMARK(angleAccumulation)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(angleNormalizedAccumulation)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(binaryAngleAccumulation, 16)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(binaryAngleAccumulation, 32)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(angleNormalization)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+
+} // anonymous namespace
@@ -0,0 +1,191 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include "type-safety/CompactPoint.hpp"
+#include "type-safety/Xform.hpp"
+#include "type-safety/simd.hpp"
+#include "type-safety/PerfProbe.hpp"
+
+// Every typed benchmark has a raw-float baseline named raw<Name>, see benchmark/main.cpp.
+//
+// Arrays of points transformed into another array, 16-byte Points against 12-byte
+// CompactPoints. Past the last level cache the transform is bound by memory bandwidth, so the
+// compact layout's 25% fewer bytes per point show directly in items per second. The layouts
+// are compared at the same 4-wide arithmetic by compactPointTransform and vec4SimdTransform -
+// fullPointTransform and its baseline transform one point at a time.
+
+namespace /* anonymous */ {
+
+using namespace type_safety;
+
+Matrix randomAffineMatrix() {
+	std::srand(0);
+	auto matrix = Matrix{};
+	for (auto row = 0u; row < 4u; ++row) {
+		for (auto column = 0u; column < 4u; ++column) {
+			matrix.get(row, column) = row == 3u ? (column == 3u ? 1.0f : 0.0f) : static_cast<float>(std::rand() % 200 - 100) / 100.0f;
+		}
+	}
+	return matrix;
+}
+
+std::vector<Vec3> randomVec3s(std::size_t count) {
+	std::srand(1);
+	auto result = std::vector<Vec3>{};
+	result.reserve(count);
+	for (auto i = 0u; i < count; ++i) {
+		const auto coordinate = [] { return static_cast<float>(std::rand() % 2000 - 1000) / 100.0f; };
+		result.emplace_back(coordinate(), coordinate(), coordinate());
+	}
+	return result;
+}
+
+void reportThroughput(benchmark::State& state, std::size_t bytesPerPoint) {
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+	state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<std::int64_t>(bytesPerPoint));
+}
+
+void compactPointTransform(benchmark::State& state) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+	const auto xform = Xform<space::World, space::Camera>{randomAffineMatrix()};
+	auto points = std::vector<CompactPoint<space::World, Metres>>{};
+	for (const auto& v : randomVec3s(count)) {
+		points.emplace_back(v);
+	}
+	auto results = std::vector<CompactPoint<space::Camera, Metres>>(count);
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		applyAll(xform, points.data(), count, results.data());
+		benchmark::DoNotOptimize(results.data());
+		benchmark::ClobberMemory();
+	}
+
+	reportThroughput(state, 2 * sizeof(CompactPoint<space::World, Metres>));
+}
+
+void rawCompactPointTransform(benchmark::State& state) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+	const auto matrix = randomAffineMatrix();
+	auto points = std::vector<float>{};
+	for (const auto& v : randomVec3s(count)) {
+		points.insert(points.end(), { v.get(0), v.get(1), v.get(2) });
+	}
+	auto results = std::vector<float>(3 * count);
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		for (auto i = 0u; i < count; ++i) {
+			const auto* p = points.data() + 3 * i;
+			for (auto row = 0u; row < 3u; ++row) {
+				results[3 * i + row] =
+					matrix.get(row, 0) * p[0] + matrix.get(row, 1) * p[1] + matrix.get(row, 2) * p[2] + matrix.get(row, 3);
+			}
+		}
+		benchmark::DoNotOptimize(results.data());
+		benchmark::ClobberMemory();
+	}
+
+	reportThroughput(state, 2 * 3 * sizeof(float));
+}
+
+// The 16-byte layout, for comparison
+void fullPointTransform(benchmark::State& state) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+	const auto xform = Xform<space::World, space::Camera>{randomAffineMatrix()};
+	auto points = std::vector<Point<space::World, Metres>>{};
+	for (const auto& v : randomVec3s(count)) {
+		points.emplace_back(v);
+	}
+	auto results = std::vector<Point<space::Camera, Metres>>(count);
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		for (auto i = 0u; i < count; ++i) {
+			results[i] = xform.apply(points[i]);
+		}
+		benchmark::DoNotOptimize(results.data());
+		benchmark::ClobberMemory();
+	}
+
+	reportThroughput(state, 2 * sizeof(Point<space::World, Metres>));
+}
+
+void rawFullPointTransform(benchmark::State& state) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+	const auto matrix = randomAffineMatrix();
+	auto points = std::vector<Vec4>{};
+	for (const auto& v : randomVec3s(count)) {
+		points.emplace_back(v, 1.0f);
+	}
+	auto results = std::vector<Vec4>(count);
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		for (auto i = 0u; i < count; ++i) {
+			results[i] = matrix * points[i];
+		}
+		benchmark::DoNotOptimize(results.data());
+		benchmark::ClobberMemory();
+	}
+
+	reportThroughput(state, 2 * sizeof(Vec4));
+}
+
+// The 16-byte layout through 4-wide SIMD arithmetic like applyAll's, but a Float4 load per
+// point, its coordinates broadcast against the matrix columns, in place of the interleave
+// shuffles.
+void multiplyAffineVec4s(const Matrix& matrix, const Vec4* source, std::size_t count, Vec4* target) {
+	static_assert(sizeof(Vec4) == simd::LANES * sizeof(float));
+
+	const auto column = [&](std::size_t c) {
+		const float elements[] = { matrix.get(0, c), matrix.get(1, c), matrix.get(2, c), matrix.get(3, c) };
+		return simd::Float4::load(elements);
+	};
+	const auto c0 = column(0);
+	const auto c1 = column(1);
+	const auto c2 = column(2);
+	const auto c3 = column(3);
+
+	const auto* in = reinterpret_cast<const float*>(source);
+	auto* out = reinterpret_cast<float*>(target);
+	for (auto i = std::size_t{0}; i < count; ++i) {
+		const auto p = simd::Float4::load(in + simd::LANES * i);
+		const auto result =
+			c0 * simd::shuffle<0, 0, 0, 0>(p) +
+			c1 * simd::shuffle<1, 1, 1, 1>(p) +
+			c2 * simd::shuffle<2, 2, 2, 2>(p) +
+			c3;
+		result.store(out + simd::LANES * i);
+	}
+}
+
+void vec4SimdTransform(benchmark::State& state) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+	const auto matrix = randomAffineMatrix();
+	auto points = std::vector<Vec4>{};
+	for (const auto& v : randomVec3s(count)) {
+		points.emplace_back(v, 1.0f);
+	}
+	auto results = std::vector<Vec4>(count);
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		multiplyAffineVec4s(matrix, points.data(), count, results.data());
+		benchmark::DoNotOptimize(results.data());
+		benchmark::ClobberMemory();
+	}
+
+	reportThroughput(state, 2 * sizeof(Vec4));
+}
+
+BENCHMARK(compactPointTransform)->RangeMultiplier(32)->Range(1024, 4 * 1024 * 1024);
+BENCHMARK(rawCompactPointTransform)->RangeMultiplier(32)->Range(1024, 4 * 1024 * 1024);
+BENCHMARK(fullPointTransform)->RangeMultiplier(32)->Range(1024, 4 * 1024 * 1024);
+BENCHMARK(rawFullPointTransform)->RangeMultiplier(32)->Range(1024, 4 * 1024 * 1024);
+BENCHMARK(vec4SimdTransform)->RangeMultiplier(32)->Range(1024, 4 * 1024 * 1024);
+
+} // anonymous namespace
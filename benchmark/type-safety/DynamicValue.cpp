@@ -0,0 +1,132 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+#include <vector>
+
+#include "type-safety/DynamicValue.hpp"
+#include "type-safety/PerfProbe.hpp"
+
+// Every typed benchmark has a raw-float baseline named raw<Name>, see benchmark/main.cpp.
+
+namespace /* anonymous */ {
+
+using namespace type_safety;
+using namespace type_safety::unit_literals;
+
+std::vector<float> randomFloats(std::size_t count, unsigned int seed) {
+	std::srand(seed);
+	auto result = std::vector<float>{};
+	result.reserve(count);
+	for (auto i = 0u; i < count; ++i) {
+		result.push_back(static_cast<float>(std::rand()) / static_cast<float>(RAND_MAX) * 100.0f);
+	}
+	return result;
+}
+
+// The hand-written mapping the dynamic units replace
+enum class SpeedUnitCode {
+	METRES_PER_SECOND,
+	KILOMETRES_PER_HOUR,
+	MILES_PER_HOUR,
+};
+
+float toMetresPerSecond(float value, SpeedUnitCode unit) {
+	switch (unit) {
+	case SpeedUnitCode::METRES_PER_SECOND:
+		return value;
+	case SpeedUnitCode::KILOMETRES_PER_HOUR:
+		return value / 3.6f;
+	case SpeedUnitCode::MILES_PER_HOUR:
+		return value * 0.44704f;
+	}
+	throw std::invalid_argument("Unknown speed unit");
+}
+
+// Every iteration integrates a freshly read batch of speeds in km/h - copied from the input
+// first, as a parser would write them - into positions in metres.
+void rawSwitchPipeline(benchmark::State& state, SpeedUnitCode unit) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+	const auto input = randomFloats(count, 0);
+	auto batch = std::vector<float>(count);
+	auto positions = randomFloats(count, 1);
+	const auto dt = 0.016f;
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		std::copy(input.begin(), input.end(), batch.begin());
+		for (auto i = 0u; i < count; ++i) {
+			positions[i] += toMetresPerSecond(batch[i], unit) * dt;
+		}
+		benchmark::DoNotOptimize(positions.data());
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void dynamicColumnPipeline(benchmark::State& state) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+	const auto input = randomFloats(count, 0);
+	auto batch = std::vector<float>(count);
+	auto positions = std::vector<Distance>(count);
+	std::transform(input.begin(), input.end(), positions.begin(), [](float f) { return makeValue<Metres>(f); });
+	auto converted = std::vector<Speed>(count);
+	const auto unit = *unitFromSymbol("km/h");
+	const auto dt = Time{16_ms};
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		std::copy(input.begin(), input.end(), batch.begin());
+		const auto column = DynamicColumn{batch.data(), count, unit};
+		const auto speeds = *column.convertTo<MPS>(converted.data());
+		for (auto i = 0u; i < count; ++i) {
+			positions[i] += speeds[i] * dt;
+		}
+		benchmark::DoNotOptimize(positions.data());
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void rawDynamicColumnPipeline(benchmark::State& state) {
+	rawSwitchPipeline(state, SpeedUnitCode::KILOMETRES_PER_HOUR);
+}
+
+void dynamicValuePipeline(benchmark::State& state) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+	const auto input = randomFloats(count, 0);
+	auto batch = std::vector<float>(count);
+	auto positions = std::vector<Distance>(count);
+	std::transform(input.begin(), input.end(), positions.begin(), [](float f) { return makeValue<Metres>(f); });
+	const auto unit = *unitFromSymbol("km/h");
+	const auto dt = Time{16_ms};
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		std::copy(input.begin(), input.end(), batch.begin());
+		for (auto i = 0u; i < count; ++i) {
+			positions[i] += *DynamicValue{batch[i], unit}.as<MPS>() * dt;
+		}
+		benchmark::DoNotOptimize(positions.data());
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void rawDynamicValuePipeline(benchmark::State& state) {
+	rawSwitchPipeline(state, SpeedUnitCode::KILOMETRES_PER_HOUR);
+}
+
+constexpr auto MIN_BATCH = 1 << 10;
+constexpr auto MAX_BATCH = 1 << 20;
+
+BENCHMARK(dynamicColumnPipeline)->RangeMultiplier(32)->Range(MIN_BATCH, MAX_BATCH);
+BENCHMARK(rawDynamicColumnPipeline)->RangeMultiplier(32)->Range(MIN_BATCH, MAX_BATCH);
+BENCHMARK(dynamicValuePipeline)->RangeMultiplier(32)->Range(MIN_BATCH, MAX_BATCH);
+BENCHMARK(rawDynamicValuePipeline)->RangeMultiplier(32)->Range(MIN_BATCH, MAX_BATCH);
+
+} // anonymous namespace
@@ -0,0 +1,94 @@
+#include <benchmark/benchmark.h>
+
+#include <memory_resource>
+#include <vector>
+
+#include "type-safety/FrameArena.hpp"
+#include "type-safety/Xform.hpp"
+#include "type-safety/PerfProbe.hpp"
+
+// Every typed benchmark has a raw-float baseline named raw<Name>, see benchmark/main.cpp. The
+// baselines here are the same frames built with the global allocator.
+//
+// A frame builds state.range(0) temporary Xforms and as many Points in containers growing one
+// element at a time, reads them back and throws them away.
+
+namespace /* anonymous */ {
+
+using namespace type_safety;
+
+using PlayerToWorld = Xform<space::Player, space::World>;
+
+using PlayerPoint = Point<space::Player, Metres>;
+
+template <class XformVectorT, class PointVectorT>
+float buildFrame(XformVectorT& xforms, PointVectorT& points, std::size_t count) {
+	for (auto i = std::size_t{0}; i < count; ++i) {
+		xforms.emplace_back();
+		points.emplace_back(Vec3{static_cast<float>(i), 0.0f, 0.0f});
+	}
+	return xforms.back().matrix().get(0, 0) + points.back().vector().get(0);
+}
+
+void arenaFrame(benchmark::State& state) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+	auto arena = FrameArena{};
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		arena.reset();
+		auto xforms = FrameVector<PlayerToWorld>(ArenaAllocator<PlayerToWorld>{arena});
+		auto points = FrameVector<PlayerPoint>(ArenaAllocator<PlayerPoint>{arena});
+		benchmark::DoNotOptimize(buildFrame(xforms, points, count));
+	}
+
+	state.SetItemsProcessed(state.iterations() * count);
+}
+
+void rawArenaFrame(benchmark::State& state) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		auto xforms = std::vector<PlayerToWorld>{};
+		auto points = std::vector<PlayerPoint>{};
+		benchmark::DoNotOptimize(buildFrame(xforms, points, count));
+	}
+
+	state.SetItemsProcessed(state.iterations() * count);
+}
+
+void pmrArenaFrame(benchmark::State& state) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+	auto arena = FrameArena{};
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		arena.reset();
+		auto xforms = std::pmr::vector<PlayerToWorld>(&arena);
+		auto points = std::pmr::vector<PlayerPoint>(&arena);
+		benchmark::DoNotOptimize(buildFrame(xforms, points, count));
+	}
+
+	state.SetItemsProcessed(state.iterations() * count);
+}
+
+void rawPmrArenaFrame(benchmark::State& state) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		auto xforms = std::pmr::vector<PlayerToWorld>(std::pmr::new_delete_resource());
+		auto points = std::pmr::vector<PlayerPoint>(std::pmr::new_delete_resource());
+		benchmark::DoNotOptimize(buildFrame(xforms, points, count));
+	}
+
+	state.SetItemsProcessed(state.iterations() * count);
+}
+
+BENCHMARK(arenaFrame)->RangeMultiplier(8)->Range(64, 32 * 1024);
+BENCHMARK(rawArenaFrame)->RangeMultiplier(8)->Range(64, 32 * 1024);
+BENCHMARK(pmrArenaFrame)->RangeMultiplier(8)->Range(64, 32 * 1024);
+BENCHMARK(rawPmrArenaFrame)->RangeMultiplier(8)->Range(64, 32 * 1024);
+
+} // anonymous namespace
@@ -0,0 +1,120 @@
+#include "type-safety/packet.hpp"
+
+using namespace type_safety;
+
+// Eight lanes of each packet type against the same computation written with intrinsics - two
+// __m128 halves, asm-comparison.sh compiling for plain SSE2.
+
+namespace packet_test {
+
+void callValuePackets(const Mass* masses, const Speed* speeds, Energy* energies) {
+	const auto v = ValueN<MPS, 8>::load(speeds);
+	ValueN<Joules, 8>{ValueN<Kilograms, 8>::load(masses) * v * v * 0.5f}.store(energies);
+}
+
+void callValueIntrinsics(const float* masses, const float* speeds, float* energies) {
+#ifdef TYPE_SAFETY_SIMD_SSE2
+	for (auto half = 0; half < 8; half += 4) {
+		const auto v = _mm_loadu_ps(speeds + half);
+		const auto e = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(masses + half), v), v), _mm_set1_ps(0.5f));
+		_mm_storeu_ps(energies + half, e);
+	}
+#else
+	for (auto lane = 0; lane < 8; ++lane) {
+		energies[lane] = masses[lane] * speeds[lane] * speeds[lane] * 0.5f;
+	}
+#endif /* TYPE_SAFETY_SIMD_SSE2 */
+}
+
+void callAnglePackets(const Angle* from, const Angle* to, float t, Angle* result) {
+	const auto a = AngleN<8>::load(from);
+	(a + (AngleN<8>::load(to) - a) * t).store(result);
+}
+
+void callAngleIntrinsics(const float* from, const float* to, float t, float* result) {
+#ifdef TYPE_SAFETY_SIMD_SSE2
+	for (auto half = 0; half < 8; half += 4) {
+		const auto a = _mm_loadu_ps(from + half);
+		const auto delta = _mm_sub_ps(_mm_loadu_ps(to + half), a);
+		_mm_storeu_ps(result + half, _mm_add_ps(a, _mm_mul_ps(delta, _mm_set1_ps(t))));
+	}
+#else
+	for (auto lane = 0; lane < 8; ++lane) {
+		result[lane] = from[lane] + (to[lane] - from[lane]) * t;
+	}
+#endif /* TYPE_SAFETY_SIMD_SSE2 */
+}
+
+void callVec3Packets(
+	const Xform<space::World, space::Camera>& worldToCamera,
+	const Vec3Block<8>& positions,
+	const Vec3Block<8>& velocities,
+	Time dt,
+	Vec3Block<8>& result
+) {
+	const auto p = PointN<space::World, Metres, 8>{Vec3N<8>::load(positions)};
+	const auto v = VectorN<space::World, MPS, 8>{Vec3N<8>::load(velocities)};
+	const auto dts = ValueN<Seconds, 8>{dt};
+	applyPacket(worldToCamera, p + v * dts).xyz().store(result);
+}
+
+void callVec3Intrinsics(
+	const Matrix& worldToCamera,
+	const float* positions,
+	const float* velocities,
+	float dt,
+	float* result
+) {
+#ifdef TYPE_SAFETY_SIMD_SSE2
+	const auto dts = _mm_set1_ps(dt);
+	const auto x0 = _mm_add_ps(_mm_loadu_ps(positions), _mm_mul_ps(_mm_loadu_ps(velocities), dts));
+	const auto x1 = _mm_add_ps(_mm_loadu_ps(positions + 4), _mm_mul_ps(_mm_loadu_ps(velocities + 4), dts));
+	const auto y0 = _mm_add_ps(_mm_loadu_ps(positions + 8), _mm_mul_ps(_mm_loadu_ps(velocities + 8), dts));
+	const auto y1 = _mm_add_ps(_mm_loadu_ps(positions + 12), _mm_mul_ps(_mm_loadu_ps(velocities + 12), dts));
+	const auto z0 = _mm_add_ps(_mm_loadu_ps(positions + 16), _mm_mul_ps(_mm_loadu_ps(velocities + 16), dts));
+	const auto z1 = _mm_add_ps(_mm_loadu_ps(positions + 20), _mm_mul_ps(_mm_loadu_ps(velocities + 20), dts));
+
+	const auto m00 = _mm_set1_ps(worldToCamera.get(0, 0));
+	const auto m01 = _mm_set1_ps(worldToCamera.get(0, 1));
+	const auto m02 = _mm_set1_ps(worldToCamera.get(0, 2));
+	const auto m03 = _mm_set1_ps(worldToCamera.get(0, 3));
+	const auto m10 = _mm_set1_ps(worldToCamera.get(1, 0));
+	const auto m11 = _mm_set1_ps(worldToCamera.get(1, 1));
+	const auto m12 = _mm_set1_ps(worldToCamera.get(1, 2));
+	const auto m13 = _mm_set1_ps(worldToCamera.get(1, 3));
+	const auto m20 = _mm_set1_ps(worldToCamera.get(2, 0));
+	const auto m21 = _mm_set1_ps(worldToCamera.get(2, 1));
+	const auto m22 = _mm_set1_ps(worldToCamera.get(2, 2));
+	const auto m23 = _mm_set1_ps(worldToCamera.get(2, 3));
+
+	const auto row00 = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x0, m00), _mm_mul_ps(y0, m01)), _mm_mul_ps(z0, m02)), m03);
+	const auto row01 = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x1, m00), _mm_mul_ps(y1, m01)), _mm_mul_ps(z1, m02)), m03);
+	const auto row10 = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x0, m10), _mm_mul_ps(y0, m11)), _mm_mul_ps(z0, m12)), m13);
+	const auto row11 = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x1, m10), _mm_mul_ps(y1, m11)), _mm_mul_ps(z1, m12)), m13);
+	const auto row20 = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x0, m20), _mm_mul_ps(y0, m21)), _mm_mul_ps(z0, m22)), m23);
+	const auto row21 = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x1, m20), _mm_mul_ps(y1, m21)), _mm_mul_ps(z1, m22)), m23);
+
+	_mm_storeu_ps(result, row00);
+	_mm_storeu_ps(result + 4, row01);
+	_mm_storeu_ps(result + 8, row10);
+	_mm_storeu_ps(result + 12, row11);
+	_mm_storeu_ps(result + 16, row20);
+	_mm_storeu_ps(result + 20, row21);
+#else
+	for (auto lane = 0; lane < 8; ++lane) {
+		float moved[3];
+		for (auto coordinate = 0; coordinate < 3; ++coordinate) {
+			moved[coordinate] = positions[coordinate * 8 + lane] + velocities[coordinate * 8 + lane] * dt;
+		}
+		for (auto row = 0; row < 3; ++row) {
+			result[row * 8 + lane] =
+				moved[0] * worldToCamera.get(row, 0) +
+				moved[1] * worldToCamera.get(row, 1) +
+				moved[2] * worldToCamera.get(row, 2) +
+				worldToCamera.get(row, 3);
+		}
+	}
+#endif /* TYPE_SAFETY_SIMD_SSE2 */
+}
+
+} // namespace packet_test
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <optional>
+
+#include <benchmark/benchmark.h>
+
+#include "type-safety/PerfCounters.hpp"
+
+namespace type_safety {
+
+namespace benchmarking {
+
+// Set by --perf_counters, see benchmark/main.cpp.
+inline bool& perfCountersEnabled() {
+	static auto enabled = false;
+	return enabled;
+}
+
+// Counts hardware events from its construction to the end of the benchmark function and
+// attaches them to the benchmark as per-iteration user counters. Construct it right before
+// the timing loop. Does nothing unless perf counters were enabled, and skips the events that
+// are unavailable on this machine.
+class PerfProbe {
+public:
+
+	explicit PerfProbe(benchmark::State& state) :
+		state_(state)
+	{
+		if (perfCountersEnabled()) {
+			counters_.emplace();
+			probe_.emplace(*counters_, sample_);
+		}
+	}
+
+	PerfProbe(const PerfProbe&) = delete;
+
+	PerfProbe& operator=(const PerfProbe&) = delete;
+
+	~PerfProbe() {
+		if (!probe_) {
+			return;
+		}
+		probe_.reset();
+
+		report("cycles", sample_[PerfEvent::CYCLES]);
+		report("instructions", sample_[PerfEvent::INSTRUCTIONS]);
+		report("L1D_misses", sample_[PerfEvent::L1D_MISSES]);
+		report("LLC_misses", sample_[PerfEvent::LLC_MISSES]);
+		report("branch_misses", sample_[PerfEvent::BRANCH_MISSES]);
+		if (const auto ipc = sample_.ipc()) {
+			state_.counters["IPC"] = *ipc;
+		}
+	}
+
+private:
+
+	benchmark::State& state_;
+
+	std::optional<PerfCounters> counters_;
+
+	PerfSample sample_;
+
+	std::optional<ScopedPerfProbe> probe_;
+
+	void report(const char* name, const std::optional<double>& value) {
+		if (value) {
+			state_.counters[name] = benchmark::Counter(*value, benchmark::Counter::kAvgIterations);
+		}
+	}
+
+};
+
+} // namespace benchmarking
+
+} // namespace type_safety
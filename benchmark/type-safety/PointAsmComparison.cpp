@@ -0,0 +1,32 @@
+#include "type-safety/Point.hpp"
+#include "type-safety/Xform.hpp"
+
+using namespace type_safety;
+using namespace type_safety::unit_literals;
+
+float externalPointSink(Position<space::Camera> p);
+float externalPointVec4Sink(Vec4 p);
+
+namespace point_test {
+
+float callPoints(
+	const Xform<space::World, space::Camera>& worldToCamera,
+	Position<space::World> position,
+	Velocity<space::World> velocity,
+	Vector<space::World, Kilometres> drift,
+	Time dt
+) {
+	return externalPointSink(worldToCamera.apply(position + velocity * dt + drift));
+}
+
+float callVec4s(
+	const Matrix& worldToCamera,
+	Vec4 position,
+	Vec4 velocity,
+	Vec4 drift,
+	float dt
+) {
+	return externalPointVec4Sink(worldToCamera * (position + velocity * dt + drift * 1000.0f));
+}
+
+} // namespace point_test
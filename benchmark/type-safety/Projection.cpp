@@ -0,0 +1,143 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include "type-safety/Projection.hpp"
+#include "type-safety/PerfProbe.hpp"
+
+// Every typed benchmark has a raw-float baseline named raw<Name>, see benchmark/main.cpp.
+//
+// Camera-space vertices to pixels, in vertices per second. The step-by-step benchmarks
+// project, divide and map to the viewport one Point at a time, the fused ones run projectAll
+// over CompactPoints, and their raw baseline the same folded matrix with a plain division.
+
+namespace /* anonymous */ {
+
+using namespace type_safety;
+
+const auto FIELD_OF_VIEW = Angle{degreesTag, 60.0f};
+constexpr auto ASPECT_RATIO = 16.0f / 9.0f;
+constexpr auto NEAR_DISTANCE = 0.1f;
+constexpr auto FAR_DISTANCE = 1000.0f;
+constexpr auto WIDTH = 1920.0f;
+constexpr auto HEIGHT = 1080.0f;
+
+// Points in front of the camera
+std::vector<Vec3> randomCameraPoints(std::size_t count) {
+	std::srand(1);
+	auto result = std::vector<Vec3>{};
+	result.reserve(count);
+	for (auto i = 0u; i < count; ++i) {
+		const auto coordinate = [] { return static_cast<float>(std::rand() % 2000 - 1000) / 100.0f; };
+		result.emplace_back(coordinate(), coordinate(), -1.0f - static_cast<float>(std::rand() % 10000) / 100.0f);
+	}
+	return result;
+}
+
+void reportThroughput(benchmark::State& state) {
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void cameraToScreen(benchmark::State& state) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+	const auto projection = makePerspectiveXform(FIELD_OF_VIEW, ASPECT_RATIO, NEAR_DISTANCE, FAR_DISTANCE);
+	const auto viewport = makeViewportXform(0.0f, 0.0f, WIDTH, HEIGHT);
+	auto points = std::vector<Point<space::Camera, Metres>>{};
+	for (const auto& v : randomCameraPoints(count)) {
+		points.emplace_back(v);
+	}
+	auto results = std::vector<Point<space::Screen>>(count);
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		for (auto i = 0u; i < count; ++i) {
+			results[i] = viewport.apply(perspectiveDivide(projection.apply(points[i])));
+		}
+		benchmark::DoNotOptimize(results.data());
+		benchmark::ClobberMemory();
+	}
+
+	reportThroughput(state);
+}
+
+void rawCameraToScreen(benchmark::State& state) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+	const auto projection = makePerspectiveXform(FIELD_OF_VIEW, ASPECT_RATIO, NEAR_DISTANCE, FAR_DISTANCE).matrix();
+	const auto viewport = makeViewportXform(0.0f, 0.0f, WIDTH, HEIGHT).matrix();
+	auto points = std::vector<Vec4>{};
+	for (const auto& v : randomCameraPoints(count)) {
+		points.emplace_back(v, 1.0f);
+	}
+	auto results = std::vector<Vec4>(count);
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		for (auto i = 0u; i < count; ++i) {
+			const auto clip = projection * points[i];
+			const auto inverseW = 1.0f / clip.get(3);
+			const auto ndc = Vec4{clip.get(0) * inverseW, clip.get(1) * inverseW, clip.get(2) * inverseW, 1.0f};
+			multiplyAffineAndSet(results[i], viewport, ndc);
+		}
+		benchmark::DoNotOptimize(results.data());
+		benchmark::ClobberMemory();
+	}
+
+	reportThroughput(state);
+}
+
+void fusedCameraToScreen(benchmark::State& state) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+	const auto projection = makePerspectiveXform(FIELD_OF_VIEW, ASPECT_RATIO, NEAR_DISTANCE, FAR_DISTANCE);
+	const auto viewport = makeViewportXform(0.0f, 0.0f, WIDTH, HEIGHT);
+	auto points = std::vector<CompactPoint<space::Camera, Metres>>{};
+	for (const auto& v : randomCameraPoints(count)) {
+		points.emplace_back(v);
+	}
+	auto results = std::vector<CompactPoint<space::Screen>>(count);
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		projectAll(projection, viewport, points.data(), count, results.data());
+		benchmark::DoNotOptimize(results.data());
+		benchmark::ClobberMemory();
+	}
+
+	reportThroughput(state);
+}
+
+void rawFusedCameraToScreen(benchmark::State& state) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+	const auto matrix =
+		makeViewportXform(0.0f, 0.0f, WIDTH, HEIGHT).matrix() *
+		makePerspectiveXform(FIELD_OF_VIEW, ASPECT_RATIO, NEAR_DISTANCE, FAR_DISTANCE).matrix();
+	auto points = std::vector<float>{};
+	for (const auto& v : randomCameraPoints(count)) {
+		points.insert(points.end(), { v.get(0), v.get(1), v.get(2) });
+	}
+	auto results = std::vector<float>(3 * count);
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		for (auto i = 0u; i < count; ++i) {
+			const auto* p = points.data() + 3 * i;
+			const auto w = matrix.get(3, 0) * p[0] + matrix.get(3, 1) * p[1] + matrix.get(3, 2) * p[2] + matrix.get(3, 3);
+			for (auto row = 0u; row < 3u; ++row) {
+				results[3 * i + row] =
+					(matrix.get(row, 0) * p[0] + matrix.get(row, 1) * p[1] + matrix.get(row, 2) * p[2] + matrix.get(row, 3)) / w;
+			}
+		}
+		benchmark::DoNotOptimize(results.data());
+		benchmark::ClobberMemory();
+	}
+
+	reportThroughput(state);
+}
+
+BENCHMARK(cameraToScreen)->RangeMultiplier(32)->Range(1024, 1024 * 1024);
+BENCHMARK(rawCameraToScreen)->RangeMultiplier(32)->Range(1024, 1024 * 1024);
+BENCHMARK(fusedCameraToScreen)->RangeMultiplier(32)->Range(1024, 1024 * 1024);
+BENCHMARK(rawFusedCameraToScreen)->RangeMultiplier(32)->Range(1024, 1024 * 1024);
+
+} // anonymous namespace
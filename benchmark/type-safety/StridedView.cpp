@@ -0,0 +1,97 @@
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "type-safety/StridedView.hpp"
+#include "type-safety/PerfProbe.hpp"
+
+// Every typed benchmark has a raw-float baseline named raw<Name>, see benchmark/main.cpp.
+//
+// Positions are rotated in place inside interleaved vertices of state.range(0) bytes: 12 for
+// positions only, 24 with normals, 32 with normals and uvs, 48 and 64 for fatter vertices. The
+// bytes processed are the position bytes read and written.
+
+namespace /* anonymous */ {
+
+using namespace type_safety;
+
+constexpr auto VERTEX_COUNT = std::size_t{64 * 1024};
+
+// A rotation, which keeps the positions bounded however many times it is applied
+Matrix rotation() {
+	auto matrix = Matrix{};
+	for (auto row = 0u; row < 4u; ++row) {
+		for (auto column = 0u; column < 4u; ++column) {
+			matrix.get(row, column) = row == column ? 1.0f : 0.0f;
+		}
+	}
+	matrix.get(0, 0) = std::cos(0.1f);
+	matrix.get(0, 1) = -std::sin(0.1f);
+	matrix.get(1, 0) = std::sin(0.1f);
+	matrix.get(1, 1) = std::cos(0.1f);
+	return matrix;
+}
+
+std::vector<std::byte> makeVertices(std::size_t stride) {
+	auto vertices = std::vector<std::byte>(VERTEX_COUNT * stride);
+	for (auto i = 0u; i < VERTEX_COUNT; ++i) {
+		const float position[3] = { static_cast<float>(i % 100), 1.0f, 2.0f };
+		std::memcpy(vertices.data() + i * stride, position, sizeof(position));
+	}
+	return vertices;
+}
+
+std::size_t stride(const benchmark::State& state) {
+	return static_cast<std::size_t>(state.range(0));
+}
+
+void reportBytes(benchmark::State& state) {
+	state.SetItemsProcessed(state.iterations() * VERTEX_COUNT);
+	state.SetBytesProcessed(state.iterations() * VERTEX_COUNT * static_cast<std::int64_t>(2 * 3 * sizeof(float)));
+}
+
+void stridedPointTransform(benchmark::State& state) {
+	auto vertices = makeVertices(stride(state));
+	const auto positions = StridedPointView<space::Player, Metres>{vertices.data(), VERTEX_COUNT, stride(state), 0};
+	const auto xform = Xform<space::Player, space::Player>{rotation()};
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		applyInPlace(xform, positions);
+		benchmark::DoNotOptimize(vertices.data());
+		benchmark::ClobberMemory();
+	}
+
+	reportBytes(state);
+}
+
+void rawStridedPointTransform(benchmark::State& state) {
+	auto vertices = makeVertices(stride(state));
+	const auto matrix = rotation();
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		for (auto i = 0u; i < VERTEX_COUNT; ++i) {
+			auto* position = vertices.data() + i * stride(state);
+			float coordinates[3];
+			std::memcpy(coordinates, position, sizeof(coordinates));
+			const auto result = matrix * Vec4{coordinates[0], coordinates[1], coordinates[2], 1.0f};
+			for (auto axis = 0u; axis < 3u; ++axis) {
+				coordinates[axis] = result.get(axis);
+			}
+			std::memcpy(position, coordinates, sizeof(coordinates));
+		}
+		benchmark::DoNotOptimize(vertices.data());
+		benchmark::ClobberMemory();
+	}
+
+	reportBytes(state);
+}
+
+BENCHMARK(stridedPointTransform)->Arg(12)->Arg(24)->Arg(32)->Arg(48)->Arg(64);
+BENCHMARK(rawStridedPointTransform)->Arg(12)->Arg(24)->Arg(32)->Arg(48)->Arg(64);
+
+} // anonymous namespace
@@ -0,0 +1,243 @@
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "type-safety/StructuredXform.hpp"
+#include "type-safety/PerfProbe.hpp"
+
+// Every typed benchmark has a raw baseline named raw<Name>, see benchmark/main.cpp.
+//
+// A scene of objects, each with a local-to-world xform and a handful of points, the xforms
+// being a realistic mix: 20% identities, 40% translations, 30% rotations with translation and
+// 10% general affine xforms. The structured benchmarks classify every xform once per frame and
+// apply the matching kernel to the object's points, the unstructured ones apply the full 4x4
+// matrix to all of them.
+
+namespace /* anonymous */ {
+
+using namespace type_safety;
+
+constexpr auto OBJECT_COUNT = std::size_t{4096};
+constexpr auto POINTS_PER_OBJECT = std::size_t{16};
+
+Matrix objectMatrix(std::size_t object) {
+	auto matrix = Matrix::identity();
+	const auto kind = object % 10u;
+	const auto f = static_cast<float>(object % 100u) * 0.01f;
+	if (kind >= 2u) {
+		matrix.get(0, 3) = f;
+		matrix.get(1, 3) = 1.0f - f;
+		matrix.get(2, 3) = 2.0f * f;
+	}
+	if (kind >= 6u) {
+		matrix.get(0, 0) = std::cos(f);
+		matrix.get(0, 1) = -std::sin(f);
+		matrix.get(1, 0) = std::sin(f);
+		matrix.get(1, 1) = std::cos(f);
+	}
+	if (kind == 9u) {
+		matrix.get(0, 2) = 0.5f;
+	}
+	return matrix;
+}
+
+std::vector<Xform<space::Player, space::World>> objectXforms() {
+	auto result = std::vector<Xform<space::Player, space::World>>{};
+	result.reserve(OBJECT_COUNT);
+	for (auto object = 0u; object < OBJECT_COUNT; ++object) {
+		result.emplace_back(objectMatrix(object));
+	}
+	return result;
+}
+
+std::vector<Vec3> objectPoints() {
+	auto result = std::vector<Vec3>{};
+	result.reserve(OBJECT_COUNT * POINTS_PER_OBJECT);
+	for (auto i = 0u; i < OBJECT_COUNT * POINTS_PER_OBJECT; ++i) {
+		const auto f = static_cast<float>(i % 1000u) * 0.01f;
+		result.emplace_back(f, -f, 0.5f * f);
+	}
+	return result;
+}
+
+void reportThroughput(benchmark::State& state) {
+	state.SetItemsProcessed(state.iterations() * OBJECT_COUNT * POINTS_PER_OBJECT);
+}
+
+void structuredXformMix(benchmark::State& state) {
+	const auto xforms = objectXforms();
+	auto points = std::vector<Point<space::Player, Metres>>{};
+	for (const auto& v : objectPoints()) {
+		points.emplace_back(v);
+	}
+	auto results = std::vector<Point<space::World, Metres>>(points.size());
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		for (auto object = 0u; object < OBJECT_COUNT; ++object) {
+			withXformStructure(xforms[object], [&](const auto& xform) {
+					for (auto i = object * POINTS_PER_OBJECT; i < (object + 1) * POINTS_PER_OBJECT; ++i) {
+						results[i] = xform.apply(points[i]);
+					}
+				});
+		}
+		benchmark::DoNotOptimize(results.data());
+		benchmark::ClobberMemory();
+	}
+
+	reportThroughput(state);
+}
+
+void rawStructuredXformMix(benchmark::State& state) {
+	auto matrices = std::vector<Matrix>{};
+	for (auto object = 0u; object < OBJECT_COUNT; ++object) {
+		matrices.push_back(objectMatrix(object));
+	}
+	auto points = std::vector<Vec4>{};
+	for (const auto& v : objectPoints()) {
+		points.emplace_back(v, 1.0f);
+	}
+	auto results = std::vector<Vec4>(points.size());
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		for (auto object = 0u; object < OBJECT_COUNT; ++object) {
+			const auto& matrix = matrices[object];
+			const auto begin = object * POINTS_PER_OBJECT;
+			const auto end = begin + POINTS_PER_OBJECT;
+			switch (classify(matrix)) {
+			case XformStructure::IDENTITY:
+				for (auto i = begin; i < end; ++i) {
+					results[i] = points[i];
+				}
+				break;
+			case XformStructure::TRANSLATION:
+				for (auto i = begin; i < end; ++i) {
+					multiplyTranslationAndSet(results[i], matrix, points[i]);
+				}
+				break;
+			case XformStructure::RIGID:
+			case XformStructure::SIMILARITY:
+			case XformStructure::AFFINE:
+				for (auto i = begin; i < end; ++i) {
+					multiplyAffineAndSet(results[i], matrix, points[i]);
+				}
+				break;
+			case XformStructure::PROJECTIVE:
+				for (auto i = begin; i < end; ++i) {
+					multiplyAndSet(results[i], matrix, points[i]);
+				}
+				break;
+			}
+		}
+		benchmark::DoNotOptimize(results.data());
+		benchmark::ClobberMemory();
+	}
+
+	reportThroughput(state);
+}
+
+void unstructuredXformMix(benchmark::State& state) {
+	const auto xforms = objectXforms();
+	auto points = std::vector<Point<space::Player, Metres>>{};
+	for (const auto& v : objectPoints()) {
+		points.emplace_back(v);
+	}
+	auto results = std::vector<Point<space::World, Metres>>(points.size());
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		for (auto object = 0u; object < OBJECT_COUNT; ++object) {
+			for (auto i = object * POINTS_PER_OBJECT; i < (object + 1) * POINTS_PER_OBJECT; ++i) {
+				results[i] = xforms[object].apply(points[i]);
+			}
+		}
+		benchmark::DoNotOptimize(results.data());
+		benchmark::ClobberMemory();
+	}
+
+	reportThroughput(state);
+}
+
+void rawUnstructuredXformMix(benchmark::State& state) {
+	auto matrices = std::vector<Matrix>{};
+	for (auto object = 0u; object < OBJECT_COUNT; ++object) {
+		matrices.push_back(objectMatrix(object));
+	}
+	auto points = std::vector<Vec4>{};
+	for (const auto& v : objectPoints()) {
+		points.emplace_back(v, 1.0f);
+	}
+	auto results = std::vector<Vec4>(points.size());
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		for (auto object = 0u; object < OBJECT_COUNT; ++object) {
+			for (auto i = object * POINTS_PER_OBJECT; i < (object + 1) * POINTS_PER_OBJECT; ++i) {
+				results[i] = matrices[object] * points[i];
+			}
+		}
+		benchmark::DoNotOptimize(results.data());
+		benchmark::ClobberMemory();
+	}
+
+	reportThroughput(state);
+}
+
+// Object-to-camera xforms from translations and a rigid world-to-camera xform
+void structuredXformConcatenation(benchmark::State& state) {
+	auto translations = std::vector<TranslationXform<space::Player, space::World>>{};
+	for (auto object = 0u; object < OBJECT_COUNT; ++object) {
+		translations.push_back(makeTranslationXform<space::Player, space::World>(Vec3{static_cast<float>(object), 1.0f, 2.0f}));
+	}
+	const auto worldToCamera = RigidXform<space::World, space::Camera>{objectMatrix(6)};
+	auto results = std::vector<Matrix>(OBJECT_COUNT);
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		for (auto object = 0u; object < OBJECT_COUNT; ++object) {
+			results[object] = inSequence(translations[object], worldToCamera).matrix();
+		}
+		benchmark::DoNotOptimize(results.data());
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * OBJECT_COUNT);
+}
+
+void rawStructuredXformConcatenation(benchmark::State& state) {
+	auto translations = std::vector<Matrix>{};
+	for (auto object = 0u; object < OBJECT_COUNT; ++object) {
+		auto matrix = Matrix::identity();
+		matrix.get(0, 3) = static_cast<float>(object);
+		matrix.get(1, 3) = 1.0f;
+		matrix.get(2, 3) = 2.0f;
+		translations.push_back(matrix);
+	}
+	const auto worldToCamera = objectMatrix(6);
+	auto results = std::vector<Matrix>(OBJECT_COUNT);
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		for (auto object = 0u; object < OBJECT_COUNT; ++object) {
+			auto result = Matrix{};
+			multiplyAffineAndSet(result, worldToCamera, translations[object]);
+			results[object] = result;
+		}
+		benchmark::DoNotOptimize(results.data());
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * OBJECT_COUNT);
+}
+
+BENCHMARK(structuredXformMix);
+BENCHMARK(rawStructuredXformMix);
+BENCHMARK(unstructuredXformMix);
+BENCHMARK(rawUnstructuredXformMix);
+BENCHMARK(structuredXformConcatenation);
+BENCHMARK(rawStructuredXformConcatenation);
+
+} // anonymous namespace
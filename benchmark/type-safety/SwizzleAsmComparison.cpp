@@ -0,0 +1,55 @@
+#include "type-safety/SwizzleXform.hpp"
+
+using namespace type_safety;
+
+// Convention changes against the same moves written with intrinsics. asm-comparison.sh also
+// checks that the typed functions contain no multiplications.
+
+namespace swizzle_test {
+
+void callSwizzles(const Position<space::ZUpLeftHanded>& position, Position<space::YUpRightHanded>& result) {
+	result = ConventionXform<space::ZUpLeftHanded, space::YUpRightHanded>{}.apply(position);
+}
+
+// (y, z, -x, w)
+void callShuffles(const float* position, float* result) {
+#ifdef TYPE_SAFETY_SIMD_SSE2
+	const auto v = _mm_loadu_ps(position);
+	const auto shuffled = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 0, 2, 1));
+	_mm_storeu_ps(result, _mm_xor_ps(shuffled, _mm_setr_ps(0.0f, 0.0f, -0.0f, 0.0f)));
+#else
+	const float shuffled[] = { position[1], position[2], -position[0], position[3] };
+	for (auto i = 0; i < 4; ++i) {
+		result[i] = shuffled[i];
+	}
+#endif /* TYPE_SAFETY_SIMD_SSE2 */
+}
+
+void callSwizzledXforms(
+	const Xform<space::YUpRightHanded, space::World>& toWorld,
+	Xform<space::ZUpLeftHanded, space::World>& result
+) {
+	result = inSequence(ConventionXform<space::ZUpLeftHanded, space::YUpRightHanded>{}, toWorld);
+}
+
+// Columns (-z, x, y, w) of toWorld
+void callPermutedMatrices(const Matrix& toWorld, Matrix& result) {
+	result.get(0, 0) = -toWorld.get(0, 2);
+	result.get(0, 1) = toWorld.get(0, 0);
+	result.get(0, 2) = toWorld.get(0, 1);
+	result.get(0, 3) = toWorld.get(0, 3);
+	result.get(1, 0) = -toWorld.get(1, 2);
+	result.get(1, 1) = toWorld.get(1, 0);
+	result.get(1, 2) = toWorld.get(1, 1);
+	result.get(1, 3) = toWorld.get(1, 3);
+	result.get(2, 0) = -toWorld.get(2, 2);
+	result.get(2, 1) = toWorld.get(2, 0);
+	result.get(2, 2) = toWorld.get(2, 1);
+	result.get(2, 3) = toWorld.get(2, 3);
+	result.get(3, 0) = -toWorld.get(3, 2);
+	result.get(3, 1) = toWorld.get(3, 0);
+	result.get(3, 2) = toWorld.get(3, 1);
+	result.get(3, 3) = toWorld.get(3, 3);
+}
+
+} // namespace swizzle_test
@@ -0,0 +1,217 @@
+#define TYPE_SAFETY_PROFILING
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "type-safety/TransformTable.hpp"
+#include "type-safety/profiling.hpp"
+#include "type-safety/PerfProbe.hpp"
+
+// Every typed benchmark has a raw-float baseline named raw<Name>, see benchmark/main.cpp.
+//
+// The benchmarked thread reads (or writes) while background threads keep one writer (or
+// state.range(0) readers) busy on the same table. One read in LATENCY_SAMPLING is timed for
+// the tail latency counters.
+
+namespace /* anonymous */ {
+
+using namespace type_safety;
+
+using PlayerToWorld = Xform<space::Player, space::World>;
+
+constexpr auto ENTRIES = std::size_t{256};
+constexpr auto LATENCY_SAMPLING = 64;
+
+PlayerToWorld identityXform() {
+	auto xform = PlayerToWorld{};
+	for (auto row = 0u; row < 4u; ++row) {
+		for (auto column = 0u; column < 4u; ++column) {
+			xform.matrix().get(row, column) = row == column ? 1.0f : 0.0f;
+		}
+	}
+	return xform;
+}
+
+// The mutex-protected table the seqlocks replace
+class LockedTable {
+public:
+
+	explicit LockedTable(const Matrix& initial) :
+		matrices_(ENTRIES, initial)
+	{
+	}
+
+	Matrix read(std::size_t index) const {
+		const auto lock = std::lock_guard<std::mutex>{mutex_};
+		return matrices_[index];
+	}
+
+	void write(std::size_t index, const Matrix& matrix) {
+		const auto lock = std::lock_guard<std::mutex>{mutex_};
+		matrices_[index] = matrix;
+	}
+
+private:
+
+	mutable std::mutex mutex_;
+
+	std::vector<Matrix> matrices_;
+
+};
+
+class BackgroundThreads {
+public:
+
+	template <class FunctionT>
+	BackgroundThreads(int count, FunctionT function) {
+		for (auto thread = 0; thread < count; ++thread) {
+			threads_.emplace_back([this, function, thread]() {
+				auto iteration = static_cast<std::size_t>(thread);
+				while (!done_.load(std::memory_order_relaxed)) {
+					function(iteration++);
+				}
+			});
+		}
+	}
+
+	~BackgroundThreads() {
+		done_ = true;
+		for (auto& thread : threads_) {
+			thread.join();
+		}
+	}
+
+private:
+
+	std::atomic<bool> done_ = {false};
+
+	std::vector<std::thread> threads_;
+
+};
+
+void reportLatencies(benchmark::State& state, const LatencyHistogram& latencies) {
+	const auto snapshot = latencies.snapshot();
+	state.counters["p50_ns"] = snapshot.percentile(0.5f).value<Nanoseconds>();
+	state.counters["p99_ns"] = snapshot.percentile(0.99f).value<Nanoseconds>();
+	state.counters["p999_ns"] = snapshot.percentile(0.999f).value<Nanoseconds>();
+	state.SetItemsProcessed(state.iterations());
+}
+
+template <class ReadT>
+void timedReads(benchmark::State& state, ReadT read) {
+	auto latencies = LatencyHistogram{};
+	auto index = std::size_t{0};
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		if (index % LATENCY_SAMPLING == 0) {
+			const auto timer = ScopedTimer{latencies};
+			benchmark::DoNotOptimize(read(index++ % ENTRIES));
+		} else {
+			benchmark::DoNotOptimize(read(index++ % ENTRIES));
+		}
+	}
+	reportLatencies(state, latencies);
+}
+
+template <class WriteT>
+void timedWrites(benchmark::State& state, WriteT write) {
+	auto latencies = LatencyHistogram{};
+	auto index = std::size_t{0};
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		if (index % LATENCY_SAMPLING == 0) {
+			const auto timer = ScopedTimer{latencies};
+			write(index++ % ENTRIES);
+		} else {
+			write(index++ % ENTRIES);
+		}
+		benchmark::ClobberMemory();
+	}
+	reportLatencies(state, latencies);
+}
+
+void transformTableRead(benchmark::State& state) {
+	const auto xform = identityXform();
+	auto table = TransformTable<space::Player, space::World>{ENTRIES, xform};
+	const auto writer = BackgroundThreads{1, [&](std::size_t i) { table.write(i % ENTRIES, xform); }};
+	const auto readers = BackgroundThreads{static_cast<int>(state.range(0)) - 1,
+		[&](std::size_t i) { benchmark::DoNotOptimize(table.read(i % ENTRIES)); }};
+
+	timedReads(state, [&](std::size_t index) { return table.read(index); });
+}
+
+void rawTransformTableRead(benchmark::State& state) {
+	const auto xform = identityXform();
+	auto table = LockedTable{xform.matrix()};
+	const auto writer = BackgroundThreads{1, [&](std::size_t i) { table.write(i % ENTRIES, xform.matrix()); }};
+	const auto readers = BackgroundThreads{static_cast<int>(state.range(0)) - 1,
+		[&](std::size_t i) { benchmark::DoNotOptimize(table.read(i % ENTRIES)); }};
+
+	timedReads(state, [&](std::size_t index) { return table.read(index); });
+}
+
+void transformTableWrite(benchmark::State& state) {
+	const auto xform = identityXform();
+	auto table = TransformTable<space::Player, space::World>{ENTRIES, xform};
+	const auto readers = BackgroundThreads{static_cast<int>(state.range(0)),
+		[&](std::size_t i) { benchmark::DoNotOptimize(table.read(i % ENTRIES)); }};
+
+	timedWrites(state, [&](std::size_t index) { table.write(index, xform); });
+}
+
+void rawTransformTableWrite(benchmark::State& state) {
+	const auto xform = identityXform();
+	auto table = LockedTable{xform.matrix()};
+	const auto readers = BackgroundThreads{static_cast<int>(state.range(0)),
+		[&](std::size_t i) { benchmark::DoNotOptimize(table.read(i % ENTRIES)); }};
+
+	timedWrites(state, [&](std::size_t index) { table.write(index, xform.matrix()); });
+}
+
+void transformTableBulkUpdate(benchmark::State& state) {
+	const auto xform = identityXform();
+	auto table = TransformTable<space::Player, space::World>{ENTRIES, xform};
+	const auto readers = BackgroundThreads{static_cast<int>(state.range(0)),
+		[&](std::size_t i) { benchmark::DoNotOptimize(table.read(i % ENTRIES)); }};
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		auto update = table.beginBulkUpdate();
+		for (auto index = std::size_t{0}; index < ENTRIES; ++index) {
+			update.write(index, xform);
+		}
+		update.publish();
+	}
+	state.SetItemsProcessed(state.iterations() * ENTRIES);
+}
+
+void rawTransformTableBulkUpdate(benchmark::State& state) {
+	const auto xform = identityXform();
+	auto table = LockedTable{xform.matrix()};
+	const auto readers = BackgroundThreads{static_cast<int>(state.range(0)),
+		[&](std::size_t i) { benchmark::DoNotOptimize(table.read(i % ENTRIES)); }};
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		for (auto index = std::size_t{0}; index < ENTRIES; ++index) {
+			table.write(index, xform.matrix());
+		}
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * ENTRIES);
+}
+
+constexpr auto MAX_READERS = 8;
+
+BENCHMARK(transformTableRead)->RangeMultiplier(2)->Range(1, MAX_READERS)->UseRealTime();
+BENCHMARK(rawTransformTableRead)->RangeMultiplier(2)->Range(1, MAX_READERS)->UseRealTime();
+BENCHMARK(transformTableWrite)->RangeMultiplier(2)->Range(1, MAX_READERS)->UseRealTime();
+BENCHMARK(rawTransformTableWrite)->RangeMultiplier(2)->Range(1, MAX_READERS)->UseRealTime();
+BENCHMARK(transformTableBulkUpdate)->RangeMultiplier(2)->Range(1, MAX_READERS)->UseRealTime();
+BENCHMARK(rawTransformTableBulkUpdate)->RangeMultiplier(2)->Range(1, MAX_READERS)->UseRealTime();
+
+} // anonymous namespace
@@ -1,71 +1,237 @@
 #include <benchmark/benchmark.h>
 
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
 #include "type-safety/Unit.hpp"
+#include "type-safety/PerfProbe.hpp"
+
+// Every typed benchmark has a raw-float baseline named raw<Name>, see benchmark/main.cpp.
 
 namespace /* anonymous */ {
 
 using namespace type_safety;
 using namespace type_safety::unit_literals;
 
-void unitDefaultConstruction(benchmark::State& state) {
+std::vector<float> randomFloats(std::size_t count, unsigned int seed) {
+	std::srand(seed);
+	auto result = std::vector<float>{};
+	result.reserve(count);
+	for (auto i = 0u; i < count; ++i) {
+		result.push_back(static_cast<float>(std::rand()) / static_cast<float>(RAND_MAX) * 100.0f);
+	}
+	return result;
+}
+
+template <class UnitT>
+std::vector<Value<UnitT>> randomValues(std::size_t count, unsigned int seed) {
+	auto result = std::vector<Value<UnitT>>{};
+	result.reserve(count);
+	for (const auto value : randomFloats(count, seed)) {
+		result.push_back(makeValue<UnitT>(value));
+	}
+	return result;
+}
+
+// Reports throughput of an elementwise operation reading inputs and writing one output of
+// ElementT per item.
+template <class ElementT>
+void reportThroughput(benchmark::State& state, int inputs) {
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+	state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<std::int64_t>((inputs + 1) * sizeof(ElementT)));
+}
+
+void valueAddition(benchmark::State& state) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+	const auto lhs = randomValues<Kilograms>(count, 0);
+	const auto rhs = randomValues<Kilograms>(count, 1);
+	auto results = std::vector<Mass>(count);
+
+	const auto probe = benchmarking::PerfProbe{state};
 	for (auto _ : state) {
-		auto m = Mass{};
-		benchmark::DoNotOptimize(m.value<Kilograms>() == 0.0f);
+		for (auto i = 0u; i < count; ++i) {
+			results[i] = lhs[i] + rhs[i];
+		}
+		benchmark::DoNotOptimize(results.data());
+		benchmark::ClobberMemory();
 	}
+
+	reportThroughput<Mass>(state, 2);
 }
 
-void floatDefaultConstruction(benchmark::State& state) {
+void rawValueAddition(benchmark::State& state) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+	const auto lhs = randomFloats(count, 0);
+	const auto rhs = randomFloats(count, 1);
+	auto results = std::vector<float>(count);
+
+	const auto probe = benchmarking::PerfProbe{state};
 	for (auto _ : state) {
-		auto m = float();
-		benchmark::DoNotOptimize(m == 0.0f);
+		for (auto i = 0u; i < count; ++i) {
+			results[i] = lhs[i] + rhs[i];
+		}
+		benchmark::DoNotOptimize(results.data());
+		benchmark::ClobberMemory();
 	}
+
+	reportThroughput<float>(state, 2);
 }
 
-void unitValueConstruction(benchmark::State& state) {
+void mixedUnitAddition(benchmark::State& state) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+	const auto lhs = randomValues<Kilograms>(count, 0);
+	const auto rhs = randomValues<Grams>(count, 1);
+	auto results = std::vector<Mass>(count);
+
+	const auto probe = benchmarking::PerfProbe{state};
 	for (auto _ : state) {
-		auto m = Mass{ Kilograms{}, 42.0f };
-		benchmark::DoNotOptimize(m.value<Kilograms>() != 0.0f);
+		for (auto i = 0u; i < count; ++i) {
+			results[i] = lhs[i] + rhs[i];
+		}
+		benchmark::DoNotOptimize(results.data());
+		benchmark::ClobberMemory();
 	}
+
+	reportThroughput<Mass>(state, 2);
 }
 
-void floatValueConstruction(benchmark::State& state) {
+void rawMixedUnitAddition(benchmark::State& state) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+	const auto kilograms = randomFloats(count, 0);
+	const auto grams = randomFloats(count, 1);
+	auto results = std::vector<float>(count);
+
+	const auto probe = benchmarking::PerfProbe{state};
 	for (auto _ : state) {
-		auto m = 42.0f;
-		benchmark::DoNotOptimize(m != 0.0f);
+		for (auto i = 0u; i < count; ++i) {
+			results[i] = kilograms[i] + grams[i] * 0.001f;
+		}
+		benchmark::DoNotOptimize(results.data());
+		benchmark::ClobberMemory();
 	}
+
+	reportThroughput<float>(state, 2);
 }
 
-void unitLiteralConstruction(benchmark::State& state) {
+void valueConversion(benchmark::State& state) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+	const auto speeds = randomValues<KPH>(count, 0);
+	auto results = std::vector<float>(count);
+
+	const auto probe = benchmarking::PerfProbe{state};
 	for (auto _ : state) {
-		auto m = 42.0_kg;
-		benchmark::DoNotOptimize(m.value<Kilograms>() != 0.0f);
+		for (auto i = 0u; i < count; ++i) {
+			results[i] = speeds[i].value<MPS>();
+		}
+		benchmark::DoNotOptimize(results.data());
+		benchmark::ClobberMemory();
 	}
+
+	reportThroughput<float>(state, 1);
 }
 
-void unitArithmetics(benchmark::State& state) {
-	auto m = 42_kg;
-	auto i = 0.1_kg;
+void rawValueConversion(benchmark::State& state) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+	const auto speeds = randomFloats(count, 0);
+	auto results = std::vector<float>(count);
+
+	const auto probe = benchmarking::PerfProbe{state};
 	for (auto _ : state) {
-		benchmark::DoNotOptimize(m += i);
+		for (auto i = 0u; i < count; ++i) {
+			results[i] = speeds[i] * (1000.0f / 3600.0f);
+		}
+		benchmark::DoNotOptimize(results.data());
 		benchmark::ClobberMemory();
 	}
+
+	reportThroughput<float>(state, 1);
 }
 
-void floatArithmetics(benchmark::State& state) {
-	auto m = 42.0f;
-	auto i = 0.1f;
+void valueMultiplication(benchmark::State& state) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+	const auto masses = randomValues<Kilograms>(count, 0);
+	const auto accelerations = randomValues<MPS2>(count, 1);
+	auto results = std::vector<Force>(count);
+
+	const auto probe = benchmarking::PerfProbe{state};
 	for (auto _ : state) {
-		benchmark::DoNotOptimize(m += i);
+		for (auto i = 0u; i < count; ++i) {
+			results[i] = masses[i] * accelerations[i];
+		}
+		benchmark::DoNotOptimize(results.data());
 		benchmark::ClobberMemory();
 	}
+
+	reportThroughput<Force>(state, 2);
 }
 
-//BENCHMARK(unitDefaultConstruction);
-//BENCHMARK(floatDefaultConstruction);
-//BENCHMARK(unitValueConstruction);
-//BENCHMARK(floatValueConstruction);
-//BENCHMARK(unitLiteralConstruction);
-//BENCHMARK(unitArithmetics);
-//BENCHMARK(floatArithmetics);
+void rawValueMultiplication(benchmark::State& state) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+	const auto masses = randomFloats(count, 0);
+	const auto accelerations = randomFloats(count, 1);
+	auto results = std::vector<float>(count);
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		for (auto i = 0u; i < count; ++i) {
+			results[i] = masses[i] * accelerations[i];
+		}
+		benchmark::DoNotOptimize(results.data());
+		benchmark::ClobberMemory();
+	}
+
+	reportThroughput<float>(state, 2);
+}
+
+void valueIntegration(benchmark::State& state) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+	auto distances = randomValues<Metres>(count, 0);
+	const auto speeds = randomValues<MPS>(count, 1);
+	const auto dt = 16.0_ms;
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		for (auto i = 0u; i < count; ++i) {
+			distances[i] += speeds[i] * Time{dt};
+		}
+		benchmark::DoNotOptimize(distances.data());
+		benchmark::ClobberMemory();
+	}
+
+	reportThroughput<Distance>(state, 2);
+}
+
+void rawValueIntegration(benchmark::State& state) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+	auto distances = randomFloats(count, 0);
+	const auto speeds = randomFloats(count, 1);
+	const auto dt = 0.016f;
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		for (auto i = 0u; i < count; ++i) {
+			distances[i] += speeds[i] * dt;
+		}
+		benchmark::DoNotOptimize(distances.data());
+		benchmark::ClobberMemory();
+	}
+
+	reportThroughput<float>(state, 2);
+}
+
+constexpr auto MIN_BATCH = 1 << 10;
+constexpr auto MAX_BATCH = 1 << 20;
+
+BENCHMARK(valueAddition)->RangeMultiplier(32)->Range(MIN_BATCH, MAX_BATCH);
+BENCHMARK(rawValueAddition)->RangeMultiplier(32)->Range(MIN_BATCH, MAX_BATCH);
+BENCHMARK(mixedUnitAddition)->RangeMultiplier(32)->Range(MIN_BATCH, MAX_BATCH);
+BENCHMARK(rawMixedUnitAddition)->RangeMultiplier(32)->Range(MIN_BATCH, MAX_BATCH);
+BENCHMARK(valueConversion)->RangeMultiplier(32)->Range(MIN_BATCH, MAX_BATCH);
+BENCHMARK(rawValueConversion)->RangeMultiplier(32)->Range(MIN_BATCH, MAX_BATCH);
+BENCHMARK(valueMultiplication)->RangeMultiplier(32)->Range(MIN_BATCH, MAX_BATCH);
+BENCHMARK(rawValueMultiplication)->RangeMultiplier(32)->Range(MIN_BATCH, MAX_BATCH);
+BENCHMARK(valueIntegration)->RangeMultiplier(32)->Range(MIN_BATCH, MAX_BATCH);
+BENCHMARK(rawValueIntegration)->RangeMultiplier(32)->Range(MIN_BATCH, MAX_BATCH);
 
 } // anonymous namespace
@@ -3,9 +3,6 @@
 using namespace type_safety;
 using namespace type_safety::unit_literals;
 
-using Joulles = decltype(Kilograms{} * Metres{} * Metres{} / (Seconds{} * Seconds{}));
-using Energy = Value<Joulles>;
-
 float externalUnitSink(Energy e);
 float externalUnitFloatSink(float f);
 
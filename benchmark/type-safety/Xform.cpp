@@ -1,103 +1,224 @@
 #include <benchmark/benchmark.h>
 
-#include <ctime>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
 
 #include "type-safety/Xform.hpp"
 #include "type-safety/VecN.hpp"
+#include "type-safety/PerfProbe.hpp"
+
+// Every typed benchmark has a raw baseline named raw<Name>, see benchmark/main.cpp.
 
 namespace /* anonymous */ {
 
 using namespace type_safety;
 
-Matrix randomMatrix() {
-	std::srand(0);
-	auto result = Matrix{};
-	for (auto row = 0u; row < 3u; ++row) {
-		for (auto col = 0u; col < 4u; ++col) {
-			result.get(row, col) = static_cast<float>(std::rand());
+float randomFloat() {
+	return static_cast<float>(std::rand()) / static_cast<float>(RAND_MAX) * 2.0f - 1.0f;
+}
+
+std::vector<Matrix> randomMatrices(std::size_t count, unsigned int seed) {
+	std::srand(seed);
+	auto result = std::vector<Matrix>(count);
+	for (auto& matrix : result) {
+		for (auto row = 0u; row < 3u; ++row) {
+			for (auto col = 0u; col < 4u; ++col) {
+				matrix.get(row, col) = randomFloat();
+			}
 		}
+		matrix.get(3, 0) = 0.0f;
+		matrix.get(3, 1) = 0.0f;
+		matrix.get(3, 2) = 0.0f;
+		matrix.get(3, 3) = 1.0f;
 	}
-	result.get(3, 0) = 0.0f;
-	result.get(3, 1) = 0.0f;
-	result.get(3, 2) = 0.0f;
-	result.get(3, 3) = 1.0f;
 	return result;
 }
 
-Vec3 randomVec3() {
-	std::srand(0);
-	auto result = Vec3{};
-	for (auto i = 0u; i < 3u; ++i) {
-		result.get(i) = static_cast<float>(std::rand());
+std::vector<Vec3> randomVec3s(std::size_t count, unsigned int seed) {
+	std::srand(seed);
+	auto result = std::vector<Vec3>{};
+	result.reserve(count);
+	for (auto i = 0u; i < count; ++i) {
+		result.emplace_back(randomFloat(), randomFloat(), randomFloat());
 	}
 	return result;
 }
 
-void matrixMultiplication(benchmark::State& state) {
-	const auto lhs = randomMatrix();
-	const auto rhs = randomMatrix();
+template <class FromSpaceT, class ToSpaceT>
+std::vector<Xform<FromSpaceT, ToSpaceT>> randomXforms(
+	std::size_t count,
+	unsigned int seed,
+	FromSpaceT fromSpace = FromSpaceT{},
+	ToSpaceT toSpace = ToSpaceT{}
+) {
+	auto result = std::vector<Xform<FromSpaceT, ToSpaceT>>{};
+	result.reserve(count);
+	for (const auto& matrix : randomMatrices(count, seed)) {
+		result.push_back(makeXform(matrix, fromSpace, toSpace));
+	}
+	return result;
+}
+
+void reportThroughput(benchmark::State& state, std::size_t bytesPerItem) {
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+	state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<std::int64_t>(bytesPerItem));
+}
+
+void xformConcatenation(benchmark::State& state) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+	const auto lhs = randomXforms<space::World, space::Player>(count, 0);
+	const auto rhs = randomXforms<space::Player, space::Camera>(count, 1);
+	auto results = std::vector<Xform<space::World, space::Camera>>(count);
 
+	const auto probe = benchmarking::PerfProbe{state};
 	for (auto _ : state) {
-		benchmark::DoNotOptimize(lhs * rhs);
+		for (auto i = 0u; i < count; ++i) {
+			results[i] = inSequence(lhs[i], rhs[i]);
+		}
+		benchmark::DoNotOptimize(results.data());
+		benchmark::ClobberMemory();
 	}
+
+	reportThroughput(state, 3 * sizeof(Matrix));
 }
 
-void noRuntimeCheckXformConcatenation(benchmark::State& state) {
-	const auto lhs = Xform<space::World, space::Player>{randomMatrix()};
-	const auto rhs = Xform<space::Player, space::Camera>{randomMatrix()};
+void rawXformConcatenation(benchmark::State& state) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+	const auto lhs = randomMatrices(count, 0);
+	const auto rhs = randomMatrices(count, 1);
+	auto results = std::vector<Matrix>(count);
 
+	const auto probe = benchmarking::PerfProbe{state};
 	for (auto _ : state) {
-		benchmark::DoNotOptimize(inSequence(lhs, rhs));
+		for (auto i = 0u; i < count; ++i) {
+			results[i] = rhs[i] * lhs[i];
+		}
+		benchmark::DoNotOptimize(results.data());
+		benchmark::ClobberMemory();
 	}
+
+	reportThroughput(state, 3 * sizeof(Matrix));
 }
 
 void runtimeCheckXformConcatenation(benchmark::State& state) {
-#ifdef DO_SPACE_RUNTIME_CHECKS
+	const auto count = static_cast<std::size_t>(state.range(0));
 	const auto playerAtFrame = space::PlayerAtFrame{31};
-#else
-	const auto playerAtFrame = space::PlayerAtFrame{};
-#endif /* DO_SPACE_RUNTIME_CHECKS */
-	const auto lhs = makeXform(randomMatrix(), space::World{}, playerAtFrame);
-	const auto rhs = makeXform(randomMatrix(), playerAtFrame, space::Camera{});
+	const auto lhs = randomXforms(count, 0, space::World{}, playerAtFrame);
+	const auto rhs = randomXforms(count, 1, playerAtFrame, space::Camera{});
+	auto results = std::vector<Xform<space::World, space::Camera>>(count);
 
+	const auto probe = benchmarking::PerfProbe{state};
 	for (auto _ : state) {
-		benchmark::DoNotOptimize(inSequence(lhs, rhs));
+		for (auto i = 0u; i < count; ++i) {
+			results[i] = inSequence(lhs[i], rhs[i]);
+		}
+		benchmark::DoNotOptimize(results.data());
+		benchmark::ClobberMemory();
 	}
+
+	reportThroughput(state, 3 * sizeof(Matrix));
+}
+
+void rawRuntimeCheckXformConcatenation(benchmark::State& state) {
+	rawXformConcatenation(state);
 }
 
-void matrixVectorMultiplication(benchmark::State& state) {
-	const auto m = randomMatrix();
-	const auto v = Vec4{randomVec3(), 1.0f};
+void xformPointTransform(benchmark::State& state) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+	const auto xform = randomXforms<space::World, space::Player>(1, 0).front();
+	auto points = std::vector<Point<space::World>>{};
+	for (const auto& v : randomVec3s(count, 1)) {
+		points.emplace_back(v);
+	}
+	auto results = std::vector<Point<space::Player>>(count);
 
+	const auto probe = benchmarking::PerfProbe{state};
 	for (auto _ : state) {
-		benchmark::DoNotOptimize(m * v);
+		for (auto i = 0u; i < count; ++i) {
+			results[i] = xform.apply(points[i]);
+		}
+		benchmark::DoNotOptimize(results.data());
+		benchmark::ClobberMemory();
 	}
+
+	reportThroughput(state, 2 * sizeof(Vec4));
 }
 
-void noRuntimeCheckVectorTransform(benchmark::State& state) {
-	const auto x = Xform<space::World, space::Player>{randomMatrix()};
-	const auto v = Point<space::World>{randomVec3()};
+void rawXformPointTransform(benchmark::State& state) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+	const auto matrix = randomMatrices(1, 0).front();
+	auto points = std::vector<Vec4>{};
+	for (const auto& v : randomVec3s(count, 1)) {
+		points.emplace_back(v, 1.0f);
+	}
+	auto results = std::vector<Vec4>(count);
 
+	const auto probe = benchmarking::PerfProbe{state};
 	for (auto _ : state) {
-		benchmark::DoNotOptimize(x.apply(v));
+		for (auto i = 0u; i < count; ++i) {
+			results[i] = matrix * points[i];
+		}
+		benchmark::DoNotOptimize(results.data());
+		benchmark::ClobberMemory();
 	}
+
+	reportThroughput(state, 2 * sizeof(Vec4));
 }
 
 void runtimeCheckVectorTransform(benchmark::State& state) {
-	const auto x = Xform<space::PlayerAtFrame, space::World>{
-		randomMatrix(), space::PlayerAtFrame{31}, space::World{}};
-	const auto v = Vector<space::PlayerAtFrame>{randomVec3(), space::PlayerAtFrame{31}};
+	const auto count = static_cast<std::size_t>(state.range(0));
+	const auto playerAtFrame = space::PlayerAtFrame{31};
+	const auto xform = randomXforms(1, 0, playerAtFrame, space::World{}).front();
+	auto vectors = std::vector<Vector<space::PlayerAtFrame>>{};
+	for (const auto& v : randomVec3s(count, 1)) {
+		vectors.emplace_back(v, playerAtFrame);
+	}
+	auto results = std::vector<Vector<space::World>>(count);
 
+	const auto probe = benchmarking::PerfProbe{state};
 	for (auto _ : state) {
-		benchmark::DoNotOptimize(x.apply(v));
+		for (auto i = 0u; i < count; ++i) {
+			results[i] = xform.apply(vectors[i]);
+		}
+		benchmark::DoNotOptimize(results.data());
+		benchmark::ClobberMemory();
 	}
+
+	reportThroughput(state, sizeof(Vector<space::PlayerAtFrame>) + sizeof(Vector<space::World>));
+}
+
+void rawRuntimeCheckVectorTransform(benchmark::State& state) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+	const auto matrix = randomMatrices(1, 0).front();
+	auto vectors = std::vector<Vec4>{};
+	for (const auto& v : randomVec3s(count, 1)) {
+		vectors.emplace_back(v, 0.0f);
+	}
+	auto results = std::vector<Vec4>(count);
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		for (auto i = 0u; i < count; ++i) {
+			results[i] = matrix * vectors[i];
+		}
+		benchmark::DoNotOptimize(results.data());
+		benchmark::ClobberMemory();
+	}
+
+	reportThroughput(state, 2 * sizeof(Vec4));
 }
 
-//BENCHMARK(matrixMultiplication);
-//BENCHMARK(noRuntimeCheckXformConcatenation);
-//BENCHMARK(runtimeCheckXformConcatenation);
-//BENCHMARK(matrixVectorMultiplication);
-//BENCHMARK(noRuntimeCheckVectorTransform);
-//BENCHMARK(runtimeCheckVectorTransform);
+constexpr auto MIN_BATCH = 1 << 10;
+constexpr auto MAX_BATCH = 1 << 16;
+
+BENCHMARK(xformConcatenation)->RangeMultiplier(8)->Range(MIN_BATCH, MAX_BATCH);
+BENCHMARK(rawXformConcatenation)->RangeMultiplier(8)->Range(MIN_BATCH, MAX_BATCH);
+BENCHMARK(runtimeCheckXformConcatenation)->RangeMultiplier(8)->Range(MIN_BATCH, MAX_BATCH);
+BENCHMARK(rawRuntimeCheckXformConcatenation)->RangeMultiplier(8)->Range(MIN_BATCH, MAX_BATCH);
+BENCHMARK(xformPointTransform)->RangeMultiplier(8)->Range(MIN_BATCH, MAX_BATCH);
+BENCHMARK(rawXformPointTransform)->RangeMultiplier(8)->Range(MIN_BATCH, MAX_BATCH);
+BENCHMARK(runtimeCheckVectorTransform)->RangeMultiplier(8)->Range(MIN_BATCH, MAX_BATCH);
+BENCHMARK(rawRuntimeCheckVectorTransform)->RangeMultiplier(8)->Range(MIN_BATCH, MAX_BATCH);
 
 } // anonymous namespace
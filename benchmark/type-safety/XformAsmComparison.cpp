@@ -0,0 +1,27 @@
+#include "type-safety/Point.hpp"
+#include "type-safety/Xform.hpp"
+
+using namespace type_safety;
+
+float externalPointSink(Position<space::Camera> p);
+float externalPointVec4Sink(Vec4 p);
+
+namespace xform_test {
+
+float callXforms(
+	const Xform<space::World, space::Player>& worldToPlayer,
+	const Xform<space::Player, space::Camera>& playerToCamera,
+	Position<space::World> position
+) {
+	return externalPointSink(inSequence(worldToPlayer, playerToCamera).apply(position));
+}
+
+float callMatrices(
+	const Matrix& worldToPlayer,
+	const Matrix& playerToCamera,
+	Vec4 position
+) {
+	return externalPointVec4Sink((playerToCamera * worldToPlayer) * position);
+}
+
+} // namespace xform_test
@@ -0,0 +1,179 @@
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <iterator>
+#include <map>
+#include <vector>
+
+#include "type-safety/XformHistory.hpp"
+#include "type-safety/PerfProbe.hpp"
+
+// Every typed benchmark has a raw-float baseline named raw<Name>, see benchmark/main.cpp. The
+// baselines here are the std::map<int, Matrix> per player the history replaces.
+
+namespace /* anonymous */ {
+
+using namespace type_safety;
+
+Matrix translation(float x) {
+	auto matrix = Matrix{};
+	for (auto row = 0u; row < 4u; ++row) {
+		for (auto column = 0u; column < 4u; ++column) {
+			matrix.get(row, column) = row == column ? 1.0f : 0.0f;
+		}
+	}
+	matrix.get(0, 3) = x;
+	return matrix;
+}
+
+// Frames within the kept history, as hit checks look them up
+std::vector<float> randomFrames(std::size_t count, int latestFrame, int historyLength) {
+	std::srand(0);
+	auto result = std::vector<float>{};
+	result.reserve(count);
+	for (auto i = 0u; i < count; ++i) {
+		const auto age = static_cast<float>(std::rand()) / static_cast<float>(RAND_MAX) * static_cast<float>(historyLength - 2);
+		result.push_back(static_cast<float>(latestFrame) - age);
+	}
+	return result;
+}
+
+constexpr auto LOOKUPS = std::size_t{1024};
+constexpr auto LATEST_FRAME = 10000;
+
+int historyLength(const benchmark::State& state) {
+	return static_cast<int>(state.range(0));
+}
+
+void fillHistory(XformHistory<>& history, int length) {
+	for (auto frame = LATEST_FRAME - length + 1; frame <= LATEST_FRAME; ++frame) {
+		history.record(frame, translation(static_cast<float>(frame)));
+	}
+}
+
+std::map<int, Matrix> makeMap(int length) {
+	auto history = std::map<int, Matrix>{};
+	for (auto frame = LATEST_FRAME - length + 1; frame <= LATEST_FRAME; ++frame) {
+		history.emplace(frame, translation(static_cast<float>(frame)));
+	}
+	return history;
+}
+
+void historyLookup(benchmark::State& state) {
+	auto history = XformHistory<>{static_cast<std::size_t>(historyLength(state))};
+	fillHistory(history, historyLength(state));
+	const auto frames = randomFrames(LOOKUPS, LATEST_FRAME, historyLength(state));
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		for (const auto frame : frames) {
+			benchmark::DoNotOptimize(history.at(static_cast<int>(frame)));
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * LOOKUPS);
+}
+
+void rawHistoryLookup(benchmark::State& state) {
+	const auto history = makeMap(historyLength(state));
+	const auto frames = randomFrames(LOOKUPS, LATEST_FRAME, historyLength(state));
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		for (const auto frame : frames) {
+			const auto it = history.find(static_cast<int>(frame));
+			if (it != history.end()) {
+				benchmark::DoNotOptimize(Matrix{it->second});
+			}
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * LOOKUPS);
+}
+
+void historyInterpolatedLookup(benchmark::State& state) {
+	auto history = XformHistory<>{static_cast<std::size_t>(historyLength(state))};
+	fillHistory(history, historyLength(state));
+	const auto frames = randomFrames(LOOKUPS, LATEST_FRAME, historyLength(state));
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		for (const auto frame : frames) {
+			benchmark::DoNotOptimize(history.interpolated(frame));
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * LOOKUPS);
+}
+
+void rawHistoryInterpolatedLookup(benchmark::State& state) {
+	const auto history = makeMap(historyLength(state));
+	const auto frames = randomFrames(LOOKUPS, LATEST_FRAME, historyLength(state));
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		for (const auto frame : frames) {
+			const auto earlierFrame = std::floor(frame);
+			const auto earlier = history.find(static_cast<int>(earlierFrame));
+			if (earlier == history.end() || std::next(earlier) == history.end()) {
+				continue;
+			}
+			const auto later = std::next(earlier);
+			const auto t = frame - earlierFrame;
+			auto result = Matrix{};
+			for (auto row = 0u; row < 4u; ++row) {
+				for (auto column = 0u; column < 4u; ++column) {
+					const auto start = earlier->second.get(row, column);
+					result.get(row, column) = start + (later->second.get(row, column) - start) * t;
+				}
+			}
+			benchmark::DoNotOptimize(result);
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * LOOKUPS);
+}
+
+// Recording a frame and evicting the oldest one
+void historyRecord(benchmark::State& state) {
+	auto history = XformHistory<>{static_cast<std::size_t>(historyLength(state))};
+	fillHistory(history, historyLength(state));
+	const auto matrix = translation(1.0f);
+	auto frame = LATEST_FRAME;
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		history.record(++frame, matrix);
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+
+void rawHistoryRecord(benchmark::State& state) {
+	auto history = makeMap(historyLength(state));
+	const auto matrix = translation(1.0f);
+	auto frame = LATEST_FRAME;
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		history.emplace(++frame, matrix);
+		history.erase(history.begin());
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+
+constexpr auto MIN_HISTORY = 16;
+constexpr auto MAX_HISTORY = 1024;
+
+BENCHMARK(historyLookup)->RangeMultiplier(8)->Range(MIN_HISTORY, MAX_HISTORY);
+BENCHMARK(rawHistoryLookup)->RangeMultiplier(8)->Range(MIN_HISTORY, MAX_HISTORY);
+BENCHMARK(historyInterpolatedLookup)->RangeMultiplier(8)->Range(MIN_HISTORY, MAX_HISTORY);
+BENCHMARK(rawHistoryInterpolatedLookup)->RangeMultiplier(8)->Range(MIN_HISTORY, MAX_HISTORY);
+BENCHMARK(historyRecord)->RangeMultiplier(8)->Range(MIN_HISTORY, MAX_HISTORY);
+BENCHMARK(rawHistoryRecord)->RangeMultiplier(8)->Range(MIN_HISTORY, MAX_HISTORY);
+
+} // anonymous namespace
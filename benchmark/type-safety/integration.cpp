@@ -0,0 +1,180 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "type-safety/integration.hpp"
+#include "type-safety/PerfProbe.hpp"
+
+// Every typed benchmark has a raw-float baseline named raw<Name>, see benchmark/main.cpp.
+
+namespace /* anonymous */ {
+
+using namespace type_safety;
+using namespace type_safety::unit_literals;
+
+std::vector<float> randomFloats(std::size_t count, unsigned int seed) {
+	std::srand(seed);
+	auto result = std::vector<float>{};
+	result.reserve(count);
+	for (auto i = 0u; i < count; ++i) {
+		result.push_back(static_cast<float>(std::rand()) / static_cast<float>(RAND_MAX) * 100.0f);
+	}
+	return result;
+}
+
+template <class UnitT>
+std::vector<Value<UnitT>> randomValues(std::size_t count, unsigned int seed) {
+	auto result = std::vector<Value<UnitT>>{};
+	result.reserve(count);
+	for (const auto value : randomFloats(count, seed)) {
+		result.push_back(makeValue<UnitT>(value));
+	}
+	return result;
+}
+
+void reportParticles(benchmark::State& state) {
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void semiImplicitEulerStep(benchmark::State& state) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+	auto positions = randomValues<Metres>(count, 0);
+	auto velocities = randomValues<MPS>(count, 1);
+	const auto accelerations = randomValues<MPS2>(count, 2);
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		semiImplicitEuler(positions.data(), velocities.data(), accelerations.data(), count, 16_ms);
+		benchmark::DoNotOptimize(positions.data());
+		benchmark::ClobberMemory();
+	}
+
+	reportParticles(state);
+}
+
+void rawSemiImplicitEulerStep(benchmark::State& state) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+	auto positions = randomFloats(count, 0);
+	auto velocities = randomFloats(count, 1);
+	const auto accelerations = randomFloats(count, 2);
+	const auto dt = 0.016f;
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		for (auto i = 0u; i < count; ++i) {
+			velocities[i] += accelerations[i] * dt;
+			positions[i] += velocities[i] * dt;
+		}
+		benchmark::DoNotOptimize(positions.data());
+		benchmark::ClobberMemory();
+	}
+
+	reportParticles(state);
+}
+
+void velocityVerletStep(benchmark::State& state) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+	auto positions = randomValues<Metres>(count, 0);
+	auto velocities = randomValues<MPS>(count, 1);
+	auto accelerations = randomValues<MPS2>(count, 2);
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		velocityVerletBegin(positions.data(), velocities.data(), accelerations.data(), count, 16_ms);
+		velocityVerletEnd(velocities.data(), accelerations.data(), count, 16_ms);
+		benchmark::DoNotOptimize(positions.data());
+		benchmark::ClobberMemory();
+	}
+
+	reportParticles(state);
+}
+
+void rawVelocityVerletStep(benchmark::State& state) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+	auto positions = randomFloats(count, 0);
+	auto velocities = randomFloats(count, 1);
+	auto accelerations = randomFloats(count, 2);
+	const auto halfDt = 0.008f;
+	const auto dt = 0.016f;
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		for (auto i = 0u; i < count; ++i) {
+			velocities[i] += accelerations[i] * halfDt;
+			positions[i] += velocities[i] * dt;
+		}
+		for (auto i = 0u; i < count; ++i) {
+			velocities[i] += accelerations[i] * halfDt;
+		}
+		benchmark::DoNotOptimize(positions.data());
+		benchmark::ClobberMemory();
+	}
+
+	reportParticles(state);
+}
+
+void chunkedSemiImplicitEulerStep(benchmark::State& state) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+	auto positions = randomValues<Metres>(count, 0);
+	auto velocities = randomValues<MPS>(count, 1);
+	const auto accelerations = randomValues<MPS2>(count, 2);
+	const auto chunking = Chunking{std::thread::hardware_concurrency()};
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		semiImplicitEuler(positions.data(), velocities.data(), accelerations.data(), count, 16_ms, chunking);
+		benchmark::DoNotOptimize(positions.data());
+		benchmark::ClobberMemory();
+	}
+
+	reportParticles(state);
+}
+
+// The same loop split over threads by hand
+void rawChunkedSemiImplicitEulerStep(benchmark::State& state) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+	auto positions = randomFloats(count, 0);
+	auto velocities = randomFloats(count, 1);
+	const auto accelerations = randomFloats(count, 2);
+	const auto dt = 0.016f;
+	const auto threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+	const auto chunkSize = (count + threadCount - 1) / threadCount;
+
+	const auto step = [&](std::size_t begin, std::size_t end) {
+		for (auto i = begin; i < end; ++i) {
+			velocities[i] += accelerations[i] * dt;
+			positions[i] += velocities[i] * dt;
+		}
+	};
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		auto threads = std::vector<std::thread>{};
+		for (auto begin = chunkSize; begin < count; begin += chunkSize) {
+			threads.emplace_back(step, begin, std::min(begin + chunkSize, count));
+		}
+		step(0, std::min(chunkSize, count));
+		for (auto& thread : threads) {
+			thread.join();
+		}
+		benchmark::DoNotOptimize(positions.data());
+		benchmark::ClobberMemory();
+	}
+
+	reportParticles(state);
+}
+
+constexpr auto MIN_PARTICLES = 1 << 10;
+constexpr auto MAX_PARTICLES = 1 << 22;
+
+BENCHMARK(semiImplicitEulerStep)->RangeMultiplier(32)->Range(MIN_PARTICLES, MAX_PARTICLES);
+BENCHMARK(rawSemiImplicitEulerStep)->RangeMultiplier(32)->Range(MIN_PARTICLES, MAX_PARTICLES);
+BENCHMARK(velocityVerletStep)->RangeMultiplier(32)->Range(MIN_PARTICLES, MAX_PARTICLES);
+BENCHMARK(rawVelocityVerletStep)->RangeMultiplier(32)->Range(MIN_PARTICLES, MAX_PARTICLES);
+BENCHMARK(chunkedSemiImplicitEulerStep)->RangeMultiplier(32)->Range(MIN_PARTICLES, MAX_PARTICLES)->UseRealTime();
+BENCHMARK(rawChunkedSemiImplicitEulerStep)->RangeMultiplier(32)->Range(MIN_PARTICLES, MAX_PARTICLES)->UseRealTime();
+
+} // anonymous namespace
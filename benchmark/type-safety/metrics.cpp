@@ -0,0 +1,79 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+
+#include "type-safety/metrics.hpp"
+#include "type-safety/PerfProbe.hpp"
+
+// Every typed benchmark has a raw-float baseline named raw<Name>, see benchmark/main.cpp.
+
+namespace /* anonymous */ {
+
+using namespace type_safety;
+using namespace type_safety::unit_literals;
+
+constexpr auto MAX_THREADS = 64;
+
+void counterAdd(benchmark::State& state) {
+	static auto energySpent = Counter<Joules>{};
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		energySpent.add(0.5_J);
+	}
+
+	benchmark::DoNotOptimize(energySpent.value());
+	state.SetItemsProcessed(state.iterations());
+}
+
+// What a shared float total takes without sharding: a CAS loop on a single cache line
+void rawCounterAdd(benchmark::State& state) {
+	static auto energySpent = std::atomic<float>{0.0f};
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		auto expected = energySpent.load(std::memory_order_relaxed);
+		while (!energySpent.compare_exchange_weak(expected, expected + 0.5f, std::memory_order_relaxed)) {
+		}
+	}
+
+	benchmark::DoNotOptimize(energySpent.load(std::memory_order_relaxed));
+	state.SetItemsProcessed(state.iterations());
+}
+
+void gaugeAddSubtract(benchmark::State& state) {
+	static auto massInTransit = Gauge<Kilograms>{};
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		massInTransit.add(2_kg);
+		massInTransit.subtract(2_kg);
+	}
+
+	benchmark::DoNotOptimize(massInTransit.value());
+	state.SetItemsProcessed(state.iterations());
+}
+
+void rawGaugeAddSubtract(benchmark::State& state) {
+	static auto massInTransit = std::atomic<float>{0.0f};
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		auto expected = massInTransit.load(std::memory_order_relaxed);
+		while (!massInTransit.compare_exchange_weak(expected, expected + 2.0f, std::memory_order_relaxed)) {
+		}
+		expected = massInTransit.load(std::memory_order_relaxed);
+		while (!massInTransit.compare_exchange_weak(expected, expected - 2.0f, std::memory_order_relaxed)) {
+		}
+	}
+
+	benchmark::DoNotOptimize(massInTransit.load(std::memory_order_relaxed));
+	state.SetItemsProcessed(state.iterations());
+}
+
+} // anonymous namespace
+
+BENCHMARK(counterAdd)->ThreadRange(1, MAX_THREADS)->UseRealTime();
+BENCHMARK(rawCounterAdd)->ThreadRange(1, MAX_THREADS)->UseRealTime();
+BENCHMARK(gaugeAddSubtract)->ThreadRange(1, MAX_THREADS)->UseRealTime();
+BENCHMARK(rawGaugeAddSubtract)->ThreadRange(1, MAX_THREADS)->UseRealTime();
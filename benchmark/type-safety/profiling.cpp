@@ -0,0 +1,74 @@
+#define TYPE_SAFETY_PROFILING
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+
+#include "type-safety/profiling.hpp"
+#include "type-safety/PerfProbe.hpp"
+
+// Every typed benchmark has a raw-float baseline named raw<Name>, see benchmark/main.cpp.
+
+namespace /* anonymous */ {
+
+using namespace type_safety;
+
+void scopedTimer(benchmark::State& state) {
+	auto histogram = LatencyHistogram{};
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		const auto timer = ScopedTimer{histogram};
+		benchmark::ClobberMemory();
+	}
+
+	benchmark::DoNotOptimize(histogram.snapshot().count());
+}
+
+// The usual hand-written alternative: two clock reads summed into a float
+void rawScopedTimer(benchmark::State& state) {
+	auto totalMilliseconds = 0.0f;
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		const auto start = std::chrono::steady_clock::now();
+		benchmark::ClobberMemory();
+		const auto end = std::chrono::steady_clock::now();
+		totalMilliseconds += std::chrono::duration<float, std::milli>(end - start).count();
+	}
+
+	benchmark::DoNotOptimize(totalMilliseconds);
+}
+
+void perThreadScopedTimer(benchmark::State& state) {
+	static auto histogram = PerThreadLatencyHistogram{};
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		const auto timer = ScopedTimer{histogram};
+		benchmark::ClobberMemory();
+	}
+
+	benchmark::DoNotOptimize(histogram.local().snapshot().count());
+}
+
+void rawPerThreadScopedTimer(benchmark::State& state) {
+	thread_local auto totalMilliseconds = 0.0f;
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		const auto start = std::chrono::steady_clock::now();
+		benchmark::ClobberMemory();
+		const auto end = std::chrono::steady_clock::now();
+		totalMilliseconds += std::chrono::duration<float, std::milli>(end - start).count();
+	}
+
+	benchmark::DoNotOptimize(totalMilliseconds);
+}
+
+} // anonymous namespace
+
+BENCHMARK(scopedTimer);
+BENCHMARK(rawScopedTimer);
+BENCHMARK(perThreadScopedTimer)->ThreadRange(1, 4);
+BENCHMARK(rawPerThreadScopedTimer)->ThreadRange(1, 4);
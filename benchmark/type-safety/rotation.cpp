@@ -0,0 +1,123 @@
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#include "type-safety/rotation.hpp"
+#include "type-safety/PerfProbe.hpp"
+
+namespace /* anonymous */ {
+
+using namespace type_safety;
+
+struct RotationAngles {
+	Angle pitch;
+	Angle yaw;
+	Angle roll;
+};
+
+std::vector<Angle> randomAngles(std::size_t count, unsigned int seed) {
+	std::srand(seed);
+	auto result = std::vector<Angle>{};
+	result.reserve(count);
+	for (auto i = 0u; i < count; ++i) {
+		const auto unit = static_cast<float>(std::rand()) / static_cast<float>(RAND_MAX);
+		result.emplace_back(radiansTag, (unit * 2.0f - 1.0f) * 3.14f);
+	}
+	return result;
+}
+
+std::vector<RotationAngles> randomRotations(std::size_t count) {
+	const auto pitches = randomAngles(count, 0);
+	const auto yaws = randomAngles(count, 1);
+	const auto rolls = randomAngles(count, 2);
+	auto result = std::vector<RotationAngles>{};
+	result.reserve(count);
+	for (auto i = 0u; i < count; ++i) {
+		result.push_back({ pitches[i], yaws[i], rolls[i] });
+	}
+	return result;
+}
+
+// What building a rotation looks like without the builders - one matrix per axis, filled
+// element by element with separate libm calls, then multiplied together.
+Matrix libmAxisRotation(std::size_t u, std::size_t v, Angle a) {
+	auto result = Matrix{};
+	for (auto row = 0u; row < 4u; ++row) {
+		for (auto column = 0u; column < 4u; ++column) {
+			result.get(row, column) = (row == column) ? 1.0f : 0.0f;
+		}
+	}
+	result.get(u, u) = std::cos(a.radians());
+	result.get(u, v) = -std::sin(a.radians());
+	result.get(v, u) = std::sin(a.radians());
+	result.get(v, v) = std::cos(a.radians());
+	return result;
+}
+
+void libmRotationMatrices(benchmark::State& state) {
+	const auto rotations = randomRotations(static_cast<std::size_t>(state.range(0)));
+	auto xforms = std::vector<Xform<space::World, space::Player>>(rotations.size());
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		for (auto i = 0u; i < rotations.size(); ++i) {
+			xforms[i].matrix() =
+				libmAxisRotation(1, 2, rotations[i].pitch) *
+				libmAxisRotation(0, 1, rotations[i].roll) *
+				libmAxisRotation(2, 0, rotations[i].yaw);
+		}
+		benchmark::DoNotOptimize(xforms.data());
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <TrigPrecision PRECISION>
+void singleRotationXforms(benchmark::State& state) {
+	const auto rotations = randomRotations(static_cast<std::size_t>(state.range(0)));
+	auto xforms = std::vector<Xform<space::World, space::Player>>(rotations.size());
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		for (auto i = 0u; i < rotations.size(); ++i) {
+			xforms[i] = makeRotationXform<space::World, space::Player, PRECISION>(
+				rotations[i].pitch, rotations[i].yaw, rotations[i].roll, RotationOrder::YZX);
+		}
+		benchmark::DoNotOptimize(xforms.data());
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <TrigPrecision PRECISION>
+void batchRotationXforms(benchmark::State& state) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+	const auto pitches = randomAngles(count, 0);
+	const auto yaws = randomAngles(count, 1);
+	const auto rolls = randomAngles(count, 2);
+	auto xforms = std::vector<Xform<space::World, space::Player>>(count);
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		makeRotationXforms<PRECISION>(pitches.data(), yaws.data(), rolls.data(), RotationOrder::YZX, xforms.data(), count);
+		benchmark::DoNotOptimize(xforms.data());
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+constexpr auto MIN_ACTORS = 1 << 10;
+constexpr auto MAX_ACTORS = 1 << 20;
+
+BENCHMARK(libmRotationMatrices)->RangeMultiplier(32)->Range(MIN_ACTORS, MAX_ACTORS);
+BENCHMARK_TEMPLATE(singleRotationXforms, TrigPrecision::FAST)->RangeMultiplier(32)->Range(MIN_ACTORS, MAX_ACTORS);
+BENCHMARK_TEMPLATE(singleRotationXforms, TrigPrecision::MEDIUM)->RangeMultiplier(32)->Range(MIN_ACTORS, MAX_ACTORS);
+BENCHMARK_TEMPLATE(batchRotationXforms, TrigPrecision::FAST)->RangeMultiplier(32)->Range(MIN_ACTORS, MAX_ACTORS);
+BENCHMARK_TEMPLATE(batchRotationXforms, TrigPrecision::MEDIUM)->RangeMultiplier(32)->Range(MIN_ACTORS, MAX_ACTORS);
+
+} // anonymous namespace
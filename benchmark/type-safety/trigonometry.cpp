@@ -0,0 +1,192 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+#include "type-safety/trigonometry.hpp"
+#include "type-safety/PerfProbe.hpp"
+
+namespace /* anonymous */ {
+
+using namespace type_safety;
+
+std::vector<Angle> randomAngles(std::size_t count) {
+	std::srand(0);
+	auto result = std::vector<Angle>{};
+	result.reserve(count);
+	for (auto i = 0u; i < count; ++i) {
+		const auto unit = static_cast<float>(std::rand()) / static_cast<float>(RAND_MAX);
+		result.emplace_back(radiansTag, (unit * 2.0f - 1.0f) * 100.0f);
+	}
+	return result;
+}
+
+std::vector<float> randomFloats(std::size_t count, unsigned int seed) {
+	std::srand(seed);
+	auto result = std::vector<float>{};
+	result.reserve(count);
+	for (auto i = 0u; i < count; ++i) {
+		const auto unit = static_cast<float>(std::rand()) / static_cast<float>(RAND_MAX);
+		result.push_back(unit * 20.0f - 10.0f);
+	}
+	return result;
+}
+
+double ulpOf(double reference) {
+	const auto rounded = std::abs(static_cast<float>(reference));
+	return std::nextafter(rounded, std::numeric_limits<float>::infinity()) - rounded;
+}
+
+// Fills the error table columns: max absolute and max ulp error against double precision libm.
+template <class ReferenceT>
+void reportError(benchmark::State& state, const std::vector<float>& results, ReferenceT reference) {
+	auto maxAbsError = 0.0;
+	auto maxUlpError = 0.0;
+	for (auto i = 0u; i < results.size(); ++i) {
+		const auto expected = reference(i);
+		const auto error = std::abs(static_cast<double>(results[i]) - expected);
+		maxAbsError = std::max(maxAbsError, error);
+		maxUlpError = std::max(maxUlpError, error / ulpOf(expected));
+	}
+	state.counters["max_abs_error"] = maxAbsError;
+	state.counters["max_ulp"] = maxUlpError;
+}
+
+void libmSin(benchmark::State& state) {
+	const auto angles = randomAngles(static_cast<std::size_t>(state.range(0)));
+	auto results = std::vector<float>(angles.size());
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		for (auto i = 0u; i < angles.size(); ++i) {
+			results[i] = std::sin(angles[i].radians());
+		}
+		benchmark::DoNotOptimize(results.data());
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+	reportError(state, results, [&](auto i) { return std::sin(static_cast<double>(angles[i].radians())); });
+}
+
+template <TrigPrecision PRECISION>
+void angleSin(benchmark::State& state) {
+	const auto angles = randomAngles(static_cast<std::size_t>(state.range(0)));
+	auto results = std::vector<float>(angles.size());
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		sin<PRECISION>(angles.data(), results.data(), angles.size());
+		benchmark::DoNotOptimize(results.data());
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+	reportError(state, results, [&](auto i) { return std::sin(static_cast<double>(angles[i].radians())); });
+}
+
+void libmSinCos(benchmark::State& state) {
+	const auto angles = randomAngles(static_cast<std::size_t>(state.range(0)));
+	auto sines = std::vector<float>(angles.size());
+	auto cosines = std::vector<float>(angles.size());
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		for (auto i = 0u; i < angles.size(); ++i) {
+			sines[i] = std::sin(angles[i].radians());
+			cosines[i] = std::cos(angles[i].radians());
+		}
+		benchmark::DoNotOptimize(sines.data());
+		benchmark::DoNotOptimize(cosines.data());
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+	reportError(state, cosines, [&](auto i) { return std::cos(static_cast<double>(angles[i].radians())); });
+}
+
+template <TrigPrecision PRECISION>
+void angleSinCos(benchmark::State& state) {
+	const auto angles = randomAngles(static_cast<std::size_t>(state.range(0)));
+	auto sines = std::vector<float>(angles.size());
+	auto cosines = std::vector<float>(angles.size());
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		sincos<PRECISION>(angles.data(), sines.data(), cosines.data(), angles.size());
+		benchmark::DoNotOptimize(sines.data());
+		benchmark::DoNotOptimize(cosines.data());
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+	reportError(state, cosines, [&](auto i) { return std::cos(static_cast<double>(angles[i].radians())); });
+}
+
+void libmAtan2(benchmark::State& state) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+	const auto ys = randomFloats(count, 0);
+	const auto xs = randomFloats(count, 1);
+	auto results = std::vector<float>(count);
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		for (auto i = 0u; i < count; ++i) {
+			results[i] = std::atan2(ys[i], xs[i]);
+		}
+		benchmark::DoNotOptimize(results.data());
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+	reportError(state, results, [&](auto i) {
+			return std::atan2(static_cast<double>(ys[i]), static_cast<double>(xs[i]));
+		});
+}
+
+template <TrigPrecision PRECISION>
+void angleAtan2(benchmark::State& state) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+	const auto ys = randomFloats(count, 0);
+	const auto xs = randomFloats(count, 1);
+	auto angles = std::vector<Angle>(count);
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		type_safety::atan2<PRECISION>(ys.data(), xs.data(), angles.data(), count);
+		benchmark::DoNotOptimize(angles.data());
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+
+	auto results = std::vector<float>{};
+	results.reserve(count);
+	for (const auto& angle : angles) {
+		results.push_back(angle.radians());
+	}
+	reportError(state, results, [&](auto i) {
+			return std::atan2(static_cast<double>(ys[i]), static_cast<double>(xs[i]));
+		});
+}
+
+constexpr auto MIN_BATCH = 1 << 10;
+constexpr auto MAX_BATCH = 1 << 20;
+
+BENCHMARK(libmSin)->RangeMultiplier(32)->Range(MIN_BATCH, MAX_BATCH);
+BENCHMARK_TEMPLATE(angleSin, TrigPrecision::FAST)->RangeMultiplier(32)->Range(MIN_BATCH, MAX_BATCH);
+BENCHMARK_TEMPLATE(angleSin, TrigPrecision::MEDIUM)->RangeMultiplier(32)->Range(MIN_BATCH, MAX_BATCH);
+BENCHMARK_TEMPLATE(angleSin, TrigPrecision::ACCURATE)->RangeMultiplier(32)->Range(MIN_BATCH, MAX_BATCH);
+BENCHMARK(libmSinCos)->RangeMultiplier(32)->Range(MIN_BATCH, MAX_BATCH);
+BENCHMARK_TEMPLATE(angleSinCos, TrigPrecision::FAST)->RangeMultiplier(32)->Range(MIN_BATCH, MAX_BATCH);
+BENCHMARK_TEMPLATE(angleSinCos, TrigPrecision::MEDIUM)->RangeMultiplier(32)->Range(MIN_BATCH, MAX_BATCH);
+BENCHMARK_TEMPLATE(angleSinCos, TrigPrecision::ACCURATE)->RangeMultiplier(32)->Range(MIN_BATCH, MAX_BATCH);
+BENCHMARK(libmAtan2)->RangeMultiplier(32)->Range(MIN_BATCH, MAX_BATCH);
+BENCHMARK_TEMPLATE(angleAtan2, TrigPrecision::FAST)->RangeMultiplier(32)->Range(MIN_BATCH, MAX_BATCH);
+BENCHMARK_TEMPLATE(angleAtan2, TrigPrecision::MEDIUM)->RangeMultiplier(32)->Range(MIN_BATCH, MAX_BATCH);
+BENCHMARK_TEMPLATE(angleAtan2, TrigPrecision::ACCURATE)->RangeMultiplier(32)->Range(MIN_BATCH, MAX_BATCH);
+
+} // anonymous namespace
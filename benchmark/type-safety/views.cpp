@@ -0,0 +1,185 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include "type-safety/views.hpp"
+#include "type-safety/PerfProbe.hpp"
+
+// Every typed benchmark has a raw-float baseline named raw<Name>, see benchmark/main.cpp.
+//
+// The pipeline takes points from player to world to camera space and keeps those in front of
+// the camera, once fused through views and once as passes materializing every step. The
+// bytes processed are the memory traffic each variant needs - the fused one reads the points
+// once, the multi-pass one writes and reads back two intermediate arrays and the survivors -
+// and --perf_counters adds the cache misses actually seen.
+
+namespace /* anonymous */ {
+
+using namespace type_safety;
+
+using PlayerPoint = Point<space::Player, Metres>;
+using WorldPoint = Point<space::World, Metres>;
+using CameraPoint = Point<space::Camera, Metres>;
+
+Matrix randomMatrix(unsigned int seed) {
+	std::srand(seed);
+	auto matrix = Matrix{};
+	for (auto row = 0u; row < 4u; ++row) {
+		for (auto column = 0u; column < 4u; ++column) {
+			matrix.get(row, column) = row == 3u ? (column == 3u ? 1.0f : 0.0f) : static_cast<float>(std::rand() % 200 - 100) / 100.0f;
+		}
+	}
+	return matrix;
+}
+
+std::vector<Vec4> randomCoordinates(std::size_t count) {
+	std::srand(2);
+	auto result = std::vector<Vec4>{};
+	result.reserve(count);
+	for (auto i = 0u; i < count; ++i) {
+		const auto coordinate = [] { return static_cast<float>(std::rand() % 2000 - 1000) / 100.0f; };
+		result.emplace_back(coordinate(), coordinate(), coordinate(), 1.0f);
+	}
+	return result;
+}
+
+std::vector<PlayerPoint> randomPoints(std::size_t count) {
+	auto result = std::vector<PlayerPoint>{};
+	result.reserve(count);
+	for (const auto& coordinates : randomCoordinates(count)) {
+		result.emplace_back(coordinates);
+	}
+	return result;
+}
+
+// Upper bounds, assuming every point survives the filter
+constexpr auto FUSED_BYTES_PER_POINT = sizeof(Vec4);
+constexpr auto MULTI_PASS_BYTES_PER_POINT = 6 * sizeof(Vec4);
+
+void reportTraffic(benchmark::State& state, std::size_t bytesPerPoint) {
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+	state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<std::int64_t>(bytesPerPoint));
+}
+
+void fusedPipeline(benchmark::State& state) {
+	const auto points = randomPoints(static_cast<std::size_t>(state.range(0)));
+	const auto playerToWorld = Xform<space::Player, space::World>{randomMatrix(0)};
+	const auto worldToCamera = Xform<space::World, space::Camera>{randomMatrix(1)};
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		const auto visible = points
+			| views::xformed(playerToWorld)
+			| views::xformed(worldToCamera)
+			| views::filtered([](const CameraPoint& p) { return p.vector().get(2) > 0.0f; });
+		auto sum = 0.0f;
+		visible.forEach([&](const CameraPoint& p) { sum += p.vector().get(0); });
+		benchmark::DoNotOptimize(sum);
+	}
+
+	reportTraffic(state, FUSED_BYTES_PER_POINT);
+}
+
+void rawFusedPipeline(benchmark::State& state) {
+	const auto points = randomCoordinates(static_cast<std::size_t>(state.range(0)));
+	const auto matrix = randomMatrix(1) * randomMatrix(0);
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		auto sum = 0.0f;
+		for (const auto& point : points) {
+			const auto p = matrix * point;
+			if (p.get(2) > 0.0f) {
+				sum += p.get(0);
+			}
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+
+	reportTraffic(state, FUSED_BYTES_PER_POINT);
+}
+
+void multiPassPipeline(benchmark::State& state) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+	const auto points = randomPoints(count);
+	const auto playerToWorld = Xform<space::Player, space::World>{randomMatrix(0)};
+	const auto worldToCamera = Xform<space::World, space::Camera>{randomMatrix(1)};
+	auto worldPoints = std::vector<WorldPoint>{};
+	auto cameraPoints = std::vector<CameraPoint>{};
+	auto visible = std::vector<CameraPoint>{};
+	worldPoints.reserve(count);
+	cameraPoints.reserve(count);
+	visible.reserve(count);
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		worldPoints.clear();
+		for (const auto& p : points) {
+			worldPoints.push_back(playerToWorld.apply(p));
+		}
+		cameraPoints.clear();
+		for (const auto& p : worldPoints) {
+			cameraPoints.push_back(worldToCamera.apply(p));
+		}
+		visible.clear();
+		for (const auto& p : cameraPoints) {
+			if (p.vector().get(2) > 0.0f) {
+				visible.push_back(p);
+			}
+		}
+		auto sum = 0.0f;
+		for (const auto& p : visible) {
+			sum += p.vector().get(0);
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+
+	reportTraffic(state, MULTI_PASS_BYTES_PER_POINT);
+}
+
+void rawMultiPassPipeline(benchmark::State& state) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+	const auto points = randomCoordinates(count);
+	const auto playerToWorld = randomMatrix(0);
+	const auto worldToCamera = randomMatrix(1);
+	auto worldPoints = std::vector<Vec4>{};
+	auto cameraPoints = std::vector<Vec4>{};
+	auto visible = std::vector<Vec4>{};
+	worldPoints.reserve(count);
+	cameraPoints.reserve(count);
+	visible.reserve(count);
+
+	const auto probe = benchmarking::PerfProbe{state};
+	for (auto _ : state) {
+		worldPoints.clear();
+		for (const auto& p : points) {
+			worldPoints.push_back(playerToWorld * p);
+		}
+		cameraPoints.clear();
+		for (const auto& p : worldPoints) {
+			cameraPoints.push_back(worldToCamera * p);
+		}
+		visible.clear();
+		for (const auto& p : cameraPoints) {
+			if (p.get(2) > 0.0f) {
+				visible.push_back(p);
+			}
+		}
+		auto sum = 0.0f;
+		for (const auto& p : visible) {
+			sum += p.get(0);
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+
+	reportTraffic(state, MULTI_PASS_BYTES_PER_POINT);
+}
+
+BENCHMARK(fusedPipeline)->RangeMultiplier(16)->Range(1024, 1024 * 1024);
+BENCHMARK(rawFusedPipeline)->RangeMultiplier(16)->Range(1024, 1024 * 1024);
+BENCHMARK(multiPassPipeline)->RangeMultiplier(16)->Range(1024, 1024 * 1024);
+BENCHMARK(rawMultiPassPipeline)->RangeMultiplier(16)->Range(1024, 1024 * 1024);
+
+} // anonymous namespace
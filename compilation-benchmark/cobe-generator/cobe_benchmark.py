@@ -0,0 +1,272 @@
+#!/usr/bin/env python
+
+# Generates the cobe scenarios for a range of file counts, compiles them with GCC and Clang
+# and reports how the build cost scales, where it goes (GCC: -ftime-report phases, Clang:
+# -ftime-trace headers and template instantiations) and writes everything to a CSV file.
+
+import argparse
+import collections
+import concurrent.futures
+import json
+import logging
+import os
+import re
+import shutil
+import subprocess
+import sys
+import time
+
+import cobe_generator
+
+COBE_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SRC_DIR = os.path.join(os.path.dirname(COBE_DIR), "src")
+
+# name: (cpp template, header template). The PCH variants depend on MSVC precompiled headers
+# and are only built by the vs2017 pipeline.
+SCENARIOS = collections.OrderedDict([
+	("angle", ("angle/angle.cpp.cobe", "angle/angle.h.cobe")),
+	("angle-float", ("angle/angle-float.cpp.cobe", "angle/angle-float.h.cobe")),
+	("unit", ("unit/unit.cpp.cobe", "unit/unit.h.cobe")),
+	("unit-float", ("unit/unit-float.cpp.cobe", "unit/unit-float.h.cobe")),
+	("xform", ("xform/xform.cpp.cobe", "xform/xform.h.cobe")),
+	("xform-matrix", ("xform/xform-matrix.cpp.cobe", "xform/xform-matrix.h.cobe")),
+])
+
+# -ftime-report lines, e.g. " phase parsing    :   0.38 ( 88%)   0.20 ( 91%)   0.60 ( 90%)    39M ( 86%)"
+TIME_REPORT_LINE = re.compile(r"^\s*(\|?[^:]+?)\s*:\s*([\d.]+)\s*(?:\(\s*\d+%\))?\s*([\d.]+)\s*(?:\(\s*\d+%\))?\s*([\d.]+)")
+
+# -ftime-report entries reported per TU, all in CPU (user + system) seconds
+GCC_PHASES = collections.OrderedDict([
+	("parsing", "phase parsing"),
+	("instantiation", "template instantiation"),
+	("codegen", "phase opt and generate"),
+	("total", "TOTAL"),
+])
+
+# frontend is Clang's equivalent of GCC's parsing
+PHASE_ORDER = ("parsing", "frontend", "instantiation", "codegen", "total")
+
+CLANG_INSTANTIATION_EVENTS = ("InstantiateClass", "InstantiateFunction")
+
+# Generated headers differ only in their index - "unit.17.h" is counted as "unit.N.h"
+GENERATED_HEADER = re.compile(r"\.\d+\.h$")
+
+class CompilerKind:
+	GCC = "gcc"
+	CLANG = "clang"
+
+def compiler_kind(compiler):
+	version = subprocess.run([compiler, "--version"], stdout=subprocess.PIPE, universal_newlines=True).stdout
+	return CompilerKind.CLANG if "clang" in version else CompilerKind.GCC
+
+class TranslationUnit:
+	def __init__(self):
+		self.wall = 0.0
+		self.phases = {}
+		self.headers = collections.Counter()
+		self.templates = collections.Counter()
+		self.instantiations = collections.Counter()
+
+def parse_time_report(report):
+	phases = {}
+	names = dict((entry, phase) for phase, entry in GCC_PHASES.items())
+	for line in report.splitlines():
+		m = TIME_REPORT_LINE.match(line)
+		if m and m.group(1) in names:
+			phases[names[m.group(1)]] = float(m.group(2)) + float(m.group(3))
+	return phases
+
+def header_name(path):
+	path = os.path.normpath(path)
+	if path.startswith(SRC_DIR):
+		return os.path.relpath(path, SRC_DIR)
+	if GENERATED_HEADER.search(path):
+		return GENERATED_HEADER.sub(".N.h", os.path.basename(path))
+	return path
+
+def template_name(instantiation):
+	return instantiation.split("<", 1)[0]
+
+def parse_time_trace(trace_file, tu):
+	with open(trace_file, "r") as f:
+		trace = json.load(f)
+
+	for event in trace.get("traceEvents", []):
+		if event.get("ph") != "X":
+			continue
+
+		name = event.get("name")
+		seconds = event.get("dur", 0) / 1e6
+		detail = event.get("args", {}).get("detail", "")
+
+		if name == "Source":
+			# Inclusive of the headers it includes, like the MSVC /showIncludes tree
+			tu.headers[header_name(detail)] += seconds
+		elif name in CLANG_INSTANTIATION_EVENTS:
+			tu.templates[template_name(detail)] += seconds
+			tu.instantiations[detail] += seconds
+		elif name == "Total Frontend":
+			tu.phases["frontend"] = seconds
+		elif name == "Total Backend":
+			tu.phases["codegen"] = seconds
+		elif name == "Total InstantiateClass" or name == "Total InstantiateFunction":
+			tu.phases["instantiation"] = tu.phases.get("instantiation", 0.0) + seconds
+		elif name == "Total ExecuteCompiler":
+			tu.phases["total"] = seconds
+
+def compile_unit(compiler, kind, flags, source):
+	obj = os.path.splitext(source)[0] + ".o"
+	command = [compiler] + flags + ["-I" + SRC_DIR, "-c", source, "-o", obj]
+	if kind == CompilerKind.GCC:
+		command.append("-ftime-report")
+	else:
+		command += ["-ftime-trace", "-ftime-trace-granularity=50"]
+
+	start = time.perf_counter()
+	result = subprocess.run(command, stdout=subprocess.PIPE, stderr=subprocess.PIPE, universal_newlines=True)
+	tu = TranslationUnit()
+	tu.wall = time.perf_counter() - start
+
+	if result.returncode != 0:
+		logging.error("Failed to compile %s:\n%s", source, result.stderr)
+		sys.exit(1)
+
+	if kind == CompilerKind.GCC:
+		# -ftime-report goes to stderr
+		tu.phases = parse_time_report(result.stderr)
+	else:
+		parse_time_trace(os.path.splitext(obj)[0] + ".json", tu)
+
+	return tu
+
+class Result:
+	def __init__(self, scenario, compiler, files):
+		self.scenario = scenario
+		self.compiler = compiler
+		self.files = files
+		self.wall = 0.0
+		self.compile_time = 0.0
+		self.phases = collections.Counter()
+		self.headers = collections.Counter()
+		self.templates = collections.Counter()
+		self.instantiations = collections.Counter()
+
+	def add(self, tu):
+		self.compile_time += tu.wall
+		self.phases.update(tu.phases)
+		self.headers.update(tu.headers)
+		self.templates.update(tu.templates)
+		self.instantiations.update(tu.instantiations)
+
+def generate(scenario, files, outdir):
+	if os.path.exists(outdir):
+		shutil.rmtree(outdir)
+	for template in SCENARIOS[scenario]:
+		cobe_generator.generate(os.path.join(COBE_DIR, template), files, outdir)
+
+def run(scenario, compiler, kind, files, args):
+	outdir = os.path.join(args.outdir, os.path.basename(compiler), str(files), scenario)
+	generate(scenario, files, outdir)
+	sources = [os.path.join(outdir, fn) for fn in sorted(os.listdir(outdir)) if fn.endswith(".cpp")]
+	flags = ["-std=" + args.std] + args.flags.split()
+
+	result = Result(scenario, compiler, files)
+	start = time.perf_counter()
+	with concurrent.futures.ThreadPoolExecutor(max_workers=args.jobs) as executor:
+		for tu in executor.map(lambda source: compile_unit(compiler, kind, flags, source), sources):
+			result.add(tu)
+	result.wall = time.perf_counter() - start
+
+	return result
+
+def print_scaling(results):
+	print("")
+	print("%-14s %-10s %6s %10s %10s %12s %10s %10s" % (
+		"scenario", "compiler", "files", "wall [s]", "tu [s]", "per tu [ms]", "parse [s]", "inst [s]"))
+	for r in results:
+		parsing = r.phases.get("parsing", r.phases.get("frontend", 0.0))
+		print("%-14s %-10s %6d %10.2f %10.2f %12.1f %10.2f %10.2f" % (
+			r.scenario, os.path.basename(r.compiler), r.files, r.wall, r.compile_time,
+			r.compile_time / r.files * 1000.0, parsing, r.phases.get("instantiation", 0.0)))
+
+def print_top(title, counter, top):
+	if not counter:
+		return
+	print("  %s" % title)
+	for name, seconds in counter.most_common(top):
+		print("    %10.3f s  %s" % (seconds, name))
+
+def print_breakdown(results, top):
+	# Only the largest file count of every scenario and compiler, the smaller ones are in the CSV
+	largest = collections.OrderedDict()
+	for r in results:
+		key = (r.scenario, r.compiler)
+		if key not in largest or largest[key].files < r.files:
+			largest[key] = r
+
+	for r in largest.values():
+		print("")
+		print("%s, %s, %d files" % (r.scenario, os.path.basename(r.compiler), r.files))
+		for phase in PHASE_ORDER:
+			if phase in r.phases:
+				print("    %10.3f s  %s" % (r.phases[phase], phase))
+		print_top("headers (inclusive)", r.headers, top)
+		print_top("templates", r.templates, top)
+		print_top("instantiations", r.instantiations, top)
+
+def write_csv(results, path):
+	with open(path, "w") as f:
+		f.write("scenario,compiler,files,kind,name,seconds\n")
+		for r in results:
+			prefix = "%s,%s,%d" % (r.scenario, os.path.basename(r.compiler), r.files)
+			f.write("%s,build,wall,%f\n" % (prefix, r.wall))
+			f.write("%s,build,compile_time,%f\n" % (prefix, r.compile_time))
+			for kind, counter in (("phase", r.phases), ("header", r.headers), ("template", r.templates)):
+				for name, seconds in sorted(counter.items()):
+					f.write("%s,%s,\"%s\",%f\n" % (prefix, kind, name, seconds))
+
+def main(args=None):
+	logging.basicConfig(level=logging.INFO)
+
+	parser = argparse.ArgumentParser()
+	parser.add_argument("-o", "--outdir", default=os.path.join(COBE_DIR, "build", "cobe-linux"), help="Output directory")
+	parser.add_argument("-n", "--files", default="10,100,1000", help="Comma separated file counts")
+	parser.add_argument("-s", "--scenarios", default=",".join(SCENARIOS.keys()), help="Comma separated scenarios")
+	parser.add_argument("-c", "--compilers", default="g++,clang++", help="Comma separated compilers, missing ones are skipped")
+	parser.add_argument("-j", "--jobs", type=int, default=os.cpu_count(), help="Parallel compilations, use 1 for stable per-TU times")
+	parser.add_argument("--std", default="c++17", help="C++ standard")
+	parser.add_argument("--flags", default="-O2 -DNDEBUG", help="Extra compiler flags")
+	parser.add_argument("--top", type=int, default=10, help="Number of headers and templates listed")
+
+	args = parser.parse_args(args)
+
+	compilers = [c for c in args.compilers.split(",") if shutil.which(c)]
+	for missing in set(args.compilers.split(",")) - set(compilers):
+		logging.info("%s not found, skipping", missing)
+	if not compilers:
+		logging.error("No compiler found")
+		sys.exit(1)
+
+	for scenario in args.scenarios.split(","):
+		if scenario not in SCENARIOS:
+			logging.error("Unknown scenario '%s', expected one of: %s", scenario, ", ".join(SCENARIOS.keys()))
+			sys.exit(1)
+
+	results = []
+	for compiler in compilers:
+		kind = compiler_kind(compiler)
+		for scenario in args.scenarios.split(","):
+			for files in [int(n) for n in args.files.split(",")]:
+				logging.info("Building %s with %s, %d files", scenario, compiler, files)
+				results.append(run(scenario, compiler, kind, files, args))
+
+	print_scaling(results)
+	print_breakdown(results, args.top)
+
+	csv_path = os.path.join(args.outdir, "report.csv")
+	write_csv(results, csv_path)
+	print("")
+	print("Full report written to %s" % csv_path)
+
+if __name__ == '__main__':
+	main()
@@ -1,6 +1,22 @@
 #!/bin/bash
 
-FILES=10
+# Usage: ./cobe.sh [vs2017|linux] [options]
+#
+# vs2017 (default) generates FILES translation units per scenario and a Visual Studio solution
+# building them. linux builds the scenarios with GCC and Clang for 10 to 1000 files and reports
+# the scaling, header and template instantiation costs, see
+# cobe-generator/cobe_benchmark.py --help for its options.
+
+cd "$(dirname "$0")"
+
+TARGET=${1:-vs2017}
+shift
+
+if [ "$TARGET" = "linux" ]; then
+	exec python3 cobe-generator/cobe_benchmark.py "$@"
+fi
+
+FILES=${FILES:-10}
 
 cobe-generator/cobe_generator.py angle/angle.cpp.cobe angle/angle.h.cobe -o build/cobe/angle -n $FILES
 cobe-generator/cobe_generator.py angle/angle-pch.cpp.cobe angle/angle-pch.h.cobe -o build/cobe/angle-pch -n $FILES
@@ -15,4 +31,4 @@ cobe-generator/cobe_generator.py xform/xform-pch.cpp.cobe xform/xform-pch.h.cobe
 cobe-generator/cobe_generator.py xform/xform-matrix.cpp.cobe xform/xform-matrix.h.cobe -o build/cobe/xform-matrix -n $FILES
 cobe-generator/cobe_generator.py xform/xform-matrix-pch.cpp.cobe xform/xform-matrix-pch.h.cobe -o build/cobe/xform-matrix-pch -n $FILES
 
-../external/premake5.exe --scripts=../premake/ vs2017
+../external/premake5.exe --scripts=../premake/ "$TARGET"
@@ -1,10 +1,12 @@
 #pragma once
 
+#include <cstdint>
 #include <utility>
-#include <iostream>
 
 #include "math.hpp"
 
+// Streaming lives in AngleIO.hpp, so that including the angle doesn't pull in the iostreams.
+
 namespace type_safety {
 
 struct RadiansTag {
@@ -50,6 +52,16 @@ public:
         return radians_;
     }
 
+    // Equivalent angle in [-pi, pi). Branchless, valid for |radians| < 2^31 full turns.
+    constexpr Angle normalized() const {
+        return Angle{radiansTag, reduce(radians_, floorTurns((radians_ + PI) * INV_TWO_PI_), PI)};
+    }
+
+    // Equivalent angle in [0, 2pi). Branchless, valid for |radians| < 2^31 full turns.
+    constexpr Angle wrapped() const {
+        return Angle{radiansTag, reduce(radians_, floorTurns(radians_ * INV_TWO_PI_), TWO_PI_HI_)};
+    }
+
     friend constexpr bool operator==(Angle lhs, Angle rhs) {
         return floatEq(lhs.radians_, rhs.radians_);
     }
@@ -118,15 +130,30 @@ public:
 		return Angle{std::move(a)} /= scalar;
 	}
 
-	friend std::ostream& operator<<(std::ostream& os, Angle a) {
-        return os << a.degrees() << "_deg";
-    }
-
 private:
 
     static constexpr auto DEGREES_TO_RADIANS_ = PI / 180.0f;
     static constexpr auto RADIANS_TO_DEGREES_ = 180.0f / PI;
 
+    // 2pi split into the float nearest to it and the remainder, so that subtracting whole
+    // turns doesn't accumulate the representation error of 2pi.
+    static constexpr auto TWO_PI_HI_ = 6.28318548f;
+    static constexpr auto TWO_PI_LO_ = -1.74845553e-7f;
+    static constexpr auto INV_TWO_PI_ = 0.159154943f;
+
+    static constexpr float floorTurns(float turns) {
+        const auto truncated = static_cast<float>(static_cast<std::int32_t>(turns));
+        return truncated - (turns < truncated ? 1.0f : 0.0f);
+    }
+
+    static constexpr float reduce(float radians, float turns, float upperBound) {
+        const auto result = (radians - turns * TWO_PI_HI_) - turns * TWO_PI_LO_;
+        // Rounding may push the result just past either end of the range
+        const auto lowerBound = upperBound - TWO_PI_HI_;
+        const auto aboveLower = result < lowerBound ? result + TWO_PI_HI_ : result;
+        return aboveLower >= upperBound ? aboveLower - TWO_PI_HI_ : aboveLower;
+    }
+
     float radians_ = 0.0f;
 
 };
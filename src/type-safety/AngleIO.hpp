@@ -0,0 +1,21 @@
+#pragma once
+
+#include <ostream>
+
+#include "Angle.hpp"
+
+namespace type_safety {
+
+template <int BITS>
+class BinaryAngle;
+
+inline std::ostream& operator<<(std::ostream& os, Angle a) {
+	return os << a.degrees() << "_deg";
+}
+
+template <int BITS>
+std::ostream& operator<<(std::ostream& os, BinaryAngle<BITS> a) {
+	return os << a.angle();
+}
+
+} // namespace type_safety
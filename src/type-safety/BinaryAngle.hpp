@@ -0,0 +1,148 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "Angle.hpp"
+#include "math.hpp"
+
+namespace type_safety {
+
+// Angle stored as a fixed-point fraction of a full turn - 2^BITS units make 360 degrees.
+// Arithmetic wraps for free through unsigned overflow, so accumulated rotations never lose
+// precision, and BinaryAngle<16> takes half the storage of Angle.
+template <int BITS>
+class BinaryAngle final {
+public:
+
+	static_assert(BITS == 16 || BITS == 32, "BinaryAngle supports 16 and 32 bit storage");
+
+	using Storage = std::conditional_t<BITS == 16, std::uint16_t, std::uint32_t>;
+	using SignedStorage = std::make_signed_t<Storage>;
+
+	constexpr BinaryAngle() = default;
+
+	constexpr explicit BinaryAngle(Angle a) :
+		value_(fromRadians(a.radians()))
+	{
+	}
+
+	static constexpr BinaryAngle fromRaw(Storage raw) {
+		auto result = BinaryAngle{};
+		result.value_ = raw;
+		return result;
+	}
+
+	constexpr Storage raw() const {
+		return value_;
+	}
+
+	// Angle in [-pi, pi).
+	constexpr Angle angle() const {
+		return Angle{radiansTag, static_cast<float>(static_cast<SignedStorage>(value_)) * RADIANS_PER_UNIT_};
+	}
+
+	// Angle in [0, 2pi).
+	constexpr Angle wrappedAngle() const {
+		return Angle{radiansTag, static_cast<float>(value_) * RADIANS_PER_UNIT_};
+	}
+
+	friend constexpr bool operator==(BinaryAngle lhs, BinaryAngle rhs) {
+		return lhs.value_ == rhs.value_;
+	}
+
+	friend constexpr bool operator!=(BinaryAngle lhs, BinaryAngle rhs) {
+		return lhs.value_ != rhs.value_;
+	}
+
+	constexpr BinaryAngle& operator+=(BinaryAngle other) {
+		value_ = static_cast<Storage>(value_ + other.value_);
+		return *this;
+	}
+
+	friend constexpr BinaryAngle operator+(BinaryAngle lhs, BinaryAngle rhs) {
+		return lhs += rhs;
+	}
+
+	constexpr BinaryAngle& operator-=(BinaryAngle other) {
+		value_ = static_cast<Storage>(value_ - other.value_);
+		return *this;
+	}
+
+	friend constexpr BinaryAngle operator-(BinaryAngle lhs, BinaryAngle rhs) {
+		return lhs -= rhs;
+	}
+
+	friend constexpr BinaryAngle operator-(BinaryAngle a) {
+		return fromRaw(static_cast<Storage>(0u - a.value_));
+	}
+
+private:
+
+	static constexpr auto UNITS_PER_TURN_ = static_cast<double>(std::uint64_t{1} << BITS);
+	static constexpr auto RADIANS_PER_UNIT_ = static_cast<float>(2.0 * 3.14159265358979323846 / UNITS_PER_TURN_);
+	static constexpr auto UNITS_PER_RADIAN_ = UNITS_PER_TURN_ / (2.0 * 3.14159265358979323846);
+
+	static constexpr Storage fromRadians(float radians) {
+		const auto units = static_cast<double>(radians) * UNITS_PER_RADIAN_;
+		const auto rounded = static_cast<std::int64_t>(units + (units < 0.0 ? -0.5 : 0.5));
+		// Conversion to an unsigned type is modulo 2^BITS, which is exactly the wrap we want
+		return static_cast<Storage>(static_cast<std::uint64_t>(rounded));
+	}
+
+	Storage value_ = 0;
+
+};
+
+using BinaryAngle16 = BinaryAngle<16>;
+using BinaryAngle32 = BinaryAngle<32>;
+
+static_assert(sizeof(BinaryAngle16) == sizeof(std::uint16_t));
+static_assert(sizeof(BinaryAngle32) == sizeof(Angle));
+
+namespace detail {
+
+constexpr auto BINARY_ANGLE_TABLE_BITS = 10;
+constexpr auto BINARY_ANGLE_TABLE_SIZE = std::size_t{1} << BINARY_ANGLE_TABLE_BITS;
+
+// One full turn of sine, with a repeated first entry so that interpolation needs no wrap.
+inline const std::array<float, BINARY_ANGLE_TABLE_SIZE + 1>& binaryAngleSinTable() {
+	static const auto table = [] {
+		auto result = std::array<float, BINARY_ANGLE_TABLE_SIZE + 1>{};
+		for (auto i = std::size_t{0}; i <= BINARY_ANGLE_TABLE_SIZE; ++i) {
+			result[i] = static_cast<float>(std::sin(2.0 * 3.14159265358979323846 * i / BINARY_ANGLE_TABLE_SIZE));
+		}
+		return result;
+	}();
+	return table;
+}
+
+template <int BITS>
+inline float tableSin(typename BinaryAngle<BITS>::Storage raw) {
+	constexpr auto FRACTION_BITS = BITS - BINARY_ANGLE_TABLE_BITS;
+	constexpr auto FRACTION_SCALE = 1.0f / static_cast<float>(std::uint64_t{1} << FRACTION_BITS);
+
+	const auto& table = binaryAngleSinTable();
+	const auto index = static_cast<std::size_t>(raw >> FRACTION_BITS);
+	const auto fraction = static_cast<float>(raw & ((std::uint64_t{1} << FRACTION_BITS) - 1u)) * FRACTION_SCALE;
+	return table[index] + (table[index + 1] - table[index]) * fraction;
+}
+
+} // namespace detail
+
+// Table lookup with linear interpolation, max error 5e-6.
+template <int BITS>
+inline float sin(BinaryAngle<BITS> a) {
+	return detail::tableSin<BITS>(a.raw());
+}
+
+template <int BITS>
+inline float cos(BinaryAngle<BITS> a) {
+	constexpr auto QUARTER_TURN = typename BinaryAngle<BITS>::Storage{1} << (BITS - 2);
+	return detail::tableSin<BITS>(static_cast<typename BinaryAngle<BITS>::Storage>(a.raw() + QUARTER_TURN));
+}
+
+} // namespace type_safety
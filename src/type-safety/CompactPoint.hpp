@@ -0,0 +1,283 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "Matrix.hpp"
+#include "Point.hpp"
+#include "VecN.hpp"
+#include "Unit.hpp"
+#include "math.hpp"
+#include "simd.hpp"
+#include "space.hpp"
+
+namespace type_safety {
+
+// Points and vectors stored as x, y and z only - 12 bytes instead of Point's and Vector's 16,
+// w being implied by the type. For arrays streamed through memory, where a quarter of
+// Point's bandwidth goes to a constant. They take the same constructors, vector() returns
+// the full Vec4 by value and xyz() gives access to the stored coordinates. Xform::apply
+// skips the matrix's bottom row for them, and the last column for CompactVectors, and
+// applyAll transforms arrays of them four at a time, with SIMD loads of the packed triples.
+
+namespace detail {
+
+template <class FromUnitT, class ToUnitT>
+inline Vec3 convertVec3(const Vec3& v) {
+	static_assert(FromUnitT::template IS_CONVERTIBLE_TO<ToUnitT>, "Units are not convertible");
+	if constexpr (IS_UNIT_IDENTITY<FromUnitT, ToUnitT>) {
+		return v;
+	} else {
+		return v * FromUnitT{}.template convertTo<ToUnitT>(1.0f);
+	}
+}
+
+inline Vec3 xyz(const Vec4& v) {
+	return Vec3{v.get(0), v.get(1), v.get(2)};
+}
+
+} // namespace detail
+
+template <class SpaceT, class UnitT = Dimensionless>
+class CompactVector : SpaceT {
+public:
+
+	using Space = SpaceT;
+	using Unit = UnitT;
+
+	static constexpr auto W = 0.0f;
+
+	template <class... SpaceParams, class = detail::EnableIfSpaceConstructible<SpaceT, SpaceParams...>>
+	CompactVector(SpaceParams&&... spaceParams) :
+		SpaceT(std::forward<SpaceParams>(spaceParams)...)
+	{
+	}
+
+	template <class... SpaceParams>
+	CompactVector(Vec3 v, SpaceParams&&... spaceParams) :
+		SpaceT(std::forward<SpaceParams>(spaceParams)...),
+		xyz_(std::move(v))
+	{
+	}
+
+	template <class... SpaceParams>
+	CompactVector(const Vec4& v, SpaceParams&&... spaceParams) :
+		SpaceT(std::forward<SpaceParams>(spaceParams)...),
+		xyz_(detail::xyz(v))
+	{
+		assert(floatEq(v.get(3), 0.0f));
+	}
+
+	template <class CompatibleUnitT>
+	CompactVector(const CompactVector<SpaceT, CompatibleUnitT>& compatibleVector) :
+		SpaceT(compatibleVector.space()),
+		xyz_(detail::convertVec3<CompatibleUnitT, UnitT>(compatibleVector.xyz()))
+	{
+	}
+
+	explicit CompactVector(const Vector<SpaceT, UnitT>& v) :
+		SpaceT(v.space()),
+		xyz_(detail::xyz(v.vector()))
+	{
+	}
+
+	decltype(auto) space() const {
+		if constexpr (std::is_empty_v<SpaceT>) {
+			return SpaceT{};
+		} else {
+			return static_cast<const SpaceT&>(*this);
+		}
+	}
+
+	Vec3& xyz() {
+		return xyz_;
+	}
+
+	const Vec3& xyz() const {
+		return xyz_;
+	}
+
+	Vec4 vector() const {
+		return Vec4{xyz_, W};
+	}
+
+	template <class CompatibleUnitT>
+	Vec4 vector() const {
+		return Vec4{detail::convertVec3<UnitT, CompatibleUnitT>(xyz_), W};
+	}
+
+	Vector<SpaceT, UnitT> expanded() const {
+		return Vector<SpaceT, UnitT>{xyz_, space()};
+	}
+
+private:
+
+	Vec3 xyz_;
+
+};
+
+template <class SpaceT, class UnitT = Dimensionless>
+class CompactPoint : SpaceT {
+public:
+
+	using Space = SpaceT;
+	using Unit = UnitT;
+
+	static constexpr auto W = 1.0f;
+
+	template <class... SpaceParams, class = detail::EnableIfSpaceConstructible<SpaceT, SpaceParams...>>
+	CompactPoint(SpaceParams&&... spaceParams) :
+		SpaceT(std::forward<SpaceParams>(spaceParams)...)
+	{
+	}
+
+	template <class... SpaceParams>
+	CompactPoint(Vec3 v, SpaceParams&&... spaceParams) :
+		SpaceT(std::forward<SpaceParams>(spaceParams)...),
+		xyz_(std::move(v))
+	{
+	}
+
+	template <class... SpaceParams>
+	CompactPoint(const Vec4& v, SpaceParams&&... spaceParams) :
+		SpaceT(std::forward<SpaceParams>(spaceParams)...),
+		xyz_(detail::xyz(v))
+	{
+		assert(floatEq(v.get(3), 1.0f));
+	}
+
+	template <class CompatibleUnitT>
+	CompactPoint(const CompactPoint<SpaceT, CompatibleUnitT>& compatiblePoint) :
+		SpaceT(compatiblePoint.space()),
+		xyz_(detail::convertVec3<CompatibleUnitT, UnitT>(compatiblePoint.xyz()))
+	{
+	}
+
+	explicit CompactPoint(const Point<SpaceT, UnitT>& p) :
+		SpaceT(p.space()),
+		xyz_(detail::xyz(p.vector()))
+	{
+	}
+
+	decltype(auto) space() const {
+		if constexpr (std::is_empty_v<SpaceT>) {
+			return SpaceT{};
+		} else {
+			return static_cast<const SpaceT&>(*this);
+		}
+	}
+
+	Vec3& xyz() {
+		return xyz_;
+	}
+
+	const Vec3& xyz() const {
+		return xyz_;
+	}
+
+	Vec4 vector() const {
+		return Vec4{xyz_, W};
+	}
+
+	template <class CompatibleUnitT>
+	Vec4 vector() const {
+		return Vec4{detail::convertVec3<UnitT, CompatibleUnitT>(xyz_), W};
+	}
+
+	Point<SpaceT, UnitT> expanded() const {
+		return Point<SpaceT, UnitT>{xyz_, space()};
+	}
+
+private:
+
+	Vec3 xyz_;
+
+};
+
+// Arrays of these may be read as packed floats.
+static_assert(sizeof(CompactPoint<space::World>) == 3 * sizeof(float));
+static_assert(sizeof(CompactVector<space::World>) == 3 * sizeof(float));
+static_assert(std::is_trivially_copyable_v<CompactPoint<space::World>>);
+
+// Arithmetic follows Point.hpp's: mixed units yield the unit of the left-hand side, or of
+// the point.
+
+template <class SpaceT, class LhsUnitT, class RhsUnitT>
+inline CompactVector<SpaceT, LhsUnitT> operator+(const CompactVector<SpaceT, LhsUnitT>& lhs, const CompactVector<SpaceT, RhsUnitT>& rhs) {
+	checkSpacesMatch(lhs.space(), rhs.space());
+	return CompactVector<SpaceT, LhsUnitT>{lhs.xyz() + detail::convertVec3<RhsUnitT, LhsUnitT>(rhs.xyz()), lhs.space()};
+}
+
+template <class SpaceT, class LhsUnitT, class RhsUnitT>
+inline CompactVector<SpaceT, LhsUnitT> operator-(const CompactVector<SpaceT, LhsUnitT>& lhs, const CompactVector<SpaceT, RhsUnitT>& rhs) {
+	checkSpacesMatch(lhs.space(), rhs.space());
+	return CompactVector<SpaceT, LhsUnitT>{lhs.xyz() - detail::convertVec3<RhsUnitT, LhsUnitT>(rhs.xyz()), lhs.space()};
+}
+
+template <class SpaceT, class UnitT>
+inline CompactVector<SpaceT, UnitT> operator*(const CompactVector<SpaceT, UnitT>& v, float scalar) {
+	return CompactVector<SpaceT, UnitT>{v.xyz() * scalar, v.space()};
+}
+
+template <class SpaceT, class UnitT>
+inline CompactVector<SpaceT, UnitT> operator*(float scalar, const CompactVector<SpaceT, UnitT>& v) {
+	return v * scalar;
+}
+
+template <class SpaceT, class UnitT>
+inline CompactVector<SpaceT, UnitT> operator/(const CompactVector<SpaceT, UnitT>& v, float scalar) {
+	return CompactVector<SpaceT, UnitT>{v.xyz() / scalar, v.space()};
+}
+
+template <class SpaceT, class LhsUnitT, class RhsUnitT>
+inline CompactVector<SpaceT, LhsUnitT> operator-(const CompactPoint<SpaceT, LhsUnitT>& lhs, const CompactPoint<SpaceT, RhsUnitT>& rhs) {
+	checkSpacesMatch(lhs.space(), rhs.space());
+	return CompactVector<SpaceT, LhsUnitT>{lhs.xyz() - detail::convertVec3<RhsUnitT, LhsUnitT>(rhs.xyz()), lhs.space()};
+}
+
+template <class SpaceT, class PointUnitT, class VectorUnitT>
+inline CompactPoint<SpaceT, PointUnitT> operator+(const CompactPoint<SpaceT, PointUnitT>& lhs, const CompactVector<SpaceT, VectorUnitT>& rhs) {
+	checkSpacesMatch(lhs.space(), rhs.space());
+	return CompactPoint<SpaceT, PointUnitT>{lhs.xyz() + detail::convertVec3<VectorUnitT, PointUnitT>(rhs.xyz()), lhs.space()};
+}
+
+template <class SpaceT, class PointUnitT, class VectorUnitT>
+inline CompactPoint<SpaceT, PointUnitT> operator-(const CompactPoint<SpaceT, PointUnitT>& lhs, const CompactVector<SpaceT, VectorUnitT>& rhs) {
+	checkSpacesMatch(lhs.space(), rhs.space());
+	return CompactPoint<SpaceT, PointUnitT>{lhs.xyz() - detail::convertVec3<VectorUnitT, PointUnitT>(rhs.xyz()), lhs.space()};
+}
+
+namespace detail {
+
+// target[i] = matrix * (source[i], w) for count packed xyz triples, w being 1 for points and 0
+// for vectors. source and target may be the same array.
+inline void multiplyAffinePacked(const Matrix& matrix, float w, const float* source, std::size_t count, float* target) {
+	auto i = std::size_t{0};
+	for (; i + simd::LANES <= count; i += simd::LANES) {
+		auto x = simd::Float4{};
+		auto y = simd::Float4{};
+		auto z = simd::Float4{};
+		simd::loadInterleaved3(source + 3 * i, x, y, z);
+		const auto row = [&](std::size_t r) {
+			return
+				x * simd::Float4{matrix.get(r, 0)} +
+				y * simd::Float4{matrix.get(r, 1)} +
+				z * simd::Float4{matrix.get(r, 2)} +
+				simd::Float4{matrix.get(r, 3) * w};
+		};
+		simd::storeInterleaved3(row(0), row(1), row(2), target + 3 * i);
+	}
+	for (; i < count; ++i) {
+		auto result = Vec3{};
+		multiplyAffineAndSet(result, matrix, Vec3{source[3 * i], source[3 * i + 1], source[3 * i + 2]}, w);
+		for (auto coordinate = 0u; coordinate < 3u; ++coordinate) {
+			target[3 * i + coordinate] = result.get(coordinate);
+		}
+	}
+}
+
+} // namespace detail
+
+} // namespace type_safety
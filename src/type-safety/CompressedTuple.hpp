@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace type_safety {
+
+namespace detail {
+
+// Only the non-empty members of a CompressedTuple are stored, in a plain recursive aggregate,
+// so nothing relies on the compiler applying the empty base optimisation to several bases.
+template <class... Ts>
+struct TupleStorage;
+
+template <>
+struct TupleStorage<> {
+};
+
+template <class HeadT>
+struct TupleStorage<HeadT> {
+
+	constexpr TupleStorage() = default;
+
+	constexpr explicit TupleStorage(HeadT headValue) :
+		head(std::move(headValue))
+	{
+	}
+
+	HeadT head;
+
+};
+
+template <class HeadT, class... TailTs>
+struct TupleStorage<HeadT, TailTs...> {
+
+	constexpr TupleStorage() = default;
+
+	constexpr TupleStorage(HeadT headValue, TailTs... tailValues) :
+		head(std::move(headValue)),
+		tail(std::move(tailValues)...)
+	{
+	}
+
+	HeadT head;
+
+	TupleStorage<TailTs...> tail;
+
+};
+
+template <class T>
+constexpr auto keepIfNonEmpty([[maybe_unused]] T value) {
+	if constexpr (std::is_empty_v<T>) {
+		return std::tuple<>{};
+	} else {
+		return std::tuple<T>{std::move(value)};
+	}
+}
+
+template <class TupleT>
+struct TupleStorageOf;
+
+template <class... Ts>
+struct TupleStorageOf<std::tuple<Ts...>> {
+	using type = TupleStorage<Ts...>;
+};
+
+template <class... Ts>
+using NonEmptyTupleStorage =
+	typename TupleStorageOf<decltype(std::tuple_cat(keepIfNonEmpty(std::declval<Ts>())...))>::type;
+
+template <std::size_t INDEX, class... Ts>
+constexpr auto STORAGE_INDEX = std::size_t{0};
+
+template <std::size_t INDEX, class HeadT, class... TailTs>
+constexpr auto STORAGE_INDEX<INDEX, HeadT, TailTs...> = INDEX == 0 ?
+	std::size_t{0} :
+	STORAGE_INDEX<INDEX - 1, TailTs...> + (std::is_empty_v<HeadT> ? 0 : 1);
+
+template <class TypesT, class ArgsT, class = void>
+constexpr auto TUPLE_CONSTRUCTIBLE = false;
+
+template <class... Ts, class... Us>
+constexpr auto TUPLE_CONSTRUCTIBLE<std::tuple<Ts...>, std::tuple<Us...>, std::enable_if_t<sizeof...(Ts) == sizeof...(Us)>> =
+	(std::is_constructible_v<Ts, Us&&> && ...);
+
+template <std::size_t INDEX, class StorageT>
+constexpr auto& storageGet(StorageT& storage) {
+	if constexpr (INDEX == 0) {
+		return storage.head;
+	} else {
+		return storageGet<INDEX - 1>(storage.tail);
+	}
+}
+
+} // namespace detail
+
+// Tuple in which empty members take no space - they are default constructed on access
+// instead of being stored. Trivially copyable if all its members are, so arrays of types
+// built on top of it may be relocated with memcpy.
+template <class... Ts>
+class CompressedTuple : detail::NonEmptyTupleStorage<Ts...> {
+public:
+
+	template <std::size_t INDEX>
+	using Element = std::tuple_element_t<INDEX, std::tuple<Ts...>>;
+
+	constexpr CompressedTuple() = default;
+
+	template <
+		class... Us,
+		class = std::enable_if_t<sizeof...(Us) != 0 && detail::TUPLE_CONSTRUCTIBLE<std::tuple<Ts...>, std::tuple<Us...>>>
+		>
+	constexpr CompressedTuple(Us&&... values) :
+		Storage(std::make_from_tuple<Storage>(std::tuple_cat(detail::keepIfNonEmpty<Ts>(std::forward<Us>(values))...)))
+	{
+	}
+
+	template <std::size_t INDEX>
+	constexpr decltype(auto) get() const {
+		if constexpr (std::is_empty_v<Element<INDEX>>) {
+			return Element<INDEX>{};
+		} else {
+			return detail::storageGet<detail::STORAGE_INDEX<INDEX, Ts...>>(static_cast<const Storage&>(*this));
+		}
+	}
+
+	template <std::size_t INDEX>
+	constexpr decltype(auto) get() {
+		if constexpr (std::is_empty_v<Element<INDEX>>) {
+			return Element<INDEX>{};
+		} else {
+			return detail::storageGet<detail::STORAGE_INDEX<INDEX, Ts...>>(static_cast<Storage&>(*this));
+		}
+	}
+
+private:
+
+	using Storage = detail::NonEmptyTupleStorage<Ts...>;
+
+};
+
+} // namespace type_safety
@@ -0,0 +1,476 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+
+#include "Unit.hpp"
+#include "simd.hpp"
+
+namespace type_safety {
+
+// Units known only at run time - read from scripts, configs or file headers. A DynamicUnit is
+// the run-time image of a detail::Unit: the exponent of every dimension and the factor to SI
+// base units. Samples are best kept as DynamicColumns, validated and promoted to statically
+// typed values once per column, rather than as DynamicValues checked on every operation:
+//
+//   auto column = DynamicColumn{samples.data(), samples.size(), *unitFromSymbol(header.unit)};
+//   if (const auto distances = column.promote<Metres>()) {
+//       integrate(*distances); // ValueSpan<Metres>, viewing samples
+//   } else if (const auto converted = column.convertTo<Metres>(scratch.data())) {
+//       integrate(*converted); // ValueSpan<Metres>, viewing scratch
+//   }
+class DynamicUnit {
+public:
+
+	using Exponents = std::array<std::int8_t, DIMENSION_COUNT>;
+
+	constexpr DynamicUnit() :
+		exponents_{},
+		tableIndex_(NOT_TABULATED),
+		scale_(1.0f)
+	{
+	}
+
+	constexpr DynamicUnit(Exponents exponents, float scale) :
+		exponents_(exponents),
+		tableIndex_(NOT_TABULATED),
+		scale_(scale)
+	{
+	}
+
+	template <class UnitT>
+	static constexpr DynamicUnit of();
+
+	constexpr int exponent(Dimension dimension) const {
+		return exponents_[static_cast<std::size_t>(dimension)];
+	}
+
+	constexpr const Exponents& exponents() const {
+		return exponents_;
+	}
+
+	// Factor converting the unit to SI base units.
+	constexpr float scale() const {
+		return scale_;
+	}
+
+	constexpr bool isConvertibleTo(const DynamicUnit& other) const {
+		for (auto i = std::size_t{0}; i < DIMENSION_COUNT; ++i) {
+			if (exponents_[i] != other.exponents_[i]) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template <class UnitT>
+	constexpr bool isConvertibleTo() const {
+		return isConvertibleTo(of<UnitT>());
+	}
+
+	// Factor converting values of this unit to the other, which must be convertible. Looked up
+	// in a precomputed table when both units have a symbol, see unitFromSymbol.
+	constexpr float conversionFactorTo(const DynamicUnit& other) const;
+
+	friend constexpr bool operator==(const DynamicUnit& lhs, const DynamicUnit& rhs) {
+		// Scales of products are rounded differently from the static unit's, so compare them
+		// relative to their size
+		const auto difference = lhs.scale_ - rhs.scale_;
+		const auto tolerance = lhs.scale_ * SCALE_EPSILON;
+		return lhs.isConvertibleTo(rhs) && difference <= tolerance && -difference <= tolerance;
+	}
+
+	friend constexpr bool operator!=(const DynamicUnit& lhs, const DynamicUnit& rhs) {
+		return !(lhs == rhs);
+	}
+
+	friend constexpr DynamicUnit operator*(const DynamicUnit& lhs, const DynamicUnit& rhs) {
+		auto exponents = Exponents{};
+		for (auto i = std::size_t{0}; i < DIMENSION_COUNT; ++i) {
+			exponents[i] = static_cast<std::int8_t>(lhs.exponents_[i] + rhs.exponents_[i]);
+		}
+		return DynamicUnit{exponents, lhs.scale_ * rhs.scale_};
+	}
+
+	friend constexpr DynamicUnit operator/(const DynamicUnit& lhs, const DynamicUnit& rhs) {
+		auto exponents = Exponents{};
+		for (auto i = std::size_t{0}; i < DIMENSION_COUNT; ++i) {
+			exponents[i] = static_cast<std::int8_t>(lhs.exponents_[i] - rhs.exponents_[i]);
+		}
+		return DynamicUnit{exponents, lhs.scale_ / rhs.scale_};
+	}
+
+	friend std::optional<DynamicUnit> unitFromSymbol(std::string_view symbol);
+
+private:
+
+	static constexpr auto SCALE_EPSILON = 1e-6f;
+
+	static constexpr auto NOT_TABULATED = std::uint8_t{0xff};
+
+	Exponents exponents_;
+
+	// Row and column of the unit in the conversion table, in what would otherwise be padding
+	std::uint8_t tableIndex_;
+
+	float scale_;
+
+	constexpr DynamicUnit(Exponents exponents, float scale, std::size_t tableIndex) :
+		exponents_(exponents),
+		tableIndex_(static_cast<std::uint8_t>(tableIndex)),
+		scale_(scale)
+	{
+	}
+
+};
+
+static_assert(sizeof(DynamicUnit) == 12);
+
+namespace detail {
+
+template <class UnitT>
+constexpr DynamicUnit untabulatedDynamicUnit() {
+	return DynamicUnit{
+		{
+			static_cast<std::int8_t>(UnitT::template EXPONENT<Dimension::LENGTH>),
+			static_cast<std::int8_t>(UnitT::template EXPONENT<Dimension::MASS>),
+			static_cast<std::int8_t>(UnitT::template EXPONENT<Dimension::TIME>),
+			static_cast<std::int8_t>(UnitT::template EXPONENT<Dimension::CURRENT>),
+			static_cast<std::int8_t>(UnitT::template EXPONENT<Dimension::TEMPERATURE>),
+		},
+		static_cast<float>(UnitT::Scale::num) / static_cast<float>(UnitT::Scale::den)
+	};
+}
+
+struct UnitSymbol {
+	std::string_view symbol;
+	DynamicUnit unit;
+};
+
+// The suffixes UnitIO.hpp prints, without the underscore.
+constexpr UnitSymbol UNIT_SYMBOLS[] = {
+	{ "", untabulatedDynamicUnit<Dimensionless>() },
+	{ "m", untabulatedDynamicUnit<Metres>() },
+	{ "km", untabulatedDynamicUnit<Kilometres>() },
+	{ "mm", untabulatedDynamicUnit<Milimetres>() },
+	{ "kg", untabulatedDynamicUnit<Kilograms>() },
+	{ "g", untabulatedDynamicUnit<Grams>() },
+	{ "ns", untabulatedDynamicUnit<Nanoseconds>() },
+	{ "us", untabulatedDynamicUnit<Microseconds>() },
+	{ "ms", untabulatedDynamicUnit<Milliseconds>() },
+	{ "s", untabulatedDynamicUnit<Seconds>() },
+	{ "min", untabulatedDynamicUnit<Minutes>() },
+	{ "h", untabulatedDynamicUnit<Hours>() },
+	{ "A", untabulatedDynamicUnit<Amperes>() },
+	{ "K", untabulatedDynamicUnit<Kelvins>() },
+	{ "m/s", untabulatedDynamicUnit<MPS>() },
+	{ "km/h", untabulatedDynamicUnit<KPH>() },
+	{ "m/s2", untabulatedDynamicUnit<MPS2>() },
+	{ "N", untabulatedDynamicUnit<Newtons>() },
+	{ "J", untabulatedDynamicUnit<Joules>() },
+};
+
+constexpr auto UNIT_SYMBOL_COUNT = std::size(UNIT_SYMBOLS);
+
+// UNIT_SYMBOL_COUNT if the unit has no symbol. Exact, as the table and the unit were scaled alike.
+constexpr std::size_t unitSymbolIndex(const DynamicUnit& unit) {
+	for (auto i = std::size_t{0}; i < UNIT_SYMBOL_COUNT; ++i) {
+		const auto& entry = UNIT_SYMBOLS[i].unit;
+		if (entry.isConvertibleTo(unit) && entry.scale() == unit.scale()) {
+			return i;
+		}
+	}
+	return UNIT_SYMBOL_COUNT;
+}
+
+using ConversionTable = std::array<std::array<float, UNIT_SYMBOL_COUNT>, UNIT_SYMBOL_COUNT>;
+
+constexpr ConversionTable makeConversionTable() {
+	auto table = ConversionTable{};
+	for (auto from = std::size_t{0}; from < UNIT_SYMBOL_COUNT; ++from) {
+		for (auto to = std::size_t{0}; to < UNIT_SYMBOL_COUNT; ++to) {
+			table[from][to] = UNIT_SYMBOLS[from].unit.scale() / UNIT_SYMBOLS[to].unit.scale();
+		}
+	}
+	return table;
+}
+
+// Factors between every pair of units with a symbol. Entries for units of different dimensions
+// are never read.
+constexpr ConversionTable CONVERSION_TABLE = makeConversionTable();
+
+} // namespace detail
+
+template <class UnitT>
+constexpr DynamicUnit DynamicUnit::of() {
+	constexpr auto untabulated = detail::untabulatedDynamicUnit<UnitT>();
+	constexpr auto tableIndex = detail::unitSymbolIndex(untabulated);
+	if constexpr (tableIndex == detail::UNIT_SYMBOL_COUNT) {
+		return untabulated;
+	} else {
+		return DynamicUnit{untabulated.exponents_, untabulated.scale_, tableIndex};
+	}
+}
+
+constexpr float DynamicUnit::conversionFactorTo(const DynamicUnit& other) const {
+	if (tableIndex_ != NOT_TABULATED && other.tableIndex_ != NOT_TABULATED) {
+		return detail::CONVERSION_TABLE[tableIndex_][other.tableIndex_];
+	}
+	return scale_ / other.scale_;
+}
+
+inline std::optional<DynamicUnit> unitFromSymbol(std::string_view symbol) {
+	for (auto i = std::size_t{0}; i < detail::UNIT_SYMBOL_COUNT; ++i) {
+		const auto& entry = detail::UNIT_SYMBOLS[i];
+		if (entry.symbol == symbol) {
+			return DynamicUnit{entry.unit.exponents_, entry.unit.scale_, i};
+		}
+	}
+	return std::nullopt;
+}
+
+// A value with a run-time unit. Operations check dimensions on every call and throw
+// std::runtime_error on a mismatch - fine for a handful of script inputs, see DynamicColumn for
+// bulk data.
+class DynamicValue {
+public:
+
+	constexpr DynamicValue() :
+		value_(0.0f)
+	{
+	}
+
+	constexpr DynamicValue(float value, DynamicUnit unit) :
+		unit_(unit),
+		value_(value)
+	{
+	}
+
+	template <class UnitT>
+	constexpr DynamicValue(Value<UnitT> value) :
+		unit_(DynamicUnit::of<UnitT>()),
+		value_(value.template value<UnitT>())
+	{
+	}
+
+	constexpr const DynamicUnit& unit() const {
+		return unit_;
+	}
+
+	// The value in its own unit.
+	constexpr float value() const {
+		return value_;
+	}
+
+	float value(const DynamicUnit& unit) const {
+		checkConvertible(unit);
+		return value_ * unit_.conversionFactorTo(unit);
+	}
+
+	template <class UnitT>
+	std::optional<Value<UnitT>> as() const {
+		if (!unit_.isConvertibleTo<UnitT>()) {
+			return std::nullopt;
+		}
+		return makeValue<UnitT>(value_ * unit_.conversionFactorTo(DynamicUnit::of<UnitT>()));
+	}
+
+	DynamicValue& operator+=(const DynamicValue& other) {
+		value_ += other.value(unit_);
+		return *this;
+	}
+
+	DynamicValue& operator-=(const DynamicValue& other) {
+		value_ -= other.value(unit_);
+		return *this;
+	}
+
+	friend DynamicValue operator+(DynamicValue lhs, const DynamicValue& rhs) {
+		lhs += rhs;
+		return lhs;
+	}
+
+	friend DynamicValue operator-(DynamicValue lhs, const DynamicValue& rhs) {
+		lhs -= rhs;
+		return lhs;
+	}
+
+	friend constexpr DynamicValue operator*(const DynamicValue& lhs, const DynamicValue& rhs) {
+		return DynamicValue{lhs.value_ * rhs.value_, lhs.unit_ * rhs.unit_};
+	}
+
+	friend constexpr DynamicValue operator/(const DynamicValue& lhs, const DynamicValue& rhs) {
+		return DynamicValue{lhs.value_ / rhs.value_, lhs.unit_ / rhs.unit_};
+	}
+
+	friend constexpr DynamicValue operator*(const DynamicValue& v, float scalar) {
+		return DynamicValue{v.value_ * scalar, v.unit_};
+	}
+
+	friend constexpr DynamicValue operator*(float scalar, const DynamicValue& v) {
+		return DynamicValue{v.value_ * scalar, v.unit_};
+	}
+
+	friend bool operator==(const DynamicValue& lhs, const DynamicValue& rhs) {
+		return floatEq(lhs.value_, rhs.value(lhs.unit_));
+	}
+
+	friend bool operator!=(const DynamicValue& lhs, const DynamicValue& rhs) {
+		return !(lhs == rhs);
+	}
+
+	friend bool operator<(const DynamicValue& lhs, const DynamicValue& rhs) {
+		return floatLT(lhs.value_, rhs.value(lhs.unit_));
+	}
+
+	friend bool operator<=(const DynamicValue& lhs, const DynamicValue& rhs) {
+		return floatLE(lhs.value_, rhs.value(lhs.unit_));
+	}
+
+	friend bool operator>(const DynamicValue& lhs, const DynamicValue& rhs) {
+		return floatGT(lhs.value_, rhs.value(lhs.unit_));
+	}
+
+	friend bool operator>=(const DynamicValue& lhs, const DynamicValue& rhs) {
+		return floatGE(lhs.value_, rhs.value(lhs.unit_));
+	}
+
+private:
+
+	DynamicUnit unit_;
+
+	float value_;
+
+	void checkConvertible(const DynamicUnit& unit) const {
+		if (!unit_.isConvertibleTo(unit)) {
+			throw std::runtime_error("Run-time dimensions don't match");
+		}
+	}
+
+};
+
+static_assert(sizeof(DynamicValue) == 16);
+
+// Contiguous values of a statically known unit, viewing memory owned elsewhere.
+template <class UnitT>
+class ValueSpan {
+public:
+
+	using Unit = UnitT;
+
+	constexpr ValueSpan(Value<UnitT>* data, std::size_t size) :
+		data_(data),
+		size_(size)
+	{
+	}
+
+	constexpr Value<UnitT>* data() const {
+		return data_;
+	}
+
+	constexpr std::size_t size() const {
+		return size_;
+	}
+
+	constexpr Value<UnitT>& operator[](std::size_t index) const {
+		return data_[index];
+	}
+
+	constexpr Value<UnitT>* begin() const {
+		return data_;
+	}
+
+	constexpr Value<UnitT>* end() const {
+		return data_ + size_;
+	}
+
+private:
+
+	Value<UnitT>* data_;
+
+	std::size_t size_;
+
+};
+
+// Raw floats sharing one run-time unit, e.g. a column read from a file. The unit is checked
+// once for the whole column: promote hands the floats back as statically typed values without
+// copying them if the column is already in the static unit, convertTo writes them rescaled to
+// another buffer if it is not. Neither modifies the column.
+class DynamicColumn {
+public:
+
+	DynamicColumn(float* data, std::size_t size, DynamicUnit unit) :
+		data_(data),
+		size_(size),
+		unit_(unit)
+	{
+	}
+
+	float* data() const {
+		return data_;
+	}
+
+	std::size_t size() const {
+		return size_;
+	}
+
+	const DynamicUnit& unit() const {
+		return unit_;
+	}
+
+	DynamicValue operator[](std::size_t index) const {
+		return DynamicValue{data_[index], unit_};
+	}
+
+	// Views the column as Value<UnitT>s, or nullopt unless the column is in UnitT. A column in
+	// a differently scaled unit, e.g. kilometres for Metres, has to be converted with convertTo.
+	template <class UnitT>
+	std::optional<ValueSpan<UnitT>> promote() const {
+		static_assert(sizeof(Value<UnitT>) == sizeof(float) && std::is_standard_layout_v<Value<UnitT>>);
+
+		if (unit_ != DynamicUnit::of<UnitT>()) {
+			return std::nullopt;
+		}
+		return ValueSpan<UnitT>{reinterpret_cast<Value<UnitT>*>(data_), size_};
+	}
+
+	// Writes the column in UnitT to destination, which must have room for size() values, and
+	// views them, or returns nullopt if the dimensions differ. One multiplication per sample.
+	template <class UnitT>
+	std::optional<ValueSpan<UnitT>> convertTo(Value<UnitT>* destination) const {
+		static_assert(sizeof(Value<UnitT>) == sizeof(float) && std::is_standard_layout_v<Value<UnitT>>);
+
+		if (!unit_.isConvertibleTo<UnitT>()) {
+			return std::nullopt;
+		}
+
+		auto* const result = reinterpret_cast<float*>(destination);
+		const auto factor = unit_.conversionFactorTo(DynamicUnit::of<UnitT>());
+		auto i = std::size_t{0};
+		for (; i + simd::WIDE_LANES <= size_; i += simd::WIDE_LANES) {
+			(simd::WideFloat::load(data_ + i) * simd::WideFloat{factor}).store(result + i);
+		}
+		for (; i < size_; ++i) {
+			result[i] = data_[i] * factor;
+		}
+
+		return ValueSpan<UnitT>{destination, size_};
+	}
+
+private:
+
+	float* data_;
+
+	std::size_t size_;
+
+	DynamicUnit unit_;
+
+};
+
+} // namespace type_safety
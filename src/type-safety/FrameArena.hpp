@@ -0,0 +1,240 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <vector>
+
+#include "config.hpp"
+
+#if !defined(NDEBUG) && !defined(TYPE_SAFETY_ARENA_POISON)
+#	define TYPE_SAFETY_ARENA_POISON
+#endif /* !NDEBUG && !TYPE_SAFETY_ARENA_POISON */
+
+namespace type_safety {
+
+// Storage for the Xforms, Matrices and Points built and thrown away within a frame:
+//
+//   arena.reset(); // at the start of the frame
+//   auto xforms = FrameVector<PlayerToWorld>(ArenaAllocator<PlayerToWorld>{arena});
+//   auto points = std::pmr::vector<WorldPoint>{&arena};
+//
+// Allocation bumps a pointer, deallocation does nothing and reset rewinds to the start in O(1),
+// keeping the blocks for the next frame, so a steady state frame neither calls the global
+// allocator nor touches new pages. Every allocation is aligned to at least ALIGNMENT, enough
+// for aligned SIMD loads of Matrix rows and keeping separate containers off shared cache lines.
+//
+// Allocations not fitting the current block go to the next one, a new block of blockSize
+// bytes or, if larger, a block of their own, rounded up to whole multiples of ALIGNMENT.
+//
+// With TYPE_SAFETY_ARENA_POISON, defined unless NDEBUG is, everything released by reset is
+// overwritten with POISON_BYTE, so use after reset reads garbage floats rather than stale ones.
+// Poisoning makes reset O(bytes used). Deallocations are not poisoned: a container destroyed
+// after reset deallocates memory the next frame may already be using.
+class FrameArena : public std::pmr::memory_resource {
+public:
+
+	static constexpr auto ALIGNMENT = CACHE_LINE_SIZE;
+
+	static constexpr auto POISON_BYTE = std::byte{0xdd};
+
+	static constexpr auto DEFAULT_BLOCK_SIZE = std::size_t{1024 * 1024};
+
+	// blockSize is rounded up to a multiple of ALIGNMENT.
+	explicit FrameArena(std::size_t blockSize = DEFAULT_BLOCK_SIZE) :
+		blockSize_(roundUp(blockSize))
+	{
+	}
+
+	FrameArena(const FrameArena&) = delete;
+
+	FrameArena& operator=(const FrameArena&) = delete;
+
+	// The non-virtual allocation function memory_resource::allocate and ArenaAllocator both end
+	// up in.
+	void* allocateBytes(std::size_t bytes, std::size_t alignment = ALIGNMENT) {
+		alignment = std::max(alignment, ALIGNMENT);
+		assert((alignment & (alignment - 1)) == 0);
+
+		// Aligning may step past the end of the block, where the difference would wrap around
+		auto* result = alignUp(cursor_, alignment);
+		if (result == nullptr || result > end_ || bytes > static_cast<std::size_t>(end_ - result)) {
+			result = nextBlock(bytes, alignment);
+		}
+		cursor_ = result + bytes;
+		bytesUsed_ += bytes;
+		return result;
+	}
+
+	// Does nothing, the memory is freed by reset.
+	void deallocateBytes([[maybe_unused]] void* p, [[maybe_unused]] std::size_t bytes) {
+	}
+
+	// Frees everything allocated since the last reset. Containers still referring to the
+	// arena must not be used afterwards, except to be destroyed, which leaves the memory
+	// alone.
+	void reset() {
+#ifdef TYPE_SAFETY_ARENA_POISON
+		for (auto block = std::size_t{0}; block < blocks_.size() && block <= currentBlock_; ++block) {
+			auto* begin = blocks_[block].data.get();
+			auto* end = block == currentBlock_ ? cursor_ : begin + blocks_[block].size;
+			std::memset(begin, static_cast<int>(POISON_BYTE), static_cast<std::size_t>(end - begin));
+		}
+#endif /* TYPE_SAFETY_ARENA_POISON */
+		currentBlock_ = 0;
+		cursor_ = blocks_.empty() ? nullptr : blocks_.front().data.get();
+		end_ = blocks_.empty() ? nullptr : cursor_ + blocks_.front().size;
+		bytesUsed_ = 0;
+	}
+
+	// Bytes requested since the last reset, without alignment padding.
+	std::size_t bytesUsed() const {
+		return bytesUsed_;
+	}
+
+	// Bytes held in blocks, used or not.
+	std::size_t capacity() const {
+		auto result = std::size_t{0};
+		for (const auto& block : blocks_) {
+			result += block.size;
+		}
+		return result;
+	}
+
+	std::size_t blockCount() const {
+		return blocks_.size();
+	}
+
+protected:
+
+	void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+		return allocateBytes(bytes, alignment);
+	}
+
+	void do_deallocate(void* p, std::size_t bytes, std::size_t /* alignment */) override {
+		deallocateBytes(p, bytes);
+	}
+
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+		return this == &other;
+	}
+
+private:
+
+	struct BlockDeleter {
+		void operator()(std::byte* data) const {
+			::operator delete(data, std::align_val_t{ALIGNMENT});
+		}
+	};
+
+	struct Block {
+		std::unique_ptr<std::byte[], BlockDeleter> data;
+		std::size_t size;
+	};
+
+	std::size_t blockSize_;
+
+	std::vector<Block> blocks_;
+
+	std::size_t currentBlock_ = 0;
+
+	std::byte* cursor_ = nullptr;
+
+	std::byte* end_ = nullptr;
+
+	std::size_t bytesUsed_ = 0;
+
+	static std::size_t roundUp(std::size_t bytes) {
+		return (bytes + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+	}
+
+	static std::byte* alignUp(std::byte* p, std::size_t alignment) {
+		const auto address = reinterpret_cast<std::uintptr_t>(p);
+		return p + (((address + alignment - 1) & ~(alignment - 1)) - address);
+	}
+
+	// Slow path: moves on to the first following block fitting the allocation, adding one if
+	// there is none, and returns the allocation's start.
+	std::byte* nextBlock(std::size_t bytes, std::size_t alignment) {
+		// Blocks start ALIGNMENT aligned, so only larger alignments need padding
+		const auto padded = bytes + (alignment - ALIGNMENT);
+
+		auto block = blocks_.empty() ? std::size_t{0} : currentBlock_ + 1;
+		while (block < blocks_.size() && blocks_[block].size < padded) {
+			++block;
+		}
+		if (block == blocks_.size()) {
+			// Whole cache lines, so that aligning the cursor never leaves a block
+			const auto size = std::max(blockSize_, roundUp(padded));
+			blocks_.push_back(Block{
+				std::unique_ptr<std::byte[], BlockDeleter>{
+					static_cast<std::byte*>(::operator new(size, std::align_val_t{ALIGNMENT}))
+					},
+				size
+				});
+		}
+
+		currentBlock_ = block;
+		end_ = blocks_[block].data.get() + blocks_[block].size;
+		return alignUp(blocks_[block].data.get(), alignment);
+	}
+
+};
+
+// A standard allocator drawing from a FrameArena. Calls bypass memory_resource's virtual
+// functions, so the bump inlines into the container's growth path, unlike with
+// std::pmr::polymorphic_allocator.
+template <class T>
+class ArenaAllocator {
+public:
+
+	using value_type = T;
+
+	explicit ArenaAllocator(FrameArena& arena) :
+		arena_(&arena)
+	{
+	}
+
+	template <class U>
+	ArenaAllocator(const ArenaAllocator<U>& other) :
+		arena_(&other.arena())
+	{
+	}
+
+	T* allocate(std::size_t count) {
+		return static_cast<T*>(arena_->allocateBytes(count * sizeof(T), alignof(T)));
+	}
+
+	void deallocate(T* p, std::size_t count) {
+		arena_->deallocateBytes(p, count * sizeof(T));
+	}
+
+	FrameArena& arena() const {
+		return *arena_;
+	}
+
+	template <class U>
+	friend bool operator==(const ArenaAllocator& lhs, const ArenaAllocator<U>& rhs) {
+		return &lhs.arena() == &rhs.arena();
+	}
+
+	template <class U>
+	friend bool operator!=(const ArenaAllocator& lhs, const ArenaAllocator<U>& rhs) {
+		return !(lhs == rhs);
+	}
+
+private:
+
+	FrameArena* arena_;
+
+};
+
+template <class T>
+using FrameVector = std::vector<T, ArenaAllocator<T>>;
+
+} // namespace type_safety
@@ -9,6 +9,16 @@ namespace type_safety {
 class Matrix {
 public:
 
+	static Matrix identity() {
+		auto result = Matrix{};
+		for (auto row = 0u; row < 4u; ++row) {
+			for (auto col = 0u; col < 4u; ++col) {
+				result.elements_[index(row, col)] = row == col ? 1.0f : 0.0f;
+			}
+		}
+		return result;
+	}
+
 	friend void multiplyAndSet(Matrix& result, const Matrix& lhs, const Matrix& rhs) {
 		for (auto row = 0u; row < 4u; ++row) {
 			for (auto col = 0u; col < 4u; ++col) {
@@ -31,6 +41,62 @@ public:
 		}
 	}
 
+	// lhs * (rhs, w) for affine matrices, skipping the bottom row and, for w == 0 (known at
+	// compile time once inlined), the last column.
+	friend void multiplyAffineAndSet(Vec3& result, const Matrix& lhs, const Vec3& rhs, float w) {
+		for (auto row = 0u; row < 3u; ++row) {
+			auto value = lhs.get(row, 3) * w;
+			for (auto col = 0u; col < 3u; ++col) {
+				value += lhs.get(row, col) * rhs.get(col);
+			}
+			result.get(row) = value;
+		}
+	}
+
+	// lhs * rhs for affine matrices, skipping the bottom row, which is rhs's (0, 0, 0, 1).
+	friend void multiplyAffineAndSet(Matrix& result, const Matrix& lhs, const Matrix& rhs) {
+		for (auto row = 0u; row < 3u; ++row) {
+			for (auto col = 0u; col < 4u; ++col) {
+				auto value = 0.0f;
+				for (auto dot = 0u; dot < 4u; ++dot) {
+					value += lhs.elements_[index(row, dot)] * rhs.elements_[index(dot, col)];
+				}
+				result.elements_[index(row, col)] = value;
+			}
+		}
+		for (auto col = 0u; col < 4u; ++col) {
+			result.elements_[index(3, col)] = rhs.elements_[index(3, col)];
+		}
+	}
+
+	// lhs * rhs for affine lhs, w being passed through.
+	friend void multiplyAffineAndSet(Vec4& result, const Matrix& lhs, const Vec4& rhs) {
+		for (auto row = 0u; row < 3u; ++row) {
+			auto value = 0.0f;
+			for (auto col = 0u; col < 4u; ++col) {
+				value += lhs.get(row, col) * rhs.get(col);
+			}
+			result.get(row) = value;
+		}
+		result.get(3) = rhs.get(3);
+	}
+
+	// lhs * rhs for pure translations, which add up.
+	friend void multiplyTranslationsAndSet(Matrix& result, const Matrix& lhs, const Matrix& rhs) {
+		result = rhs;
+		for (auto row = 0u; row < 3u; ++row) {
+			result.elements_[index(row, 3)] += lhs.elements_[index(row, 3)];
+		}
+	}
+
+	// lhs * rhs for a pure translation lhs.
+	friend void multiplyTranslationAndSet(Vec4& result, const Matrix& lhs, const Vec4& rhs) {
+		for (auto row = 0u; row < 3u; ++row) {
+			result.get(row) = rhs.get(row) + lhs.get(row, 3) * rhs.get(3);
+		}
+		result.get(3) = rhs.get(3);
+	}
+
 	friend Matrix operator*(const Matrix& lhs, const Matrix& rhs) {
 		auto result = Matrix{};
 		multiplyAndSet(result, lhs, rhs);
@@ -0,0 +1,232 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#if defined(__linux__)
+#	define TYPE_SAFETY_PERF_EVENTS
+#	include <cstring>
+#	include <linux/perf_event.h>
+#	include <sys/ioctl.h>
+#	include <sys/syscall.h>
+#	include <unistd.h>
+#endif /* __linux__ */
+
+namespace type_safety {
+
+// Hardware performance counters of the calling thread, read through perf_event_open on Linux.
+// Every event is opened on its own, so a missing one (no PMU in a container or VM,
+// perf_event_paranoid too strict, other platforms) only leaves its value empty - nothing
+// throws and no event affects the others. Counts exclude the kernel and are scaled when the
+// kernel had to multiplex the counters.
+enum class PerfEvent {
+	CYCLES,
+	INSTRUCTIONS,
+	L1D_MISSES,
+	LLC_MISSES,
+	BRANCH_MISSES,
+};
+
+constexpr auto PERF_EVENT_COUNT = std::size_t{5};
+
+class PerfSample {
+public:
+
+	std::optional<double>& operator[](PerfEvent event) {
+		return values_[static_cast<std::size_t>(event)];
+	}
+
+	const std::optional<double>& operator[](PerfEvent event) const {
+		return values_[static_cast<std::size_t>(event)];
+	}
+
+	// Instructions per cycle.
+	std::optional<double> ipc() const {
+		const auto& cycles = (*this)[PerfEvent::CYCLES];
+		const auto& instructions = (*this)[PerfEvent::INSTRUCTIONS];
+		if (!cycles || !instructions || *cycles <= 0.0) {
+			return std::nullopt;
+		}
+		return *instructions / *cycles;
+	}
+
+private:
+
+	std::array<std::optional<double>, PERF_EVENT_COUNT> values_;
+
+};
+
+class PerfCounters {
+public:
+
+	PerfCounters() {
+#ifdef TYPE_SAFETY_PERF_EVENTS
+		for (auto i = 0u; i < PERF_EVENT_COUNT; ++i) {
+			descriptors_[i] = open(static_cast<PerfEvent>(i));
+		}
+#endif /* TYPE_SAFETY_PERF_EVENTS */
+	}
+
+	PerfCounters(const PerfCounters&) = delete;
+
+	PerfCounters& operator=(const PerfCounters&) = delete;
+
+	~PerfCounters() {
+#ifdef TYPE_SAFETY_PERF_EVENTS
+		for (const auto descriptor : descriptors_) {
+			if (descriptor >= 0) {
+				::close(descriptor);
+			}
+		}
+#endif /* TYPE_SAFETY_PERF_EVENTS */
+	}
+
+	bool available(PerfEvent event) const {
+		return descriptors_[static_cast<std::size_t>(event)] >= 0;
+	}
+
+	// True if at least one event could be opened.
+	bool available() const {
+		for (const auto descriptor : descriptors_) {
+			if (descriptor >= 0) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// Resets and starts all counters.
+	void start() {
+#ifdef TYPE_SAFETY_PERF_EVENTS
+		for (const auto descriptor : descriptors_) {
+			if (descriptor >= 0) {
+				::ioctl(descriptor, PERF_EVENT_IOC_RESET, 0);
+				::ioctl(descriptor, PERF_EVENT_IOC_ENABLE, 0);
+			}
+		}
+#endif /* TYPE_SAFETY_PERF_EVENTS */
+	}
+
+	void stop() {
+#ifdef TYPE_SAFETY_PERF_EVENTS
+		for (const auto descriptor : descriptors_) {
+			if (descriptor >= 0) {
+				::ioctl(descriptor, PERF_EVENT_IOC_DISABLE, 0);
+			}
+		}
+#endif /* TYPE_SAFETY_PERF_EVENTS */
+	}
+
+	// Counts since the last start().
+	PerfSample read() const {
+		auto result = PerfSample{};
+#ifdef TYPE_SAFETY_PERF_EVENTS
+		for (auto i = 0u; i < PERF_EVENT_COUNT; ++i) {
+			if (descriptors_[i] < 0) {
+				continue;
+			}
+
+			// Layout selected by PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING
+			std::uint64_t data[3] = {};
+			if (::read(descriptors_[i], data, sizeof(data)) != static_cast<ssize_t>(sizeof(data))) {
+				continue;
+			}
+
+			const auto [value, enabled, running] = data;
+			if (running == 0) {
+				result[static_cast<PerfEvent>(i)] = (enabled == 0) ? 0.0 : static_cast<double>(value);
+			} else {
+				result[static_cast<PerfEvent>(i)] =
+					static_cast<double>(value) * static_cast<double>(enabled) / static_cast<double>(running);
+			}
+		}
+#endif /* TYPE_SAFETY_PERF_EVENTS */
+		return result;
+	}
+
+private:
+
+	std::array<int, PERF_EVENT_COUNT> descriptors_ = { -1, -1, -1, -1, -1 };
+
+#ifdef TYPE_SAFETY_PERF_EVENTS
+	static int open(PerfEvent event) {
+		auto attributes = perf_event_attr{};
+		std::memset(&attributes, 0, sizeof(attributes));
+		attributes.size = sizeof(attributes);
+		attributes.disabled = 1;
+		attributes.exclude_kernel = 1;
+		attributes.exclude_hv = 1;
+		attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+		switch (event) {
+		case PerfEvent::CYCLES:
+			attributes.type = PERF_TYPE_HARDWARE;
+			attributes.config = PERF_COUNT_HW_CPU_CYCLES;
+			break;
+		case PerfEvent::INSTRUCTIONS:
+			attributes.type = PERF_TYPE_HARDWARE;
+			attributes.config = PERF_COUNT_HW_INSTRUCTIONS;
+			break;
+		case PerfEvent::L1D_MISSES:
+			attributes.type = PERF_TYPE_HW_CACHE;
+			attributes.config = PERF_COUNT_HW_CACHE_L1D
+				| (PERF_COUNT_HW_CACHE_OP_READ << 8)
+				| (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+			break;
+		case PerfEvent::LLC_MISSES:
+			attributes.type = PERF_TYPE_HW_CACHE;
+			attributes.config = PERF_COUNT_HW_CACHE_LL
+				| (PERF_COUNT_HW_CACHE_OP_READ << 8)
+				| (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+			break;
+		case PerfEvent::BRANCH_MISSES:
+			attributes.type = PERF_TYPE_HARDWARE;
+			attributes.config = PERF_COUNT_HW_BRANCH_MISSES;
+			break;
+		}
+
+		// This thread, any cpu, no group
+		return static_cast<int>(::syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+	}
+#endif /* TYPE_SAFETY_PERF_EVENTS */
+
+};
+
+// Counts the events of its own lifetime into the given sample:
+//
+//   auto sample = PerfSample{};
+//   {
+//       const auto probe = ScopedPerfProbe{counters, sample};
+//       integrate(positions, velocities, dt);
+//   }
+//   log(*sample.ipc());
+class ScopedPerfProbe {
+public:
+
+	ScopedPerfProbe(PerfCounters& counters, PerfSample& sample) :
+		counters_(counters),
+		sample_(sample)
+	{
+		counters_.start();
+	}
+
+	ScopedPerfProbe(const ScopedPerfProbe&) = delete;
+
+	ScopedPerfProbe& operator=(const ScopedPerfProbe&) = delete;
+
+	~ScopedPerfProbe() {
+		counters_.stop();
+		sample_ = counters_.read();
+	}
+
+private:
+
+	PerfCounters& counters_;
+
+	PerfSample& sample_;
+
+};
+
+} // namespace type_safety
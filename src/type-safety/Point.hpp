@@ -1,20 +1,59 @@
 #pragma once
 
+#include <cassert>
 #include <type_traits>
 
 #include "VecN.hpp"
+#include "Unit.hpp"
 #include "math.hpp"
+#include "space.hpp"
 
 namespace type_safety {
 
 template <class FromSpaceT, class ToSpaceT>
 class Xform;
 
-template <class SpaceT>
+namespace detail {
+
+template <class SpaceT, class... SpaceParams>
+using EnableIfSpaceConstructible = std::enable_if_t<std::is_constructible_v<SpaceT, SpaceParams&&...>>;
+
+template <class FromUnitT, class ToUnitT>
+constexpr bool IS_UNIT_IDENTITY = FromUnitT::template IS_IDENTITY_CONVERSION_TO<ToUnitT>;
+
+// Converts a direction (w == 0) - all components are scaled by a single compile-time factor.
+template <class FromUnitT, class ToUnitT>
+inline Vec4 convertDirection(Vec4 v) {
+	static_assert(FromUnitT::template IS_CONVERTIBLE_TO<ToUnitT>, "Vector units are not convertible");
+	if constexpr (IS_UNIT_IDENTITY<FromUnitT, ToUnitT>) {
+		return v;
+	} else {
+		return v * FromUnitT{}.template convertTo<ToUnitT>(1.0f);
+	}
+}
+
+// Converts a position (w == 1) - x, y and z are scaled, w is left untouched.
+template <class FromUnitT, class ToUnitT>
+inline Vec4 convertPosition(Vec4 v) {
+	static_assert(FromUnitT::template IS_CONVERTIBLE_TO<ToUnitT>, "Point units are not convertible");
+	if constexpr (IS_UNIT_IDENTITY<FromUnitT, ToUnitT>) {
+		return v;
+	} else {
+		constexpr auto factor = FromUnitT{}.template convertTo<ToUnitT>(1.0f);
+		return Vec4{v.get(0) * factor, v.get(1) * factor, v.get(2) * factor, v.get(3)};
+	}
+}
+
+} // namespace detail
+
+template <class SpaceT, class UnitT = Dimensionless>
 class Vector : SpaceT {
 public:
 
-	template <class... SpaceParams>
+	using Space = SpaceT;
+	using Unit = UnitT;
+
+	template <class... SpaceParams, class = detail::EnableIfSpaceConstructible<SpaceT, SpaceParams...>>
 	Vector(SpaceParams&&... spaceParams) :
 		SpaceT(std::forward<SpaceParams>(spaceParams)...)
 	{
@@ -35,6 +74,13 @@ public:
 		assert(floatEq(v.get(3), 0.0f));
 	}
 
+	template <class CompatibleUnitT>
+	Vector(const Vector<SpaceT, CompatibleUnitT>& compatibleVector) :
+		SpaceT(compatibleVector.space()),
+		vector_(detail::convertDirection<CompatibleUnitT, UnitT>(compatibleVector.vector()))
+	{
+	}
+
 	decltype(auto) space() const {
 		if constexpr (std::is_empty_v<SpaceT>) {
 			return SpaceT{};
@@ -51,17 +97,25 @@ public:
 		return vector_;
 	}
 
+	template <class CompatibleUnitT>
+	Vec4 vector() const {
+		return detail::convertDirection<UnitT, CompatibleUnitT>(vector_);
+	}
+
 private:
 
 	Vec4 vector_;
 
 };
 
-template <class SpaceT>
+template <class SpaceT, class UnitT = Dimensionless>
 class Point : SpaceT {
 public:
 
-	template <class... SpaceParams>
+	using Space = SpaceT;
+	using Unit = UnitT;
+
+	template <class... SpaceParams, class = detail::EnableIfSpaceConstructible<SpaceT, SpaceParams...>>
 	Point(SpaceParams&&... spaceParams) :
 		SpaceT(std::forward<SpaceParams>(spaceParams)...)
 	{
@@ -82,6 +136,13 @@ public:
 		assert(floatEq(v.get(3), 1.0f));
 	}
 
+	template <class CompatibleUnitT>
+	Point(const Point<SpaceT, CompatibleUnitT>& compatiblePoint) :
+		SpaceT(compatiblePoint.space()),
+		vector_(detail::convertPosition<CompatibleUnitT, UnitT>(compatiblePoint.vector()))
+	{
+	}
+
 	decltype(auto) space() const {
 		if constexpr (std::is_empty_v<SpaceT>) {
 			return SpaceT{};
@@ -98,40 +159,123 @@ public:
 		return vector_;
 	}
 
+	template <class CompatibleUnitT>
+	Vec4 vector() const {
+		return detail::convertPosition<UnitT, CompatibleUnitT>(vector_);
+	}
+
 private:
 
 	Vec4 vector_;
 
 };
 
+// Directed physical quantities. Plain Value<UnitT> has no direction, so these are the types
+// to use for e.g. velocities and forces acting in a given space.
+template <class SpaceT>
+using Position = Point<SpaceT, Metres>;
+
 template <class SpaceT>
-inline Vector<SpaceT> operator+(const Vector<SpaceT>& lhs, const Vector<SpaceT>& rhs) {
+using Displacement = Vector<SpaceT, Metres>;
+
+template <class SpaceT>
+using Velocity = Vector<SpaceT, MPS>;
+
+template <class SpaceT>
+using AccelerationVector = Vector<SpaceT, MPS2>;
+
+template <class SpaceT>
+using ForceVector = Vector<SpaceT, Newtons>;
+
+// Mixed-unit arithmetic yields the unit of the left-hand side (or of the Point, when adding
+// a Vector to a Point). The right-hand side is converted with a single scale, which is folded
+// at compile time. Adding vectors of incompatible dimensions doesn't compile.
+
+template <class SpaceT, class LhsUnitT, class RhsUnitT>
+inline Vector<SpaceT, LhsUnitT> operator+(const Vector<SpaceT, LhsUnitT>& lhs, const Vector<SpaceT, RhsUnitT>& rhs) {
 	checkSpacesMatch(lhs.space(), rhs.space());
-	return Vector<SpaceT>{lhs.vector() + rhs.vector(), space()};
+	return Vector<SpaceT, LhsUnitT>{
+		lhs.vector() + detail::convertDirection<RhsUnitT, LhsUnitT>(rhs.vector()),
+		lhs.space()
+		};
 }
 
-template <class SpaceT>
-inline Vector<SpaceT> operator-(const Vector<SpaceT>& lhs, const Vector<SpaceT>& rhs) {
+template <class SpaceT, class LhsUnitT, class RhsUnitT>
+inline Vector<SpaceT, LhsUnitT> operator-(const Vector<SpaceT, LhsUnitT>& lhs, const Vector<SpaceT, RhsUnitT>& rhs) {
 	checkSpacesMatch(lhs.space(), rhs.space());
-	return Vector<SpaceT>{lhs.vector() - rhs.vector(), space()};
+	return Vector<SpaceT, LhsUnitT>{
+		lhs.vector() - detail::convertDirection<RhsUnitT, LhsUnitT>(rhs.vector()),
+		lhs.space()
+		};
 }
 
-template <class SpaceT>
-inline Vector<SpaceT> operator-(const Point<SpaceT>& lhs, const Point<SpaceT>& rhs) {
+template <class SpaceT, class UnitT>
+inline Vector<SpaceT, UnitT> operator-(const Vector<SpaceT, UnitT>& v) {
+	return Vector<SpaceT, UnitT>{v.vector() * -1.0f, v.space()};
+}
+
+template <class SpaceT, class UnitT>
+inline Vector<SpaceT, UnitT> operator*(const Vector<SpaceT, UnitT>& v, float scalar) {
+	return Vector<SpaceT, UnitT>{v.vector() * scalar, v.space()};
+}
+
+template <class SpaceT, class UnitT>
+inline Vector<SpaceT, UnitT> operator*(float scalar, const Vector<SpaceT, UnitT>& v) {
+	return Vector<SpaceT, UnitT>{v.vector() * scalar, v.space()};
+}
+
+template <class SpaceT, class UnitT>
+inline Vector<SpaceT, UnitT> operator/(const Vector<SpaceT, UnitT>& v, float scalar) {
+	return Vector<SpaceT, UnitT>{v.vector() / scalar, v.space()};
+}
+
+template <class SpaceT, class UnitT, class ValueUnitT>
+inline auto operator*(const Vector<SpaceT, UnitT>& v, Value<ValueUnitT> value) {
+	using UnitProduct = decltype(UnitT{} * ValueUnitT{});
+	return Vector<SpaceT, UnitProduct>{v.vector() * value.template value<ValueUnitT>(), v.space()};
+}
+
+template <class SpaceT, class UnitT, class ValueUnitT>
+inline auto operator*(Value<ValueUnitT> value, const Vector<SpaceT, UnitT>& v) {
+	return v * value;
+}
+
+template <class SpaceT, class UnitT, class ValueUnitT>
+inline auto operator/(const Vector<SpaceT, UnitT>& v, Value<ValueUnitT> value) {
+	using UnitQuotient = decltype(UnitT{} / ValueUnitT{});
+	return Vector<SpaceT, UnitQuotient>{v.vector() / value.template value<ValueUnitT>(), v.space()};
+}
+
+template <class SpaceT, class LhsUnitT, class RhsUnitT>
+inline Vector<SpaceT, LhsUnitT> operator-(const Point<SpaceT, LhsUnitT>& lhs, const Point<SpaceT, RhsUnitT>& rhs) {
 	checkSpacesMatch(lhs.space(), rhs.space());
-	return Vector<SpaceT>{lhs.vector_ - rhs.vector_, space()};
+	return Vector<SpaceT, LhsUnitT>{
+		lhs.vector() - detail::convertPosition<RhsUnitT, LhsUnitT>(rhs.vector()),
+		lhs.space()
+		};
 }
 
-template <class SpaceT>
-inline Point<SpaceT> operator+(const Point<SpaceT>& lhs, const Vector<SpaceT>& rhs) {
+template <class SpaceT, class PointUnitT, class VectorUnitT>
+inline Point<SpaceT, PointUnitT> operator+(const Point<SpaceT, PointUnitT>& lhs, const Vector<SpaceT, VectorUnitT>& rhs) {
 	checkSpacesMatch(lhs.space(), rhs.space());
-	return Point<SpaceT>{lhs.vector() + rhs.vector(), space()};
+	return Point<SpaceT, PointUnitT>{
+		lhs.vector() + detail::convertDirection<VectorUnitT, PointUnitT>(rhs.vector()),
+		lhs.space()
+		};
 }
 
-template <class SpaceT>
-inline Point<SpaceT> operator+(const Vector<SpaceT>& lhs, const Point<SpaceT>& rhs) {
+template <class SpaceT, class VectorUnitT, class PointUnitT>
+inline Point<SpaceT, PointUnitT> operator+(const Vector<SpaceT, VectorUnitT>& lhs, const Point<SpaceT, PointUnitT>& rhs) {
+	return rhs + lhs;
+}
+
+template <class SpaceT, class PointUnitT, class VectorUnitT>
+inline Point<SpaceT, PointUnitT> operator-(const Point<SpaceT, PointUnitT>& lhs, const Vector<SpaceT, VectorUnitT>& rhs) {
 	checkSpacesMatch(lhs.space(), rhs.space());
-	return Point<SpaceT>{lhs.vector() + rhs.vector(), space()};
+	return Point<SpaceT, PointUnitT>{
+		lhs.vector() - detail::convertDirection<VectorUnitT, PointUnitT>(rhs.vector()),
+		lhs.space()
+		};
 }
 
 } // namespace type_safety
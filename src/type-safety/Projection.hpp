@@ -0,0 +1,298 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "Angle.hpp"
+#include "CompactPoint.hpp"
+#include "Matrix.hpp"
+#include "Point.hpp"
+#include "StructuredXform.hpp"
+#include "VecN.hpp"
+#include "Xform.hpp"
+#include "simd.hpp"
+#include "space.hpp"
+#include "trigonometry.hpp"
+
+namespace type_safety {
+
+// The camera-to-screen path:
+//
+//   const auto projection = makePerspectiveXform(fieldOfView, aspectRatio, 0.1f, 100.0f);
+//   const auto viewport = makeViewportXform(0.0f, 0.0f, 1920.0f, 1080.0f);
+//   const auto clip = projection.apply(cameraPoint); // a HomogeneousPoint<space::Clip, Metres>
+//   const auto screen = viewport.apply(perspectiveDivide(clip)); // a Point<space::Screen>
+//
+// A projection leaves w != 1, which Point asserts against, so ProjectiveXforms yield
+// HomogeneousPoints, and only perspectiveDivide turns those back into Points, in NDC space.
+// projectAll does all three steps for arrays of CompactPoints, folding the viewport into the
+// projection matrix and dividing with simd::reciprocal four points at a time.
+//
+// The conventions are OpenGL's: the camera looks down -z with y up, and NDC z runs from -1 on
+// the near plane to 1 on the far plane. No clipping is done - points at or behind the camera
+// plane (w <= 0) must be culled beforehand.
+
+// A point in homogeneous coordinates, w being arbitrary.
+template <class SpaceT, class UnitT = Dimensionless>
+class HomogeneousPoint : SpaceT {
+public:
+
+	using Space = SpaceT;
+	using Unit = UnitT;
+
+	template <class... SpaceParams, class = detail::EnableIfSpaceConstructible<SpaceT, SpaceParams...>>
+	HomogeneousPoint(SpaceParams&&... spaceParams) :
+		SpaceT(std::forward<SpaceParams>(spaceParams)...)
+	{
+	}
+
+	template <class... SpaceParams>
+	HomogeneousPoint(Vec4 v, SpaceParams&&... spaceParams) :
+		SpaceT(std::forward<SpaceParams>(spaceParams)...),
+		vector_(std::move(v))
+	{
+	}
+
+	decltype(auto) space() const {
+		if constexpr (std::is_empty_v<SpaceT>) {
+			return SpaceT{};
+		} else {
+			return static_cast<const SpaceT&>(*this);
+		}
+	}
+
+	Vec4& vector() {
+		return vector_;
+	}
+
+	const Vec4& vector() const {
+		return vector_;
+	}
+
+private:
+
+	Vec4 vector_;
+
+};
+
+// The projected coordinates are dimensionless, the unit only records what the input was in.
+template <class UnitT>
+inline Point<space::NDC> perspectiveDivide(const HomogeneousPoint<space::Clip, UnitT>& p) {
+	const auto& v = p.vector();
+	const auto inverseW = 1.0f / v.get(3);
+	return Point<space::NDC>{Vec4{v.get(0) * inverseW, v.get(1) * inverseW, v.get(2) * inverseW, 1.0f}};
+}
+
+// An xform with an arbitrary bottom row. Points are transformed into HomogeneousPoints and
+// vectors, which a projection doesn't map to vectors, are not accepted.
+template <class FromSpaceT, class ToSpaceT = space::Clip>
+class ProjectiveXform : public Xform<FromSpaceT, ToSpaceT> {
+public:
+
+	template <class... SpaceParams>
+	ProjectiveXform(Matrix matrix, SpaceParams&&... spaceParams) :
+		Xform<FromSpaceT, ToSpaceT>(std::move(matrix), std::forward<SpaceParams>(spaceParams)...)
+	{
+	}
+
+	explicit ProjectiveXform(const Xform<FromSpaceT, ToSpaceT>& xform) :
+		Xform<FromSpaceT, ToSpaceT>(xform)
+	{
+	}
+
+	template <class UnitT>
+	HomogeneousPoint<ToSpaceT, UnitT> apply(const Point<FromSpaceT, UnitT>& p) const {
+		checkSpacesMatch(this->fromSpace(), p.space());
+		auto result = HomogeneousPoint<ToSpaceT, UnitT>{this->toSpace()};
+		multiplyAndSet(result.vector(), this->matrix(), p.vector());
+		return result;
+	}
+
+	template <class UnitT>
+	HomogeneousPoint<ToSpaceT, UnitT> apply(const CompactPoint<FromSpaceT, UnitT>& p) const {
+		checkSpacesMatch(this->fromSpace(), p.space());
+		auto result = HomogeneousPoint<ToSpaceT, UnitT>{this->toSpace()};
+		multiplyAndSet(result.vector(), this->matrix(), p.vector());
+		return result;
+	}
+
+};
+
+static_assert(sizeof(ProjectiveXform<space::Camera>) == sizeof(Matrix));
+
+// Model-view-projection chains stay projective.
+template <class LhsFromSpaceT, class LhsToSpaceT, class RhsFromSpaceT, class RhsToSpaceT>
+inline ProjectiveXform<LhsFromSpaceT, RhsToSpaceT> inSequence(
+	const Xform<LhsFromSpaceT, LhsToSpaceT>& lhs,
+	const ProjectiveXform<RhsFromSpaceT, RhsToSpaceT>& rhs
+) {
+	checkSpacesMatch(lhs.toSpace(), rhs.fromSpace());
+	auto matrix = Matrix{};
+	multiplyAndSet(matrix, rhs.matrix(), lhs.matrix());
+	return ProjectiveXform<LhsFromSpaceT, RhsToSpaceT>{std::move(matrix), lhs.fromSpace(), rhs.toSpace()};
+}
+
+namespace detail {
+
+// The x, y and w rows of a symmetric perspective projection, the z row left zero.
+inline Matrix perspectiveFrustum(Angle verticalFieldOfView, float aspectRatio) {
+	assert(verticalFieldOfView.radians() > 0.0f && verticalFieldOfView.radians() < PI);
+	assert(aspectRatio > 0.0f);
+
+	const auto [sine, cosine] = sincos<TrigPrecision::ACCURATE>(Angle{radiansTag, verticalFieldOfView.radians() * 0.5f});
+	const auto focalLength = cosine / sine;
+
+	auto matrix = Matrix{};
+	for (auto row = 0u; row < 4u; ++row) {
+		for (auto column = 0u; column < 4u; ++column) {
+			matrix.get(row, column) = 0.0f;
+		}
+	}
+	matrix.get(0, 0) = focalLength / aspectRatio;
+	matrix.get(1, 1) = focalLength;
+	matrix.get(3, 2) = -1.0f;
+	return matrix;
+}
+
+} // namespace detail
+
+// aspectRatio is width / height. Distances are in the unit of the projected points.
+template <class FromSpaceT = space::Camera>
+inline ProjectiveXform<FromSpaceT> makePerspectiveXform(
+	Angle verticalFieldOfView,
+	float aspectRatio,
+	float nearDistance,
+	float farDistance,
+	FromSpaceT fromSpace = FromSpaceT{}
+) {
+	assert(nearDistance > 0.0f && farDistance > nearDistance);
+	auto matrix = detail::perspectiveFrustum(verticalFieldOfView, aspectRatio);
+	matrix.get(2, 2) = (farDistance + nearDistance) / (nearDistance - farDistance);
+	matrix.get(2, 3) = 2.0f * farDistance * nearDistance / (nearDistance - farDistance);
+	return ProjectiveXform<FromSpaceT>{std::move(matrix), std::move(fromSpace), space::Clip{}};
+}
+
+// makePerspectiveXform's limit for an infinitely distant far plane, which NDC z approaches 1 for.
+template <class FromSpaceT = space::Camera>
+inline ProjectiveXform<FromSpaceT> makeInfinitePerspectiveXform(
+	Angle verticalFieldOfView,
+	float aspectRatio,
+	float nearDistance,
+	FromSpaceT fromSpace = FromSpaceT{}
+) {
+	assert(nearDistance > 0.0f);
+	auto matrix = detail::perspectiveFrustum(verticalFieldOfView, aspectRatio);
+	matrix.get(2, 2) = -1.0f;
+	matrix.get(2, 3) = -2.0f * nearDistance;
+	return ProjectiveXform<FromSpaceT>{std::move(matrix), std::move(fromSpace), space::Clip{}};
+}
+
+// Maps the box [left, right] x [bottom, top] x [-farDistance, -nearDistance] to the NDC cube,
+// leaving w == 1.
+template <class FromSpaceT = space::Camera>
+inline ProjectiveXform<FromSpaceT> makeOrthographicXform(
+	float left,
+	float right,
+	float bottom,
+	float top,
+	float nearDistance,
+	float farDistance,
+	FromSpaceT fromSpace = FromSpaceT{}
+) {
+	assert(right != left && top != bottom && farDistance != nearDistance);
+	auto matrix = Matrix::identity();
+	matrix.get(0, 0) = 2.0f / (right - left);
+	matrix.get(0, 3) = -(right + left) / (right - left);
+	matrix.get(1, 1) = 2.0f / (top - bottom);
+	matrix.get(1, 3) = -(top + bottom) / (top - bottom);
+	matrix.get(2, 2) = -2.0f / (farDistance - nearDistance);
+	matrix.get(2, 3) = -(farDistance + nearDistance) / (farDistance - nearDistance);
+	return ProjectiveXform<FromSpaceT>{std::move(matrix), std::move(fromSpace), space::Clip{}};
+}
+
+// NDC to the pixel rectangle at (x, y) of the given size, NDC y = 1 mapping to the top row y,
+// and NDC z to [minDepth, maxDepth].
+inline AffineXform<space::NDC, space::Screen> makeViewportXform(
+	float x,
+	float y,
+	float width,
+	float height,
+	float minDepth = 0.0f,
+	float maxDepth = 1.0f
+) {
+	auto matrix = Matrix::identity();
+	matrix.get(0, 0) = 0.5f * width;
+	matrix.get(0, 3) = x + 0.5f * width;
+	matrix.get(1, 1) = -0.5f * height;
+	matrix.get(1, 3) = y + 0.5f * height;
+	matrix.get(2, 2) = 0.5f * (maxDepth - minDepth);
+	matrix.get(2, 3) = 0.5f * (maxDepth + minDepth);
+	return AffineXform<space::NDC, space::Screen>{std::move(matrix)};
+}
+
+namespace detail {
+
+// target[i] = divide(matrix * (source[i], 1)) for count packed xyz triples. source and target
+// may be the same array.
+inline void projectPacked(const Matrix& matrix, const float* source, std::size_t count, float* target) {
+	auto i = std::size_t{0};
+	for (; i + simd::LANES <= count; i += simd::LANES) {
+		auto x = simd::Float4{};
+		auto y = simd::Float4{};
+		auto z = simd::Float4{};
+		simd::loadInterleaved3(source + 3 * i, x, y, z);
+		const auto row = [&](std::size_t r) {
+			return
+				x * simd::Float4{matrix.get(r, 0)} +
+				y * simd::Float4{matrix.get(r, 1)} +
+				z * simd::Float4{matrix.get(r, 2)} +
+				simd::Float4{matrix.get(r, 3)};
+		};
+		const auto inverseW = simd::reciprocal(row(3));
+		simd::storeInterleaved3(row(0) * inverseW, row(1) * inverseW, row(2) * inverseW, target + 3 * i);
+	}
+	for (; i < count; ++i) {
+		auto result = Vec4{};
+		multiplyAndSet(result, matrix, Vec4{source[3 * i], source[3 * i + 1], source[3 * i + 2], 1.0f});
+		const auto inverseW = simd::reciprocal(result.get(3));
+		for (auto coordinate = 0u; coordinate < 3u; ++coordinate) {
+			target[3 * i + coordinate] = result.get(coordinate) * inverseW;
+		}
+	}
+}
+
+} // namespace detail
+
+// results[i] = viewport.apply(perspectiveDivide(projection.apply(points[i]))), four points at
+// a time. viewport must be affine, which lets it be applied before the divide, folded into the
+// projection matrix. Results differ from the step-by-step path by the few ulp of
+// simd::reciprocal.
+template <class FromSpaceT, class UnitT>
+inline void projectAll(
+	const ProjectiveXform<FromSpaceT, space::Clip>& projection,
+	const Xform<space::NDC, space::Screen>& viewport,
+	const CompactPoint<FromSpaceT, UnitT>* points,
+	std::size_t count,
+	CompactPoint<space::Screen>* results
+) {
+	assert(classify(viewport.matrix()) <= XformStructure::AFFINE);
+	if constexpr (std::is_empty_v<FromSpaceT>) {
+		static_assert(sizeof(CompactPoint<FromSpaceT, UnitT>) == 3 * sizeof(float));
+		checkSpacesMatch(projection.fromSpace(), FromSpaceT{});
+		detail::projectPacked(
+			viewport.matrix() * projection.matrix(),
+			reinterpret_cast<const float*>(points),
+			count,
+			reinterpret_cast<float*>(results)
+			);
+	} else {
+		// Spaces with run-time state are stored in every element
+		for (auto i = std::size_t{0}; i < count; ++i) {
+			results[i] = CompactPoint<space::Screen>{viewport.apply(perspectiveDivide(projection.apply(points[i])))};
+		}
+	}
+}
+
+} // namespace type_safety
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "config.hpp"
+
+namespace type_safety {
+
+namespace detail {
+
+// A trivially copyable value written by one thread and read by any number of others without
+// locks. The writer makes the sequence odd while it writes and even again when done, readers
+// copy the value and retry if the sequence was odd or changed meanwhile, so they never see a
+// torn value. The value is kept in relaxed atomic words, so that the reads racing with writes,
+// which the sequence check then discards, are not data races.
+template <class T>
+class alignas(CACHE_LINE_SIZE) Seqlock {
+public:
+
+	static_assert(std::is_trivially_copyable_v<T>);
+
+	// Copies the value into result and returns true, unless a write got in the way.
+	bool tryRead(T& result) const {
+		const auto before = sequence_.load(std::memory_order_acquire);
+		if ((before & 1u) != 0) {
+			return false;
+		}
+		auto words = Words{};
+		for (auto word = std::size_t{0}; word < WORDS; ++word) {
+			words[word] = words_[word].load(std::memory_order_relaxed);
+		}
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (sequence_.load(std::memory_order_relaxed) != before) {
+			return false;
+		}
+		std::memcpy(static_cast<void*>(&result), words.data(), sizeof(T));
+		return true;
+	}
+
+	void read(T& result) const {
+		while (!tryRead(result)) {
+		}
+	}
+
+	// Only for the writing thread, which can't race with itself.
+	void readAsWriter(T& result) const {
+		auto words = Words{};
+		for (auto word = std::size_t{0}; word < WORDS; ++word) {
+			words[word] = words_[word].load(std::memory_order_relaxed);
+		}
+		std::memcpy(static_cast<void*>(&result), words.data(), sizeof(T));
+	}
+
+	void write(const T& value) {
+		auto words = Words{};
+		std::memcpy(words.data(), static_cast<const void*>(&value), sizeof(T));
+
+		const auto sequence = sequence_.load(std::memory_order_relaxed);
+		sequence_.store(sequence + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		for (auto word = std::size_t{0}; word < WORDS; ++word) {
+			words_[word].store(words[word], std::memory_order_relaxed);
+		}
+		sequence_.store(sequence + 2, std::memory_order_release);
+	}
+
+private:
+
+	static constexpr auto WORDS = (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+	using Words = std::array<std::uint64_t, WORDS>;
+
+	std::atomic<std::uint32_t> sequence_ = {0};
+
+	std::array<std::atomic<std::uint64_t>, WORDS> words_ = {};
+
+};
+
+} // namespace detail
+
+} // namespace type_safety
@@ -0,0 +1,213 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#include "Point.hpp"
+#include "Xform.hpp"
+#include "simd.hpp"
+#include "space.hpp"
+
+namespace type_safety {
+
+// Typed views of the xyz floats of points or vectors inside interleaved buffers, e.g. vertices
+// of position, normal and uv, so that Xforms apply to them in place rather than to copies:
+//
+//   auto positions = StridedPointView<space::Player, Metres>{vertices, count, sizeof(Vertex), offsetof(Vertex, position)};
+//   auto normals = StridedVectorView<space::Player>{vertices, count, sizeof(Vertex), offsetof(Vertex, normal)};
+//   const auto worldPositions = applyInPlace(playerToWorld, positions); // a StridedPointView<space::World, Metres>
+//   applyInPlace(playerToWorld, normals);
+//
+// Only x, y and z are stored, w being implied by the view - 1 for points and 0 for vectors - so
+// Xforms are applied as affine ones and the matrix's bottom row is ignored. The views don't own
+// the memory and floats need not be aligned. Batch applies gather simd::WIDE_LANES elements into
+// a packet per coordinate, transform them there and scatter the results back.
+
+namespace detail {
+
+template <class SpaceT, class UnitT, bool IS_POSITION>
+class StridedView : SpaceT {
+public:
+
+	using Space = SpaceT;
+	using Unit = UnitT;
+	using ElementType = std::conditional_t<IS_POSITION, Point<SpaceT, UnitT>, Vector<SpaceT, UnitT>>;
+
+	static constexpr auto W = IS_POSITION ? 1.0f : 0.0f;
+
+	template <class... SpaceParams>
+	StridedView(void* data, std::size_t size, std::size_t stride, std::size_t offset, SpaceParams&&... spaceParams) :
+		SpaceT(std::forward<SpaceParams>(spaceParams)...),
+		data_(static_cast<std::byte*>(data) + offset),
+		size_(size),
+		stride_(stride)
+	{
+		assert(stride >= 3 * sizeof(float));
+	}
+
+	decltype(auto) space() const {
+		if constexpr (std::is_empty_v<SpaceT>) {
+			return SpaceT{};
+		} else {
+			return static_cast<const SpaceT&>(*this);
+		}
+	}
+
+	std::size_t size() const {
+		return size_;
+	}
+
+	std::size_t stride() const {
+		return stride_;
+	}
+
+	// The first element's x.
+	std::byte* data() const {
+		return data_;
+	}
+
+	float coordinate(std::size_t index, std::size_t axis) const {
+		auto result = 0.0f;
+		std::memcpy(&result, data_ + index * stride_ + axis * sizeof(float), sizeof(float));
+		return result;
+	}
+
+	void setCoordinate(std::size_t index, std::size_t axis, float value) const {
+		std::memcpy(data_ + index * stride_ + axis * sizeof(float), &value, sizeof(float));
+	}
+
+	ElementType get(std::size_t index) const {
+		return ElementType{Vec3{coordinate(index, 0), coordinate(index, 1), coordinate(index, 2)}, space()};
+	}
+
+	void set(std::size_t index, const ElementType& element) const {
+		checkSpacesMatch(space(), element.space());
+		for (auto axis = std::size_t{0}; axis < 3u; ++axis) {
+			setCoordinate(index, axis, element.vector().get(axis));
+		}
+	}
+
+	ElementType operator[](std::size_t index) const {
+		return get(index);
+	}
+
+private:
+
+	std::byte* data_;
+
+	std::size_t size_;
+
+	std::size_t stride_;
+
+};
+
+template <class FloatT>
+inline FloatT gatherLanes(const std::byte* first, std::size_t stride) {
+	if constexpr (std::is_same_v<FloatT, float>) {
+		auto result = 0.0f;
+		std::memcpy(&result, first, sizeof(float));
+		return result;
+	} else {
+		auto lanes = std::array<float, sizeof(FloatT) / sizeof(float)>{};
+		for (auto lane = std::size_t{0}; lane < lanes.size(); ++lane) {
+			std::memcpy(&lanes[lane], first + lane * stride, sizeof(float));
+		}
+		return FloatT::load(lanes.data());
+	}
+}
+
+template <class FloatT>
+inline void scatterLanes(FloatT value, std::byte* first, std::size_t stride) {
+	if constexpr (std::is_same_v<FloatT, float>) {
+		std::memcpy(first, &value, sizeof(float));
+	} else {
+		auto lanes = std::array<float, sizeof(FloatT) / sizeof(float)>{};
+		value.store(lanes.data());
+		for (auto lane = std::size_t{0}; lane < lanes.size(); ++lane) {
+			std::memcpy(first + lane * stride, &lanes[lane], sizeof(float));
+		}
+	}
+}
+
+// target[i] = matrix * (source[i], w) for the elements [begin, begin + lanes of FloatT). Every
+// source coordinate is gathered before any is scattered, so source and target may be the same.
+template <class FloatT>
+inline void transformLanes(
+	const Matrix& matrix,
+	float w,
+	const std::byte* source,
+	std::size_t sourceStride,
+	std::byte* target,
+	std::size_t targetStride
+) {
+	const auto x = gatherLanes<FloatT>(source, sourceStride);
+	const auto y = gatherLanes<FloatT>(source + sizeof(float), sourceStride);
+	const auto z = gatherLanes<FloatT>(source + 2 * sizeof(float), sourceStride);
+	for (auto row = std::size_t{0}; row < 3u; ++row) {
+		const auto result =
+			x * FloatT{matrix.get(row, 0)} +
+			y * FloatT{matrix.get(row, 1)} +
+			z * FloatT{matrix.get(row, 2)} +
+			FloatT{matrix.get(row, 3) * w};
+		scatterLanes(result, target + row * sizeof(float), targetStride);
+	}
+}
+
+template <class SourceViewT, class TargetViewT>
+inline void transformStrided(const Matrix& matrix, const SourceViewT& source, const TargetViewT& target) {
+	assert(source.size() == target.size());
+	const auto* sourceData = source.data();
+	auto* targetData = target.data();
+	const auto sourceStride = source.stride();
+	const auto targetStride = target.stride();
+
+	auto i = std::size_t{0};
+	for (; i + simd::WIDE_LANES <= source.size(); i += simd::WIDE_LANES) {
+		transformLanes<simd::WideFloat>(
+			matrix, SourceViewT::W, sourceData + i * sourceStride, sourceStride, targetData + i * targetStride, targetStride
+			);
+	}
+	for (; i < source.size(); ++i) {
+		transformLanes<float>(
+			matrix, SourceViewT::W, sourceData + i * sourceStride, sourceStride, targetData + i * targetStride, targetStride
+			);
+	}
+}
+
+} // namespace detail
+
+template <class SpaceT, class UnitT = Dimensionless>
+using StridedPointView = detail::StridedView<SpaceT, UnitT, true>;
+
+template <class SpaceT, class UnitT = Dimensionless>
+using StridedVectorView = detail::StridedView<SpaceT, UnitT, false>;
+
+// Transforms the elements of source into target, which must have the same size and may be the
+// same memory as source, but not overlap it otherwise.
+template <class FromSpaceT, class ToSpaceT, class UnitT, bool IS_POSITION>
+inline void apply(
+	const Xform<FromSpaceT, ToSpaceT>& xform,
+	const detail::StridedView<FromSpaceT, UnitT, IS_POSITION>& source,
+	const detail::StridedView<ToSpaceT, UnitT, IS_POSITION>& target
+) {
+	checkSpacesMatch(xform.fromSpace(), source.space());
+	checkSpacesMatch(xform.toSpace(), target.space());
+	detail::transformStrided(xform.matrix(), source, target);
+}
+
+// Transforms the elements where they are and returns the view of them in their new space.
+template <class FromSpaceT, class ToSpaceT, class UnitT, bool IS_POSITION>
+inline detail::StridedView<ToSpaceT, UnitT, IS_POSITION> applyInPlace(
+	const Xform<FromSpaceT, ToSpaceT>& xform,
+	const detail::StridedView<FromSpaceT, UnitT, IS_POSITION>& view
+) {
+	auto result = detail::StridedView<ToSpaceT, UnitT, IS_POSITION>{view.data(), view.size(), view.stride(), 0, xform.toSpace()};
+	apply(xform, view, result);
+	return result;
+}
+
+} // namespace type_safety
@@ -0,0 +1,351 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include "CompactPoint.hpp"
+#include "Matrix.hpp"
+#include "Point.hpp"
+#include "VecN.hpp"
+#include "Xform.hpp"
+#include "math.hpp"
+#include "space.hpp"
+
+namespace type_safety {
+
+// Xforms whose matrices are known to have a simpler structure than a general 4x4 projection,
+// so that apply and inSequence can skip the rows and columns that are known constants:
+//
+//   const auto objectToParent = makeTranslationXform<space::Player, space::World>(Vec3{1.0f, 0.0f, 0.0f});
+//   const auto worldToCamera = RigidXform<space::World, space::Camera>{cameraMatrix};
+//   const auto objectToCamera = inSequence(objectToParent, worldToCamera); // a RigidXform
+//
+// The structure is part of the type, so a plain Xform<From, To> compiles exactly as before and
+// the classes cost no storage. StructuredXforms derive from Xform and pass wherever one is
+// expected, taking the general path there. Composing yields the least specific of the two
+// structures. For xforms whose structure is only known at run time, e.g. loaded ones,
+// withXformStructure classifies the matrix once and calls a function with the matching
+// StructuredXform, which pays off when it is then applied to many points.
+//
+// IdentityXform<Space> holds no matrix at all and disappears from inSequence chains.
+
+// Ordered from the most to the least specific, each class containing the previous ones.
+enum class XformStructure : std::uint8_t {
+	IDENTITY,
+	TRANSLATION,
+	RIGID, // rotation, possibly with reflection, and translation
+	SIMILARITY, // uniform scale, rotation and translation
+	AFFINE,
+	PROJECTIVE,
+};
+
+// The most specific structure of matrix. The zeros and ones that the kernels skip are compared
+// exactly, the orthogonality of RIGID and SIMILARITY with FLOAT_EQ_EPSILON relative to the
+// scale.
+inline XformStructure classify(const Matrix& matrix) {
+	if (matrix.get(3, 0) != 0.0f || matrix.get(3, 1) != 0.0f || matrix.get(3, 2) != 0.0f || matrix.get(3, 3) != 1.0f) {
+		return XformStructure::PROJECTIVE;
+	}
+
+	auto linearIsIdentity = true;
+	auto translationIsZero = true;
+	for (auto row = 0u; row < 3u; ++row) {
+		for (auto column = 0u; column < 3u; ++column) {
+			linearIsIdentity = linearIsIdentity && matrix.get(row, column) == (row == column ? 1.0f : 0.0f);
+		}
+		translationIsZero = translationIsZero && matrix.get(row, 3) == 0.0f;
+	}
+	if (linearIsIdentity) {
+		return translationIsZero ? XformStructure::IDENTITY : XformStructure::TRANSLATION;
+	}
+
+	// Orthogonal columns of equal length
+	const auto columnDot = [&](std::size_t lhs, std::size_t rhs) {
+		return matrix.get(0, lhs) * matrix.get(0, rhs) + matrix.get(1, lhs) * matrix.get(1, rhs) + matrix.get(2, lhs) * matrix.get(2, rhs);
+	};
+	const auto scaleSquared = columnDot(0, 0);
+	if (scaleSquared <= 0.0f) {
+		return XformStructure::AFFINE;
+	}
+	for (auto lhs = 0u; lhs < 3u; ++lhs) {
+		for (auto rhs = lhs; rhs < 3u; ++rhs) {
+			if (!floatEq(columnDot(lhs, rhs) / scaleSquared, lhs == rhs ? 1.0f : 0.0f)) {
+				return XformStructure::AFFINE;
+			}
+		}
+	}
+	return floatEq(scaleSquared, 1.0f) ? XformStructure::RIGID : XformStructure::SIMILARITY;
+}
+
+namespace detail {
+
+// Whether the constant elements that the kernels for structure skip have their expected
+// values. The orthogonality of RIGID and SIMILARITY matrices is not needed by the kernels, and
+// not checked, so that rounding in long chains of compositions cannot trip it.
+inline bool hasKernelStructure(const Matrix& matrix, XformStructure structure) {
+	const auto actual = classify(matrix);
+	if (structure >= XformStructure::RIGID && structure <= XformStructure::AFFINE) {
+		return actual <= XformStructure::AFFINE;
+	}
+	return actual <= structure;
+}
+
+template <XformStructure STRUCTURE>
+inline void applyStructured(Vec4& result, const Matrix& matrix, const Vec4& v) {
+	if constexpr (STRUCTURE == XformStructure::IDENTITY) {
+		result = v;
+	} else if constexpr (STRUCTURE == XformStructure::TRANSLATION) {
+		multiplyTranslationAndSet(result, matrix, v);
+	} else if constexpr (STRUCTURE <= XformStructure::AFFINE) {
+		multiplyAffineAndSet(result, matrix, v);
+	} else {
+		multiplyAndSet(result, matrix, v);
+	}
+}
+
+// CompactPoints and CompactVectors are always transformed as affine, see Xform::apply.
+template <XformStructure STRUCTURE>
+inline void applyStructured(Vec3& result, const Matrix& matrix, const Vec3& v, float w) {
+	if constexpr (STRUCTURE == XformStructure::IDENTITY) {
+		result = v;
+	} else if constexpr (STRUCTURE == XformStructure::TRANSLATION) {
+		result = v + Vec3{matrix.get(0, 3), matrix.get(1, 3), matrix.get(2, 3)} * w;
+	} else {
+		multiplyAffineAndSet(result, matrix, v, w);
+	}
+}
+
+} // namespace detail
+
+template <class FromSpaceT, class ToSpaceT, XformStructure STRUCTURE>
+class StructuredXform : public Xform<FromSpaceT, ToSpaceT> {
+public:
+
+	static constexpr auto STRUCTURE_CLASS = STRUCTURE;
+
+	// matrix must have STRUCTURE, which is asserted.
+	template <class... SpaceParams>
+	StructuredXform(Matrix matrix, SpaceParams&&... spaceParams) :
+		Xform<FromSpaceT, ToSpaceT>(std::move(matrix), std::forward<SpaceParams>(spaceParams)...)
+	{
+		assert(detail::hasKernelStructure(this->matrix(), STRUCTURE));
+	}
+
+	explicit StructuredXform(const Xform<FromSpaceT, ToSpaceT>& xform) :
+		Xform<FromSpaceT, ToSpaceT>(xform)
+	{
+		assert(detail::hasKernelStructure(this->matrix(), STRUCTURE));
+	}
+
+	template <class UnitT>
+	Point<ToSpaceT, UnitT> apply(const Point<FromSpaceT, UnitT>& p) const {
+		checkSpacesMatch(this->fromSpace(), p.space());
+		auto result = Point<ToSpaceT, UnitT>{this->toSpace()};
+		detail::applyStructured<STRUCTURE>(result.vector(), matrix(), p.vector());
+		return result;
+	}
+
+	template <class UnitT>
+	Vector<ToSpaceT, UnitT> apply(const Vector<FromSpaceT, UnitT>& v) const {
+		checkSpacesMatch(this->fromSpace(), v.space());
+		auto result = Vector<ToSpaceT, UnitT>{this->toSpace()};
+		detail::applyStructured<STRUCTURE>(result.vector(), matrix(), v.vector());
+		return result;
+	}
+
+	template <class UnitT>
+	CompactPoint<ToSpaceT, UnitT> apply(const CompactPoint<FromSpaceT, UnitT>& p) const {
+		checkSpacesMatch(this->fromSpace(), p.space());
+		auto result = CompactPoint<ToSpaceT, UnitT>{this->toSpace()};
+		detail::applyStructured<STRUCTURE>(result.xyz(), matrix(), p.xyz(), 1.0f);
+		return result;
+	}
+
+	template <class UnitT>
+	CompactVector<ToSpaceT, UnitT> apply(const CompactVector<FromSpaceT, UnitT>& v) const {
+		checkSpacesMatch(this->fromSpace(), v.space());
+		auto result = CompactVector<ToSpaceT, UnitT>{this->toSpace()};
+		detail::applyStructured<STRUCTURE>(result.xyz(), matrix(), v.xyz(), 0.0f);
+		return result;
+	}
+
+	// Read-only, as writes could break the structure.
+	const Matrix& matrix() const {
+		return Xform<FromSpaceT, ToSpaceT>::matrix();
+	}
+
+};
+
+static_assert(sizeof(StructuredXform<space::World, space::Camera, XformStructure::TRANSLATION>) == sizeof(Matrix));
+
+template <class FromSpaceT, class ToSpaceT>
+using TranslationXform = StructuredXform<FromSpaceT, ToSpaceT, XformStructure::TRANSLATION>;
+
+template <class FromSpaceT, class ToSpaceT>
+using RigidXform = StructuredXform<FromSpaceT, ToSpaceT, XformStructure::RIGID>;
+
+template <class FromSpaceT, class ToSpaceT>
+using SimilarityXform = StructuredXform<FromSpaceT, ToSpaceT, XformStructure::SIMILARITY>;
+
+template <class FromSpaceT, class ToSpaceT>
+using AffineXform = StructuredXform<FromSpaceT, ToSpaceT, XformStructure::AFFINE>;
+
+template <class FromSpaceT, class ToSpaceT>
+inline TranslationXform<FromSpaceT, ToSpaceT> makeTranslationXform(
+	const Vec3& offset,
+	FromSpaceT fromSpace = FromSpaceT{},
+	ToSpaceT toSpace = ToSpaceT{}
+) {
+	auto matrix = Matrix::identity();
+	for (auto row = 0u; row < 3u; ++row) {
+		matrix.get(row, 3) = offset.get(row);
+	}
+	return TranslationXform<FromSpaceT, ToSpaceT>{std::move(matrix), std::move(fromSpace), std::move(toSpace)};
+}
+
+template <class FromSpaceT, class ToSpaceT>
+inline SimilarityXform<FromSpaceT, ToSpaceT> makeUniformScaleXform(
+	float scale,
+	FromSpaceT fromSpace = FromSpaceT{},
+	ToSpaceT toSpace = ToSpaceT{}
+) {
+	auto matrix = Matrix::identity();
+	for (auto row = 0u; row < 3u; ++row) {
+		matrix.get(row, row) = scale;
+	}
+	return SimilarityXform<FromSpaceT, ToSpaceT>{std::move(matrix), std::move(fromSpace), std::move(toSpace)};
+}
+
+// function(StructuredXform<FromSpaceT, ToSpaceT, classify(xform.matrix())>{xform}), which all
+// cases must return the same type from.
+template <class FromSpaceT, class ToSpaceT, class FunctionT>
+inline decltype(auto) withXformStructure(const Xform<FromSpaceT, ToSpaceT>& xform, FunctionT function) {
+	switch (classify(xform.matrix())) {
+	case XformStructure::IDENTITY:
+		return function(StructuredXform<FromSpaceT, ToSpaceT, XformStructure::IDENTITY>{xform});
+	case XformStructure::TRANSLATION:
+		return function(StructuredXform<FromSpaceT, ToSpaceT, XformStructure::TRANSLATION>{xform});
+	case XformStructure::RIGID:
+		return function(StructuredXform<FromSpaceT, ToSpaceT, XformStructure::RIGID>{xform});
+	case XformStructure::SIMILARITY:
+		return function(StructuredXform<FromSpaceT, ToSpaceT, XformStructure::SIMILARITY>{xform});
+	case XformStructure::AFFINE:
+		return function(StructuredXform<FromSpaceT, ToSpaceT, XformStructure::AFFINE>{xform});
+	case XformStructure::PROJECTIVE:
+		break;
+	}
+	return function(StructuredXform<FromSpaceT, ToSpaceT, XformStructure::PROJECTIVE>{xform});
+}
+
+template <
+	class LhsFromSpaceT,
+	class LhsToSpaceT,
+	XformStructure LHS_STRUCTURE,
+	class RhsFromSpaceT,
+	class RhsToSpaceT,
+	XformStructure RHS_STRUCTURE
+	>
+inline auto inSequence(
+	const StructuredXform<LhsFromSpaceT, LhsToSpaceT, LHS_STRUCTURE>& lhs,
+	const StructuredXform<RhsFromSpaceT, RhsToSpaceT, RHS_STRUCTURE>& rhs
+) {
+	checkSpacesMatch(lhs.toSpace(), rhs.fromSpace());
+	constexpr auto STRUCTURE = std::max(LHS_STRUCTURE, RHS_STRUCTURE);
+
+	auto matrix = Matrix{};
+	if constexpr (LHS_STRUCTURE == XformStructure::IDENTITY) {
+		matrix = rhs.matrix();
+	} else if constexpr (RHS_STRUCTURE == XformStructure::IDENTITY) {
+		matrix = lhs.matrix();
+	} else if constexpr (STRUCTURE == XformStructure::TRANSLATION) {
+		multiplyTranslationsAndSet(matrix, rhs.matrix(), lhs.matrix());
+	} else if constexpr (STRUCTURE <= XformStructure::AFFINE) {
+		multiplyAffineAndSet(matrix, rhs.matrix(), lhs.matrix());
+	} else {
+		multiplyAndSet(matrix, rhs.matrix(), lhs.matrix());
+	}
+	return StructuredXform<LhsFromSpaceT, RhsToSpaceT, STRUCTURE>{std::move(matrix), lhs.fromSpace(), rhs.toSpace()};
+}
+
+// The identity in SpaceT, known at compile time.
+template <class SpaceT>
+class IdentityXform : SpaceT {
+public:
+
+	template <class... SpaceParams, class = detail::EnableIfSpaceConstructible<SpaceT, SpaceParams...>>
+	IdentityXform(SpaceParams&&... spaceParams) :
+		SpaceT(std::forward<SpaceParams>(spaceParams)...)
+	{
+	}
+
+	// Any of the point and vector types.
+	template <class ElementT>
+	ElementT apply(const ElementT& element) const {
+		checkSpacesMatch(space(), element.space());
+		return element;
+	}
+
+	decltype(auto) space() const {
+		if constexpr (std::is_empty_v<SpaceT>) {
+			return SpaceT{};
+		} else {
+			return static_cast<const SpaceT&>(*this);
+		}
+	}
+
+	decltype(auto) fromSpace() const {
+		return space();
+	}
+
+	decltype(auto) toSpace() const {
+		return space();
+	}
+
+	operator StructuredXform<SpaceT, SpaceT, XformStructure::IDENTITY>() const {
+		return StructuredXform<SpaceT, SpaceT, XformStructure::IDENTITY>{Matrix::identity(), space(), space()};
+	}
+
+};
+
+static_assert(std::is_empty_v<IdentityXform<space::World>>);
+
+template <class SpaceT>
+inline IdentityXform<SpaceT> inSequence(const IdentityXform<SpaceT>& lhs, const IdentityXform<SpaceT>& rhs) {
+	checkSpacesMatch(lhs.toSpace(), rhs.fromSpace());
+	return lhs;
+}
+
+template <class SpaceT, class ToSpaceT>
+inline Xform<SpaceT, ToSpaceT> inSequence(const IdentityXform<SpaceT>& lhs, const Xform<SpaceT, ToSpaceT>& rhs) {
+	checkSpacesMatch(lhs.toSpace(), rhs.fromSpace());
+	return rhs;
+}
+
+template <class FromSpaceT, class SpaceT>
+inline Xform<FromSpaceT, SpaceT> inSequence(const Xform<FromSpaceT, SpaceT>& lhs, const IdentityXform<SpaceT>& rhs) {
+	checkSpacesMatch(lhs.toSpace(), rhs.fromSpace());
+	return lhs;
+}
+
+template <class SpaceT, class ToSpaceT, XformStructure STRUCTURE>
+inline StructuredXform<SpaceT, ToSpaceT, STRUCTURE> inSequence(
+	const IdentityXform<SpaceT>& lhs,
+	const StructuredXform<SpaceT, ToSpaceT, STRUCTURE>& rhs
+) {
+	checkSpacesMatch(lhs.toSpace(), rhs.fromSpace());
+	return rhs;
+}
+
+template <class FromSpaceT, class SpaceT, XformStructure STRUCTURE>
+inline StructuredXform<FromSpaceT, SpaceT, STRUCTURE> inSequence(
+	const StructuredXform<FromSpaceT, SpaceT, STRUCTURE>& lhs,
+	const IdentityXform<SpaceT>& rhs
+) {
+	checkSpacesMatch(lhs.toSpace(), rhs.fromSpace());
+	return lhs;
+}
+
+} // namespace type_safety
@@ -0,0 +1,298 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include "CompactPoint.hpp"
+#include "CompressedPair.hpp"
+#include "Matrix.hpp"
+#include "Point.hpp"
+#include "VecN.hpp"
+#include "Xform.hpp"
+#include "simd.hpp"
+#include "space.hpp"
+
+namespace type_safety {
+
+// Xforms that only permute the axes and flip some of their signs, with the permutation in the
+// type - e.g. between the Y-up and Z-up, left- and right-handed conventions of imported assets:
+//
+//   const auto toEngine = ConventionXform<space::ZUpRightHanded, space::YUpRightHanded>{};
+//   const auto p = toEngine.apply(blenderPoint); // one shuffle and one XOR
+//
+// apply moves coordinates without any arithmetic, composing two SwizzleXforms is done at
+// compile time and composing one with an Xform permutes the Xform's rows or columns instead of
+// multiplying matrices.
+
+enum class SignedAxis : std::uint8_t {
+	PLUS_X,
+	PLUS_Y,
+	PLUS_Z,
+	MINUS_X,
+	MINUS_Y,
+	MINUS_Z,
+};
+
+namespace detail {
+
+// Coordinate i of the result is coordinate axisIndex(axes[i]) of the source, negated if
+// isNegative(axes[i]).
+using SignedPermutation = std::array<SignedAxis, 3>;
+
+constexpr std::size_t axisIndex(SignedAxis axis) {
+	return static_cast<std::size_t>(axis) % 3u;
+}
+
+constexpr bool isNegative(SignedAxis axis) {
+	return static_cast<std::size_t>(axis) >= 3u;
+}
+
+constexpr SignedAxis makeSignedAxis(std::size_t index, bool negative) {
+	return static_cast<SignedAxis>(index + (negative ? 3u : 0u));
+}
+
+constexpr bool isPermutation(const SignedPermutation& axes) {
+	return
+		axisIndex(axes[0]) != axisIndex(axes[1]) &&
+		axisIndex(axes[0]) != axisIndex(axes[2]) &&
+		axisIndex(axes[1]) != axisIndex(axes[2]);
+}
+
+// first, then second.
+constexpr SignedPermutation composePermutations(const SignedPermutation& first, const SignedPermutation& second) {
+	auto result = SignedPermutation{};
+	for (auto i = 0u; i < 3u; ++i) {
+		const auto& viaFirst = first[axisIndex(second[i])];
+		result[i] = makeSignedAxis(axisIndex(viaFirst), isNegative(viaFirst) != isNegative(second[i]));
+	}
+	return result;
+}
+
+constexpr SignedPermutation invertPermutation(const SignedPermutation& axes) {
+	auto result = SignedPermutation{};
+	for (auto i = 0u; i < 3u; ++i) {
+		result[axisIndex(axes[i])] = makeSignedAxis(i, isNegative(axes[i]));
+	}
+	return result;
+}
+
+// value, negated for the MINUS_ axes.
+template <SignedAxis AXIS>
+inline float signedCoordinate(float value) {
+	if constexpr (isNegative(AXIS)) {
+		return -value;
+	} else {
+		return value;
+	}
+}
+
+template <SignedAxis X, SignedAxis Y, SignedAxis Z>
+inline Vec4 swizzle(Vec4 v) {
+	const auto swizzled = simd::negateLanes<isNegative(X), isNegative(Y), isNegative(Z), false>(
+		simd::shuffle<axisIndex(X), axisIndex(Y), axisIndex(Z), 3>(simd::Float4::load(&v.get(0)))
+		);
+	auto result = Vec4{};
+	swizzled.store(&result.get(0));
+	return result;
+}
+
+template <SignedAxis X, SignedAxis Y, SignedAxis Z>
+inline Vec3 swizzle(const Vec3& v) {
+	return Vec3{signedCoordinate<X>(v.get(axisIndex(X))), signedCoordinate<Y>(v.get(axisIndex(Y))), signedCoordinate<Z>(v.get(axisIndex(Z)))};
+}
+
+} // namespace detail
+
+template <class FromSpaceT, class ToSpaceT, SignedAxis X, SignedAxis Y, SignedAxis Z>
+class SwizzleXform : CompressedPair<FromSpaceT, ToSpaceT> {
+public:
+
+	static constexpr auto AXES = detail::SignedPermutation{X, Y, Z};
+
+	static_assert(detail::isPermutation(AXES), "Every axis must be used exactly once");
+
+	template <class... SpaceParams, class = detail::EnableIfNotXform<SwizzleXform, SpaceParams...>>
+	SwizzleXform(SpaceParams&&... spaceParams) :
+		CompressedPair<FromSpaceT, ToSpaceT>(std::forward<SpaceParams>(spaceParams)...)
+	{
+	}
+
+	template <class UnitT>
+	Point<ToSpaceT, UnitT> apply(const Point<FromSpaceT, UnitT>& p) const {
+		checkSpacesMatch(fromSpace(), p.space());
+		return Point<ToSpaceT, UnitT>{detail::swizzle<X, Y, Z>(p.vector()), toSpace()};
+	}
+
+	template <class UnitT>
+	Vector<ToSpaceT, UnitT> apply(const Vector<FromSpaceT, UnitT>& v) const {
+		checkSpacesMatch(fromSpace(), v.space());
+		return Vector<ToSpaceT, UnitT>{detail::swizzle<X, Y, Z>(v.vector()), toSpace()};
+	}
+
+	template <class UnitT>
+	CompactPoint<ToSpaceT, UnitT> apply(const CompactPoint<FromSpaceT, UnitT>& p) const {
+		checkSpacesMatch(fromSpace(), p.space());
+		return CompactPoint<ToSpaceT, UnitT>{detail::swizzle<X, Y, Z>(p.xyz()), toSpace()};
+	}
+
+	template <class UnitT>
+	CompactVector<ToSpaceT, UnitT> apply(const CompactVector<FromSpaceT, UnitT>& v) const {
+		checkSpacesMatch(fromSpace(), v.space());
+		return CompactVector<ToSpaceT, UnitT>{detail::swizzle<X, Y, Z>(v.xyz()), toSpace()};
+	}
+
+	decltype(auto) fromSpace() const {
+		return CompressedPair<FromSpaceT, ToSpaceT>::first();
+	}
+
+	decltype(auto) toSpace() const {
+		return CompressedPair<FromSpaceT, ToSpaceT>::second();
+	}
+
+	Matrix matrix() const {
+		auto result = Matrix{};
+		for (auto row = 0u; row < 4u; ++row) {
+			for (auto column = 0u; column < 4u; ++column) {
+				result.get(row, column) = row == 3u && column == 3u ? 1.0f : 0.0f;
+			}
+		}
+		for (auto row = 0u; row < 3u; ++row) {
+			result.get(row, detail::axisIndex(AXES[row])) = detail::isNegative(AXES[row]) ? -1.0f : 1.0f;
+		}
+		return result;
+	}
+
+	operator Xform<FromSpaceT, ToSpaceT>() const {
+		return Xform<FromSpaceT, ToSpaceT>{matrix(), fromSpace(), toSpace()};
+	}
+
+};
+
+static_assert(std::is_empty_v<SwizzleXform<space::World, space::Camera, SignedAxis::PLUS_X, SignedAxis::PLUS_Y, SignedAxis::PLUS_Z>>);
+
+// Axis conventions, as the signed permutation from the coordinates of YUpRightHanded.
+template <SignedAxis X, SignedAxis Y, SignedAxis Z>
+struct AxisConvention {
+	static constexpr auto FROM_Y_UP_RIGHT_HANDED = detail::SignedPermutation{X, Y, Z};
+};
+
+namespace space {
+
+// X right, Y up, Z towards the viewer - OpenGL, Maya, glTF
+struct YUpRightHanded {
+	using Convention = AxisConvention<SignedAxis::PLUS_X, SignedAxis::PLUS_Y, SignedAxis::PLUS_Z>;
+};
+
+// X right, Y away from the viewer, Z up - Blender, 3ds Max
+struct ZUpRightHanded {
+	using Convention = AxisConvention<SignedAxis::PLUS_X, SignedAxis::MINUS_Z, SignedAxis::PLUS_Y>;
+};
+
+// X right, Y up, Z away from the viewer - Unity, Direct3D
+struct YUpLeftHanded {
+	using Convention = AxisConvention<SignedAxis::PLUS_X, SignedAxis::PLUS_Y, SignedAxis::MINUS_Z>;
+};
+
+// X away from the viewer, Y right, Z up - Unreal
+struct ZUpLeftHanded {
+	using Convention = AxisConvention<SignedAxis::MINUS_Z, SignedAxis::PLUS_X, SignedAxis::PLUS_Y>;
+};
+
+} // namespace space
+
+namespace detail {
+
+template <class FromSpaceT, class ToSpaceT>
+struct ConventionSwizzle {
+	static constexpr auto AXES = composePermutations(
+		invertPermutation(FromSpaceT::Convention::FROM_Y_UP_RIGHT_HANDED),
+		ToSpaceT::Convention::FROM_Y_UP_RIGHT_HANDED
+		);
+
+	using Type = SwizzleXform<FromSpaceT, ToSpaceT, AXES[0], AXES[1], AXES[2]>;
+};
+
+} // namespace detail
+
+// From the axis convention of FromSpaceT to that of ToSpaceT, both having a Convention.
+template <class FromSpaceT, class ToSpaceT>
+using ConventionXform = typename detail::ConventionSwizzle<FromSpaceT, ToSpaceT>::Type;
+
+template <
+	class LhsFromSpaceT,
+	class LhsToSpaceT,
+	SignedAxis LHS_X,
+	SignedAxis LHS_Y,
+	SignedAxis LHS_Z,
+	class RhsFromSpaceT,
+	class RhsToSpaceT,
+	SignedAxis RHS_X,
+	SignedAxis RHS_Y,
+	SignedAxis RHS_Z
+	>
+inline auto inSequence(
+	const SwizzleXform<LhsFromSpaceT, LhsToSpaceT, LHS_X, LHS_Y, LHS_Z>& lhs,
+	const SwizzleXform<RhsFromSpaceT, RhsToSpaceT, RHS_X, RHS_Y, RHS_Z>& rhs
+) {
+	checkSpacesMatch(lhs.toSpace(), rhs.fromSpace());
+	constexpr auto AXES = detail::composePermutations(
+		detail::SignedPermutation{LHS_X, LHS_Y, LHS_Z},
+		detail::SignedPermutation{RHS_X, RHS_Y, RHS_Z}
+		);
+	return SwizzleXform<LhsFromSpaceT, RhsToSpaceT, AXES[0], AXES[1], AXES[2]>{lhs.fromSpace(), rhs.toSpace()};
+}
+
+// The columns of rhs's matrix, moved and negated.
+template <
+	class LhsFromSpaceT,
+	class LhsToSpaceT,
+	SignedAxis X,
+	SignedAxis Y,
+	SignedAxis Z,
+	class RhsFromSpaceT,
+	class RhsToSpaceT
+	>
+inline Xform<LhsFromSpaceT, RhsToSpaceT> inSequence(
+	const SwizzleXform<LhsFromSpaceT, LhsToSpaceT, X, Y, Z>& lhs,
+	const Xform<RhsFromSpaceT, RhsToSpaceT>& rhs
+) {
+	checkSpacesMatch(lhs.toSpace(), rhs.fromSpace());
+	auto result = Xform<LhsFromSpaceT, RhsToSpaceT>{lhs.fromSpace(), rhs.toSpace()};
+	for (auto row = 0u; row < 4u; ++row) {
+		result.matrix().get(row, detail::axisIndex(X)) = detail::signedCoordinate<X>(rhs.matrix().get(row, 0));
+		result.matrix().get(row, detail::axisIndex(Y)) = detail::signedCoordinate<Y>(rhs.matrix().get(row, 1));
+		result.matrix().get(row, detail::axisIndex(Z)) = detail::signedCoordinate<Z>(rhs.matrix().get(row, 2));
+		result.matrix().get(row, 3) = rhs.matrix().get(row, 3);
+	}
+	return result;
+}
+
+// The rows of lhs's matrix, moved and negated.
+template <
+	class LhsFromSpaceT,
+	class LhsToSpaceT,
+	class RhsFromSpaceT,
+	class RhsToSpaceT,
+	SignedAxis X,
+	SignedAxis Y,
+	SignedAxis Z
+	>
+inline Xform<LhsFromSpaceT, RhsToSpaceT> inSequence(
+	const Xform<LhsFromSpaceT, LhsToSpaceT>& lhs,
+	const SwizzleXform<RhsFromSpaceT, RhsToSpaceT, X, Y, Z>& rhs
+) {
+	checkSpacesMatch(lhs.toSpace(), rhs.fromSpace());
+	auto result = Xform<LhsFromSpaceT, RhsToSpaceT>{lhs.fromSpace(), rhs.toSpace()};
+	for (auto column = 0u; column < 4u; ++column) {
+		result.matrix().get(0, column) = detail::signedCoordinate<X>(lhs.matrix().get(detail::axisIndex(X), column));
+		result.matrix().get(1, column) = detail::signedCoordinate<Y>(lhs.matrix().get(detail::axisIndex(Y), column));
+		result.matrix().get(2, column) = detail::signedCoordinate<Z>(lhs.matrix().get(detail::axisIndex(Z), column));
+		result.matrix().get(3, column) = lhs.matrix().get(3, column);
+	}
+	return result;
+}
+
+} // namespace type_safety
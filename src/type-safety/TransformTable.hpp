@@ -0,0 +1,163 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "Seqlock.hpp"
+#include "Xform.hpp"
+
+namespace type_safety {
+
+// Xforms written by one thread and read by any number of others without locks, e.g. physics
+// writing the player transforms which render, audio and networking read every frame.
+//
+// Every entry is a detail::Seqlock, so reads never see a torn matrix, never block the writer and
+// cost a copy and two loads when uncontended.
+//
+// The table is double buffered for bulk updates: beginBulkUpdate copies the current entries
+// to the other buffer, the writer updates them there and publish swaps the buffers by bumping
+// the table epoch. Readers of the old buffer keep reading it and retry once the writer reuses
+// it for the next bulk update. readAll reads every entry from one epoch.
+//
+// Only one thread may write, and single entry writes made while a bulk update is open are lost
+// when it is published.
+template <class FromSpaceT, class ToSpaceT>
+class TransformTable {
+public:
+
+	using XformType = Xform<FromSpaceT, ToSpaceT>;
+
+	class BulkUpdate {
+	public:
+
+		BulkUpdate(const BulkUpdate&) = delete;
+
+		BulkUpdate& operator=(const BulkUpdate&) = delete;
+
+		void write(std::size_t index, const XformType& xform) {
+			assert(!published_);
+			table_.buffer(epoch_)[index].write(xform);
+		}
+
+		// Makes the update visible to readers. An update destroyed without publishing is
+		// discarded.
+		void publish() {
+			assert(!published_);
+			table_.epoch_.store(epoch_, std::memory_order_release);
+			published_ = true;
+		}
+
+	private:
+
+		friend class TransformTable;
+
+		TransformTable& table_;
+
+		std::uint64_t epoch_;
+
+		bool published_ = false;
+
+		BulkUpdate(TransformTable& table, std::uint64_t epoch) :
+			table_(table),
+			epoch_(epoch)
+		{
+		}
+
+	};
+
+	TransformTable(std::size_t size, const XformType& initial) :
+		buffers_{ std::make_unique<Entry[]>(size), std::make_unique<Entry[]>(size) },
+		size_(size),
+		prototype_(initial)
+	{
+		for (auto index = std::size_t{0}; index < size_; ++index) {
+			buffers_[0][index].write(initial);
+			buffers_[1][index].write(initial);
+		}
+	}
+
+	TransformTable(const TransformTable&) = delete;
+
+	TransformTable& operator=(const TransformTable&) = delete;
+
+	std::size_t size() const {
+		return size_;
+	}
+
+	// Number of bulk updates published so far.
+	std::uint64_t epoch() const {
+		return epoch_.load(std::memory_order_acquire);
+	}
+
+	XformType read(std::size_t index) const {
+		// Copied for the spaces, the entry overwrites the rest
+		auto result = prototype_;
+		for (;;) {
+			// The epoch is checked again as in readAll, as by the time the entry is read the
+			// writer may have published and reused the buffer for the next bulk update
+			const auto epoch = epoch_.load(std::memory_order_acquire);
+			if (buffer(epoch)[index].tryRead(result) && epoch_.load(std::memory_order_relaxed) == epoch) {
+				return result;
+			}
+		}
+	}
+
+	// Writes results[i] for every entry, all from the same epoch.
+	void readAll(XformType* results) const {
+		for (;;) {
+			const auto epoch = epoch_.load(std::memory_order_acquire);
+			const auto* entries = buffer(epoch);
+			for (auto index = std::size_t{0}; index < size_; ++index) {
+				results[index] = prototype_;
+				entries[index].read(results[index]);
+			}
+			if (epoch_.load(std::memory_order_relaxed) == epoch) {
+				return;
+			}
+		}
+	}
+
+	void write(std::size_t index, const XformType& xform) {
+		buffer(epoch_.load(std::memory_order_relaxed))[index].write(xform);
+	}
+
+	BulkUpdate beginBulkUpdate() {
+		const auto current = epoch_.load(std::memory_order_relaxed);
+		const auto* source = buffer(current);
+		auto* target = buffer(current + 1);
+		auto xform = prototype_;
+		for (auto index = std::size_t{0}; index < size_; ++index) {
+			source[index].readAsWriter(xform);
+			target[index].write(xform);
+		}
+		return BulkUpdate{*this, current + 1};
+	}
+
+private:
+
+	using Entry = detail::Seqlock<XformType>;
+
+	std::array<std::unique_ptr<Entry[]>, 2> buffers_;
+
+	std::size_t size_;
+
+	// Source of the spaces for the xforms read
+	XformType prototype_;
+
+	std::atomic<std::uint64_t> epoch_ = {0};
+
+	Entry* buffer(std::uint64_t epoch) {
+		return buffers_[epoch % 2].get();
+	}
+
+	const Entry* buffer(std::uint64_t epoch) const {
+		return buffers_[epoch % 2].get();
+	}
+
+};
+
+} // namespace type_safety
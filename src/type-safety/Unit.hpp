@@ -1,83 +1,134 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <ratio>
-#include <iostream>
+#include <type_traits>
 
 #include "math.hpp"
 
+// Streaming lives in UnitIO.hpp, so that including the units doesn't pull in the iostreams.
+
 namespace type_safety {
 
 namespace detail {
 
-template <
-	class TO_M_RATIO_PARAM,
-    int M_EXP_PARAM,
-    class TO_KG_RATIO_PARAM,
-	int KG_EXP_PARAM,
-	class TO_S_RATIO_PARAM,
-	int S_EXP_PARAM
->
+// Conversion ratios are combined with constexpr functions rather than std::ratio_multiply and
+// std::ratio_divide, whose instantiation chains (gcd, overflow checks, the result ratio) were
+// repeated for every unit product in every translation unit. Only the resulting std::ratio is
+// instantiated.
+struct RatioValue {
+	std::intmax_t num;
+	std::intmax_t den;
+};
+
+constexpr std::intmax_t gcd(std::intmax_t lhs, std::intmax_t rhs) {
+	while (rhs != 0) {
+		const auto remainder = lhs % rhs;
+		lhs = rhs;
+		rhs = remainder;
+	}
+	return lhs < 0 ? -lhs : lhs;
+}
+
+// Both arguments are reduced, so reducing crosswise keeps the result reduced and only overflows
+// if the result itself doesn't fit.
+constexpr RatioValue multiplyRatios(RatioValue lhs, RatioValue rhs) {
+	const auto lhsNumRhsDen = gcd(lhs.num, rhs.den);
+	const auto rhsNumLhsDen = gcd(rhs.num, lhs.den);
+	return {
+		(lhs.num / lhsNumRhsDen) * (rhs.num / rhsNumLhsDen),
+		(lhs.den / rhsNumLhsDen) * (rhs.den / lhsNumRhsDen)
+	};
+}
+
+constexpr RatioValue divideRatios(RatioValue lhs, RatioValue rhs) {
+	return multiplyRatios(lhs, rhs.num < 0 ? RatioValue{-rhs.den, -rhs.num} : RatioValue{rhs.den, rhs.num});
+}
+
+template <class RatioT>
+constexpr auto RATIO_VALUE = RatioValue{RatioT::num, RatioT::den};
+
+template <class LhsRatioT, class RhsRatioT>
+using RatioProduct = std::ratio<
+	multiplyRatios(RATIO_VALUE<LhsRatioT>, RATIO_VALUE<RhsRatioT>).num,
+	multiplyRatios(RATIO_VALUE<LhsRatioT>, RATIO_VALUE<RhsRatioT>).den
+	>;
+
+template <class LhsRatioT, class RhsRatioT>
+using RatioQuotient = std::ratio<
+	divideRatios(RATIO_VALUE<LhsRatioT>, RATIO_VALUE<RhsRatioT>).num,
+	divideRatios(RATIO_VALUE<LhsRatioT>, RATIO_VALUE<RhsRatioT>).den
+	>;
+
+// Base dimensions, in the order in which units list their exponents. Adding a dimension takes a
+// new enumerator, a DIMENSION_COUNT bump and a zero exponent in the base unit aliases below -
+// the unit algebra doesn't change.
+enum class Dimension {
+	LENGTH,
+	MASS,
+	TIME,
+	CURRENT,
+	TEMPERATURE,
+};
+
+constexpr auto DIMENSION_COUNT = std::size_t{5};
+
+template <int... EXPONENTS>
+struct ExponentList final {
+};
+
+template <int... EXPONENTS>
+constexpr int exponentOf(Dimension dimension) {
+	constexpr int exponents[] = { EXPONENTS... };
+	return exponents[static_cast<std::size_t>(dimension)];
+}
+
+// A unit is the factor converting it to SI base units and the exponent of every dimension.
+// Both are canonical - the scale is a reduced std::ratio and the exponents are listed in
+// Dimension order, zeros included - so equal units are always the same type, whichever
+// expression produced them, and multiplying two units instantiates a single new type. Use the
+// aliases below and the unit operators rather than spelling out Unit.
+template <class ScaleT, int... EXPONENTS>
 struct Unit final {
 
-	using TO_M_RATIO = TO_M_RATIO_PARAM;
-    static constexpr auto M_EXP = M_EXP_PARAM;
-	using TO_KG_RATIO = TO_KG_RATIO_PARAM;
-    static constexpr auto KG_EXP = KG_EXP_PARAM;
-	using TO_S_RATIO = TO_S_RATIO_PARAM;
-    static constexpr auto S_EXP = S_EXP_PARAM;
-
-    template <class OtherUnitT>
-	static constexpr auto IS_CONVERTIBLE_TO =
-		M_EXP == OtherUnitT::M_EXP
-		&& KG_EXP == OtherUnitT::KG_EXP
-        && S_EXP == OtherUnitT::S_EXP
-        ;
-
-    template <class OtherUnitT>
-    using ConversionRatio =
-		std::ratio_multiply<
-			std::ratio_divide<TO_M_RATIO, typename OtherUnitT::TO_M_RATIO>,
-			std::ratio_multiply<
-				std::ratio_divide<TO_KG_RATIO, typename OtherUnitT::TO_KG_RATIO>,
-				std::ratio_divide<TO_S_RATIO, typename OtherUnitT::TO_S_RATIO>
-			>
-		>
-		;
+	static_assert(sizeof...(EXPONENTS) == DIMENSION_COUNT, "Expected an exponent for every dimension");
 
-	constexpr Unit() = default;
+	using Scale = ScaleT;
+	using Exponents = ExponentList<EXPONENTS...>;
+
+	template <Dimension DIMENSION>
+	static constexpr auto EXPONENT = exponentOf<EXPONENTS...>(DIMENSION);
 
 	template <class OtherUnitT>
-	constexpr auto operator*(OtherUnitT) const {
-		return Unit<
-			std::ratio_multiply<TO_M_RATIO, OtherUnitT::TO_M_RATIO>,
-			M_EXP + OtherUnitT::M_EXP,
-			std::ratio_multiply<TO_KG_RATIO, OtherUnitT::TO_KG_RATIO>,
-			KG_EXP + OtherUnitT::KG_EXP,
-			std::ratio_multiply<TO_S_RATIO, OtherUnitT::TO_S_RATIO>,
-			S_EXP + OtherUnitT::S_EXP
-		>{};
-	}
+	static constexpr auto IS_CONVERTIBLE_TO = std::is_same_v<Exponents, typename OtherUnitT::Exponents>;
+
+	template <class OtherUnitT>
+	static constexpr auto CONVERSION_RATIO = divideRatios(RATIO_VALUE<Scale>, RATIO_VALUE<typename OtherUnitT::Scale>);
 
 	template <class OtherUnitT>
-	constexpr auto operator/(OtherUnitT) const {
-		return Unit<
-			std::ratio_divide<TO_M_RATIO, OtherUnitT::TO_M_RATIO>,
-			M_EXP - OtherUnitT::M_EXP,
-			std::ratio_divide<TO_KG_RATIO, OtherUnitT::TO_KG_RATIO>,
-			KG_EXP - OtherUnitT::KG_EXP,
-			std::ratio_divide<TO_S_RATIO, OtherUnitT::TO_S_RATIO>,
-			S_EXP - OtherUnitT::S_EXP
-		>{};
+	static constexpr auto IS_IDENTITY_CONVERSION_TO = std::is_same_v<Scale, typename OtherUnitT::Scale>;
+
+	constexpr Unit() = default;
+
+	template <class OtherScaleT, int... OTHER_EXPONENTS>
+	constexpr auto operator*(Unit<OtherScaleT, OTHER_EXPONENTS...>) const {
+		return Unit<RatioProduct<Scale, OtherScaleT>, (EXPONENTS + OTHER_EXPONENTS)...>{};
+	}
+
+	template <class OtherScaleT, int... OTHER_EXPONENTS>
+	constexpr auto operator/(Unit<OtherScaleT, OTHER_EXPONENTS...>) const {
+		return Unit<RatioQuotient<Scale, OtherScaleT>, (EXPONENTS - OTHER_EXPONENTS)...>{};
 	}
 
 	template <class CompatibleUnitT>
 	constexpr float convertTo(float value) const {
 		static_assert(Unit::IS_CONVERTIBLE_TO<CompatibleUnitT>);
-		using Ratio = Unit::ConversionRatio<CompatibleUnitT>;
-		if constexpr (std::ratio_equal_v<Ratio, std::ratio<1, 1>>) {
+		if constexpr (IS_IDENTITY_CONVERSION_TO<CompatibleUnitT>) {
 			return value;
 		} else {
-			return (static_cast<float>(Ratio::num) / static_cast<float>(Ratio::den)) * value;
+			constexpr auto ratio = CONVERSION_RATIO<CompatibleUnitT>;
+			return (static_cast<float>(ratio.num) / static_cast<float>(ratio.den)) * value;
 		}
 	}
 
@@ -85,85 +136,52 @@ struct Unit final {
 
 } // namespace detail
 
-using Dimensionless = detail::Unit<std::ratio<1>, 0, std::ratio<1>, 0, std::ratio<1>, 0>;
+using detail::Dimension;
+using detail::DIMENSION_COUNT;
 
-inline std::ostream& operator<<(std::ostream& os, Dimensionless) {
-	return os;
-}
+// ScaleT is the number of SI base units in one unit, e.g. std::kilo for kilometres. Scales are
+// passed through std::ratio to reduce them.
+
+using Dimensionless = detail::Unit<std::ratio<1>, 0, 0, 0, 0, 0>;
 
 template <class ToMRatio>
-using DistanceUnit = detail::Unit<ToMRatio, 1, std::ratio<1>, 0, std::ratio<1>, 0>;
+using DistanceUnit = detail::Unit<std::ratio<ToMRatio::num, ToMRatio::den>, 1, 0, 0, 0, 0>;
 
 template <class ToKgRatio>
-using MassUnit = detail::Unit<std::ratio<1>, 0, ToKgRatio, 1, std::ratio<1>, 0>;
+using MassUnit = detail::Unit<std::ratio<ToKgRatio::num, ToKgRatio::den>, 0, 1, 0, 0, 0>;
+
+template <class ToSRatio>
+using TimeUnit = detail::Unit<std::ratio<ToSRatio::num, ToSRatio::den>, 0, 0, 1, 0, 0>;
 
-template <class ToSRatio >
-using TimeUnit = detail::Unit<std::ratio<1>, 0, std::ratio<1>, 0, ToSRatio, 1>;
+template <class ToARatio>
+using CurrentUnit = detail::Unit<std::ratio<ToARatio::num, ToARatio::den>, 0, 0, 0, 1, 0>;
+
+template <class ToKRatio>
+using TemperatureUnit = detail::Unit<std::ratio<ToKRatio::num, ToKRatio::den>, 0, 0, 0, 0, 1>;
 
 using Metres = DistanceUnit<std::ratio<1>>;
 using Kilometres = DistanceUnit<std::kilo>;
 using Milimetres = DistanceUnit<std::milli>;
 
-inline std::ostream& operator<<(std::ostream& os, Metres) {
-	return os << "_m";
-}
-
-inline std::ostream& operator<<(std::ostream& os, Kilometres) {
-	return os << "_km";
-}
-
 using Kilograms = MassUnit<std::ratio<1>>;
 using Grams = MassUnit<std::milli>;
 
-inline std::ostream& operator<<(std::ostream& os, Kilograms) {
-	return os << "_kg";
-}
-
-inline std::ostream& operator<<(std::ostream& os, Grams) {
-	return os << "_g";
-}
-
+using Nanoseconds = TimeUnit<std::nano>;
+using Microseconds = TimeUnit<std::micro>;
 using Milliseconds = TimeUnit<std::milli>;
 using Seconds = TimeUnit<std::ratio<1>>;
 using Minutes = TimeUnit<std::ratio<60>>;
 using Hours = TimeUnit<std::ratio<60 * 60>>;
 
-inline std::ostream& operator<<(std::ostream& os, Milliseconds) {
-	return os << "_ms";
-}
-
-inline std::ostream& operator<<(std::ostream& os, Seconds) {
-	return os << "_s";
-}
-
-inline std::ostream& operator<<(std::ostream& os, Minutes) {
-	return os << "_min";
-}
+using Amperes = CurrentUnit<std::ratio<1>>;
 
-inline std::ostream& operator<<(std::ostream& os, Hours) {
-	return os << "_h";
-}
+using Kelvins = TemperatureUnit<std::ratio<1>>;
 
 using MPS = decltype(Metres{} / Seconds{});
 using KPH = decltype(Kilometres{} / Hours{});
 using MPS2 = decltype(MPS{} / Seconds{});
 using Newtons = decltype(Kilograms{} * MPS2{});
-
-inline std::ostream& operator<<(std::ostream& os, MPS) {
-	return os << "_m/s";
-}
-
-inline std::ostream& operator<<(std::ostream& os, KPH) {
-	return os << "_km/h";
-}
-
-inline std::ostream& operator<<(std::ostream& os, MPS2) {
-	return os << "_m/s2";
-}
-
-inline std::ostream& operator<<(std::ostream& os, Newtons) {
-	return os << "_N";
-}
+using Joules = decltype(Newtons{} * Metres{});
 
 template <class UnitType>
 class Value final {
@@ -175,54 +193,54 @@ public:
 
 	template <class CompatibleUnitT>
     constexpr Value(CompatibleUnitT unit, float value) :
-        value_(unit.convertTo<Unit>(value))
+        value_(unit.template convertTo<Unit>(value))
     {
     }
 
     template <class CompatibleUnitT>
     constexpr Value(Value<CompatibleUnitT> compatibleValue) :
-        value_(compatibleValue.value<Unit>())
+        value_(compatibleValue.template value<Unit>())
     {
     }
 
     template <class CompatibleUnitT>
     constexpr float value() const {
-		return Unit{}.convertTo<CompatibleUnitT>(value_);
+		return Unit{}.template convertTo<CompatibleUnitT>(value_);
     }
 
 	template <class CompatibleUnitT>
 	friend constexpr bool operator==(Value lhs, Value<CompatibleUnitT> rhs) {
-		return floatEq(lhs.value_, rhs.value<Unit>());
+		return floatEq(lhs.value_, rhs.template value<Unit>());
 	}
 
 	template <class CompatibleUnitT>
 	friend constexpr bool operator!=(Value lhs, Value<CompatibleUnitT> rhs) {
-		return floatNE(lhs.value_, rhs.value<Unit>());
+		return floatNE(lhs.value_, rhs.template value<Unit>());
 	}
 
 	template <class CompatibleUnitT>
 	friend constexpr bool operator<(Value lhs, Value<CompatibleUnitT> rhs) {
-		return floatLT(lhs.value_, rhs.value<Unit>());
+		return floatLT(lhs.value_, rhs.template value<Unit>());
 	}
 
 	template <class CompatibleUnitT>
 	friend constexpr bool operator<=(Value lhs, Value<CompatibleUnitT> rhs) {
-		return floatLE(lhs.value_, rhs.value<Unit>());
+		return floatLE(lhs.value_, rhs.template value<Unit>());
 	}
 
 	template <class CompatibleUnitT>
 	friend constexpr bool operator>(Value lhs, Value<CompatibleUnitT> rhs) {
-		return floatGT(lhs.value_, rhs.value<Unit>());
+		return floatGT(lhs.value_, rhs.template value<Unit>());
 	}
 
 	template <class CompatibleUnitT>
 	friend constexpr bool operator>=(Value lhs, Value<CompatibleUnitT> rhs) {
-		return floatGE(lhs.value_, rhs.value<Unit>());
+		return floatGE(lhs.value_, rhs.template value<Unit>());
 	}
 
 	template <class CompatibleUnitT>
 	constexpr Value& operator+=(Value<CompatibleUnitT> other) {
-		value_ += other.value<Unit>();
+		value_ += other.template value<Unit>();
 		return *this;
 	}
 
@@ -238,7 +256,7 @@ public:
 
 	template <class CompatibleUnitT>
 	constexpr Value& operator-=(Value<CompatibleUnitT> other) {
-		value_ -= other.value<Unit>();
+		value_ -= other.template value<Unit>();
 		return *this;
 	}
 
@@ -255,8 +273,8 @@ public:
 
 	template <class OtherUnit>
 	friend constexpr auto operator*(Value lhs, Value<OtherUnit> rhs) {
-		using UnitProduct = decltype(decltype(lhs)::Unit{} * decltype(rhs)::Unit{});
-		return Value<UnitProduct>{UnitProduct{}, lhs.value_ * rhs.value<OtherUnit>()};
+		using UnitProduct = decltype(typename decltype(lhs)::Unit{} * typename decltype(rhs)::Unit{});
+		return Value<UnitProduct>{UnitProduct{}, lhs.value_ * rhs.template value<OtherUnit>()};
 	}
 
 	friend constexpr Value operator*(Value v, float scalar) {
@@ -274,8 +292,8 @@ public:
 
 	template <class OtherUnit>
 	friend constexpr auto operator/(Value lhs, Value<OtherUnit> rhs) {
-		using UnitQuotient = decltype(decltype(lhs)::Unit{} / decltype(rhs)::Unit{});
-		return Value<UnitQuotient>{UnitQuotient{}, lhs.value_ / rhs.value<OtherUnit>()};
+		using UnitQuotient = decltype(typename decltype(lhs)::Unit{} / typename decltype(rhs)::Unit{});
+		return Value<UnitQuotient>{UnitQuotient{}, lhs.value_ / rhs.template value<OtherUnit>()};
 	}
 
 	friend constexpr Value operator/(Value v, float scalar) {
@@ -286,10 +304,6 @@ public:
 		return Value{Unit{}, v.value_ / scalar};
 	}
 
-	friend inline std::ostream& operator<<(std::ostream& os, Value value) {
-		return os << value.value_ << Unit{};
-	}
-
 private:
 
     float value_;
@@ -305,10 +319,11 @@ using Distance = Value<Metres>;
 using Mass = Value<Kilograms>;
 using Time = Value<Seconds>;
 using Speed = Value<MPS>;
-// #TODO: acceleration and force are vectors, so it may not be the best idea to reserve
-// these names.
+// Acceleration and force are scalar magnitudes here - see Velocity, AccelerationVector and
+// ForceVector in Point.hpp for their directed counterparts.
 using Acceleration = Value<MPS2>;
 using Force = Value<Newtons>;
+using Energy = Value<Joules>;
 
 static_assert(sizeof(Distance) == sizeof(float));
 
@@ -346,6 +361,22 @@ inline constexpr Value<Grams> operator""_g(unsigned long long value) {
 	return Value<Grams>{Grams{}, static_cast<float>(value)};
 }
 
+inline constexpr Value<Nanoseconds> operator""_ns(long double value) {
+	return Value<Nanoseconds>{Nanoseconds{}, static_cast<float>(value)};
+}
+
+inline constexpr Value<Nanoseconds> operator""_ns(unsigned long long value) {
+	return Value<Nanoseconds>{Nanoseconds{}, static_cast<float>(value)};
+}
+
+inline constexpr Value<Microseconds> operator""_us(long double value) {
+	return Value<Microseconds>{Microseconds{}, static_cast<float>(value)};
+}
+
+inline constexpr Value<Microseconds> operator""_us(unsigned long long value) {
+	return Value<Microseconds>{Microseconds{}, static_cast<float>(value)};
+}
+
 inline constexpr Value<Milliseconds> operator""_ms(long double value) {
 	return Value<Milliseconds>{Milliseconds{}, static_cast<float>(value)};
 }
@@ -410,6 +441,14 @@ inline constexpr Value<Newtons> operator""_N(unsigned long long value) {
 	return Value<Newtons>{Newtons{}, static_cast<float>(value)};
 }
 
+inline constexpr Value<Joules> operator""_J(long double value) {
+	return Value<Joules>{Joules{}, static_cast<float>(value)};
+}
+
+inline constexpr Value<Joules> operator""_J(unsigned long long value) {
+	return Value<Joules>{Joules{}, static_cast<float>(value)};
+}
+
 } // namespace unit_literals
 
 } // namespace type_safety
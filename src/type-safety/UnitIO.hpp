@@ -0,0 +1,78 @@
+#pragma once
+
+#include <ostream>
+
+#include "Unit.hpp"
+
+namespace type_safety {
+
+inline std::ostream& operator<<(std::ostream& os, Dimensionless) {
+	return os;
+}
+
+inline std::ostream& operator<<(std::ostream& os, Metres) {
+	return os << "_m";
+}
+
+inline std::ostream& operator<<(std::ostream& os, Kilometres) {
+	return os << "_km";
+}
+
+inline std::ostream& operator<<(std::ostream& os, Kilograms) {
+	return os << "_kg";
+}
+
+inline std::ostream& operator<<(std::ostream& os, Grams) {
+	return os << "_g";
+}
+
+inline std::ostream& operator<<(std::ostream& os, Nanoseconds) {
+	return os << "_ns";
+}
+
+inline std::ostream& operator<<(std::ostream& os, Microseconds) {
+	return os << "_us";
+}
+
+inline std::ostream& operator<<(std::ostream& os, Milliseconds) {
+	return os << "_ms";
+}
+
+inline std::ostream& operator<<(std::ostream& os, Seconds) {
+	return os << "_s";
+}
+
+inline std::ostream& operator<<(std::ostream& os, Minutes) {
+	return os << "_min";
+}
+
+inline std::ostream& operator<<(std::ostream& os, Hours) {
+	return os << "_h";
+}
+
+inline std::ostream& operator<<(std::ostream& os, MPS) {
+	return os << "_m/s";
+}
+
+inline std::ostream& operator<<(std::ostream& os, KPH) {
+	return os << "_km/h";
+}
+
+inline std::ostream& operator<<(std::ostream& os, MPS2) {
+	return os << "_m/s2";
+}
+
+inline std::ostream& operator<<(std::ostream& os, Newtons) {
+	return os << "_N";
+}
+
+inline std::ostream& operator<<(std::ostream& os, Joules) {
+	return os << "_J";
+}
+
+template <class UnitT>
+std::ostream& operator<<(std::ostream& os, Value<UnitT> value) {
+	return os << value.template value<UnitT>() << UnitT{};
+}
+
+} // namespace type_safety
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
 
 namespace type_safety {
 
@@ -22,6 +23,54 @@ public:
 		return elements_[idx];
 	}
 
+	Vec3& operator+=(const Vec3& other) {
+		for (auto i = 0u; i < 3u; ++i) {
+			elements_[i] += other.elements_[i];
+		}
+		return *this;
+	}
+
+	friend Vec3 operator+(Vec3 lhs, const Vec3& rhs) {
+		return lhs += rhs;
+	}
+
+	Vec3& operator-=(const Vec3& other) {
+		for (auto i = 0u; i < 3u; ++i) {
+			elements_[i] -= other.elements_[i];
+		}
+		return *this;
+	}
+
+	friend Vec3 operator-(Vec3 lhs, const Vec3& rhs) {
+		return lhs -= rhs;
+	}
+
+	Vec3& operator*=(float scalar) {
+		for (auto& element : elements_) {
+			element *= scalar;
+		}
+		return *this;
+	}
+
+	friend Vec3 operator*(Vec3 v, float scalar) {
+		return v *= scalar;
+	}
+
+	friend Vec3 operator*(float scalar, Vec3 v) {
+		return v *= scalar;
+	}
+
+	Vec3& operator/=(float scalar) {
+		for (auto& element : elements_) {
+			element /= scalar;
+		}
+		return *this;
+	}
+
+	friend Vec3 operator/(Vec3 v, float scalar) {
+		return v /= scalar;
+	}
+
 private:
 
 	std::array<float, 3> elements_;
@@ -51,6 +100,54 @@ public:
 		return elements_[idx];
 	}
 
+	Vec4& operator+=(const Vec4& other) {
+		for (auto i = 0u; i < 4u; ++i) {
+			elements_[i] += other.elements_[i];
+		}
+		return *this;
+	}
+
+	friend Vec4 operator+(Vec4 lhs, const Vec4& rhs) {
+		return lhs += rhs;
+	}
+
+	Vec4& operator-=(const Vec4& other) {
+		for (auto i = 0u; i < 4u; ++i) {
+			elements_[i] -= other.elements_[i];
+		}
+		return *this;
+	}
+
+	friend Vec4 operator-(Vec4 lhs, const Vec4& rhs) {
+		return lhs -= rhs;
+	}
+
+	Vec4& operator*=(float scalar) {
+		for (auto& element : elements_) {
+			element *= scalar;
+		}
+		return *this;
+	}
+
+	friend Vec4 operator*(Vec4 v, float scalar) {
+		return v *= scalar;
+	}
+
+	friend Vec4 operator*(float scalar, Vec4 v) {
+		return v *= scalar;
+	}
+
+	Vec4& operator/=(float scalar) {
+		for (auto& element : elements_) {
+			element /= scalar;
+		}
+		return *this;
+	}
+
+	friend Vec4 operator/(Vec4 v, float scalar) {
+		return v /= scalar;
+	}
+
 private:
 
 	std::array<float, 4> elements_;
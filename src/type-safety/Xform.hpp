@@ -1,8 +1,10 @@
 #pragma once
 
+#include <cstddef>
 #include <type_traits>
 #include <stdexcept>
 
+#include "CompactPoint.hpp"
 #include "CompressedPair.hpp"
 #include "Matrix.hpp"
 #include "Point.hpp"
@@ -10,11 +12,24 @@
 
 namespace type_safety {
 
+namespace detail {
+
+// Keeps the space forwarding constructor from hijacking copies of non-const Xforms, and,
+// with EnableIfSpaceConstructible, conversions from other xform types.
+template <class XformT, class... SpaceParams>
+using EnableIfNotXform = std::enable_if_t<!(std::is_same_v<std::decay_t<SpaceParams>, XformT> || ...)>;
+
+} // namespace detail
+
 template <class FromSpaceT, class ToSpaceT>
 class Xform : CompressedPair<FromSpaceT, ToSpaceT> {
 public:
 
-	template <class... SpaceParams>
+	template <
+		class... SpaceParams,
+		class = detail::EnableIfNotXform<Xform, SpaceParams...>,
+		class = detail::EnableIfSpaceConstructible<CompressedPair<FromSpaceT, ToSpaceT>, SpaceParams...>
+		>
 	Xform(SpaceParams&&... spaceParams) :
 		CompressedPair<FromSpaceT, ToSpaceT>(std::forward<SpaceParams>(spaceParams)...)
 	{
@@ -27,20 +42,40 @@ public:
 	{
 	}
 
-	Point<ToSpaceT> apply(const Point<FromSpaceT>& p) const {
+	// The unit is preserved - the translation part of the matrix is assumed to be expressed
+	// in the unit of the transformed point.
+	template <class UnitT>
+	Point<ToSpaceT, UnitT> apply(const Point<FromSpaceT, UnitT>& p) const {
 		checkSpacesMatch(fromSpace(), p.space());
-		auto result = Point<ToSpaceT>{toSpace()};
+		auto result = Point<ToSpaceT, UnitT>{toSpace()};
 		multiplyAndSet(result.vector(), matrix_, p.vector());
 		return result;
 	}
 
-	Vector<ToSpaceT> apply(const Vector<FromSpaceT>& v) const {
+	template <class UnitT>
+	Vector<ToSpaceT, UnitT> apply(const Vector<FromSpaceT, UnitT>& v) const {
 		checkSpacesMatch(fromSpace(), v.space());
-		auto result = Vector<ToSpaceT>{toSpace()};
+		auto result = Vector<ToSpaceT, UnitT>{toSpace()};
 		multiplyAndSet(result.vector(), matrix_, v.vector());
 		return result;
 	}
 
+	template <class UnitT>
+	CompactPoint<ToSpaceT, UnitT> apply(const CompactPoint<FromSpaceT, UnitT>& p) const {
+		checkSpacesMatch(fromSpace(), p.space());
+		auto result = CompactPoint<ToSpaceT, UnitT>{toSpace()};
+		multiplyAffineAndSet(result.xyz(), matrix_, p.xyz(), 1.0f);
+		return result;
+	}
+
+	template <class UnitT>
+	CompactVector<ToSpaceT, UnitT> apply(const CompactVector<FromSpaceT, UnitT>& v) const {
+		checkSpacesMatch(fromSpace(), v.space());
+		auto result = CompactVector<ToSpaceT, UnitT>{toSpace()};
+		multiplyAffineAndSet(result.xyz(), matrix_, v.xyz(), 0.0f);
+		return result;
+	}
+
 	decltype(auto) fromSpace() const {
 		return CompressedPair<FromSpaceT, ToSpaceT>::first();
 	}
@@ -63,6 +98,11 @@ private:
 
 };
 
+// Empty spaces are free and Xform arrays may be relocated with memcpy.
+static_assert(sizeof(Xform<space::World, space::Camera>) == sizeof(Matrix));
+static_assert(std::is_trivially_copyable_v<Xform<space::World, space::Camera>>);
+static_assert(std::is_trivially_copyable_v<Xform<space::PlayerAtFrame, space::World>>);
+
 template <class FromSpace, class ToSpace>
 inline auto makeXform(FromSpace fromSpace, ToSpace toSpace) {
 	return Xform<FromSpace, ToSpace>{std::move(fromSpace), std::move(toSpace)};
@@ -73,6 +113,56 @@ inline auto makeXform(Matrix matrix, FromSpace fromSpace, ToSpace toSpace) {
 	return Xform<FromSpace, ToSpace>{std::move(matrix), std::move(fromSpace), std::move(toSpace)};
 }
 
+namespace detail {
+
+template <class FromSpaceT, class ToSpaceT, class FromElementT, class ToElementT>
+inline void applyAllCompact(
+	const Xform<FromSpaceT, ToSpaceT>& xform,
+	const FromElementT* elements,
+	std::size_t count,
+	ToElementT* results
+) {
+	if constexpr (std::is_empty_v<FromSpaceT> && std::is_empty_v<ToSpaceT>) {
+		static_assert(sizeof(FromElementT) == 3 * sizeof(float) && sizeof(ToElementT) == 3 * sizeof(float));
+		checkSpacesMatch(xform.fromSpace(), FromSpaceT{});
+		multiplyAffinePacked(
+			xform.matrix(),
+			FromElementT::W,
+			reinterpret_cast<const float*>(elements),
+			count,
+			reinterpret_cast<float*>(results)
+			);
+	} else {
+		// Spaces with run-time state are stored in every element
+		for (auto i = std::size_t{0}; i < count; ++i) {
+			results[i] = xform.apply(elements[i]);
+		}
+	}
+}
+
+} // namespace detail
+
+// results[i] = xform.apply(points[i]), four points at a time.
+template <class FromSpaceT, class ToSpaceT, class UnitT>
+inline void applyAll(
+	const Xform<FromSpaceT, ToSpaceT>& xform,
+	const CompactPoint<FromSpaceT, UnitT>* points,
+	std::size_t count,
+	CompactPoint<ToSpaceT, UnitT>* results
+) {
+	detail::applyAllCompact(xform, points, count, results);
+}
+
+template <class FromSpaceT, class ToSpaceT, class UnitT>
+inline void applyAll(
+	const Xform<FromSpaceT, ToSpaceT>& xform,
+	const CompactVector<FromSpaceT, UnitT>* vectors,
+	std::size_t count,
+	CompactVector<ToSpaceT, UnitT>* results
+) {
+	detail::applyAllCompact(xform, vectors, count, results);
+}
+
 template <class LhsFromSpaceT, class LhsToSpaceT, class RhsFromSpaceT, class RhsToSpaceT>
 inline auto inSequence(
 	const Xform<LhsFromSpaceT, LhsToSpaceT>& lhs,
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+
+#include "Seqlock.hpp"
+#include "Xform.hpp"
+
+namespace type_safety {
+
+namespace detail {
+
+// Elementwise - close enough for the small rotations between consecutive frames, but the result
+// isn't orthonormalized.
+inline Matrix lerp(const Matrix& from, const Matrix& to, float t) {
+	auto result = Matrix{};
+	for (auto row = 0u; row < 4u; ++row) {
+		for (auto column = 0u; column < 4u; ++column) {
+			const auto start = from.get(row, column);
+			result.get(row, column) = start + (to.get(row, column) - start) * t;
+		}
+	}
+	return result;
+}
+
+} // namespace detail
+
+// The last frames' Xforms of a player, for lag compensation:
+//
+//   history.record(frameId, physics.playerXform());
+//   ...
+//   if (const auto xform = history.interpolated(shot.frame)) {
+//       checkHit(xform->apply(shot.position));
+//   }
+//
+// Frame f lives in slot f % capacity, so recording a frame evicts the one capacity frames older
+// in place and lookups are a single slot access. Slots are seqlocks written by one thread.
+// Lookups are wait-free: one racing with the write of its slot - the frame being recorded or
+// evicted right now - reports the frame missing instead of retrying.
+template <class ToSpaceT = space::World>
+class XformHistory {
+public:
+
+	using XformType = Xform<space::PlayerAtFrame, ToSpaceT>;
+
+	// Rounded up to a power of two.
+	explicit XformHistory(std::size_t capacity) :
+		capacity_(roundUpToPowerOfTwo(capacity)),
+		slots_(std::make_unique<Slot[]>(capacity_))
+	{
+		for (auto slot = std::size_t{0}; slot < capacity_; ++slot) {
+			slots_[slot].write(Frame{NO_FRAME, Matrix{}});
+		}
+	}
+
+	XformHistory(const XformHistory&) = delete;
+
+	XformHistory& operator=(const XformHistory&) = delete;
+
+	std::size_t capacity() const {
+		return capacity_;
+	}
+
+	void record(int frameId, const Matrix& matrix) {
+		slot(frameId).write(Frame{frameId, matrix});
+		latestFrame_.store(frameId, std::memory_order_release);
+	}
+
+	void record(int frameId, const XformType& xform) {
+		record(frameId, xform.matrix());
+	}
+
+	// The last frame recorded, if any.
+	std::optional<int> latestFrame() const {
+		const auto frameId = latestFrame_.load(std::memory_order_acquire);
+		return frameId == NO_FRAME ? std::nullopt : std::optional<int>{frameId};
+	}
+
+	std::optional<XformType> at(int frameId) const {
+		if (const auto matrix = matrixAt(frameId)) {
+			return XformType{*matrix, space::PlayerAtFrame{frameId}, ToSpaceT{}};
+		}
+		return std::nullopt;
+	}
+
+	// The xform at a fractional frame, interpolated between the frames around it, which both
+	// have to be in the history. The space is that of the earlier frame.
+	std::optional<XformType> interpolated(float frame) const {
+		const auto earlierFrame = std::floor(frame);
+		const auto frameId = static_cast<int>(earlierFrame);
+		const auto t = frame - earlierFrame;
+
+		const auto earlier = matrixAt(frameId);
+		if (!earlier) {
+			return std::nullopt;
+		}
+		if (t == 0.0f) {
+			return XformType{*earlier, space::PlayerAtFrame{frameId}, ToSpaceT{}};
+		}
+
+		const auto later = matrixAt(frameId + 1);
+		if (!later) {
+			return std::nullopt;
+		}
+		return XformType{detail::lerp(*earlier, *later, t), space::PlayerAtFrame{frameId}, ToSpaceT{}};
+	}
+
+private:
+
+	static constexpr auto NO_FRAME = std::numeric_limits<int>::min();
+
+	struct Frame {
+		int frameId;
+		Matrix matrix;
+	};
+
+	using Slot = detail::Seqlock<Frame>;
+
+	std::size_t capacity_;
+
+	std::unique_ptr<Slot[]> slots_;
+
+	std::atomic<int> latestFrame_ = {NO_FRAME};
+
+	static std::size_t roundUpToPowerOfTwo(std::size_t value) {
+		auto result = std::size_t{1};
+		while (result < value) {
+			result *= 2;
+		}
+		return result;
+	}
+
+	Slot& slot(int frameId) {
+		return slots_[static_cast<std::uint32_t>(frameId) & (capacity_ - 1)];
+	}
+
+	const Slot& slot(int frameId) const {
+		return slots_[static_cast<std::uint32_t>(frameId) & (capacity_ - 1)];
+	}
+
+	std::optional<Matrix> matrixAt(int frameId) const {
+		auto frame = Frame{};
+		if (!slot(frameId).tryRead(frame) || frame.frameId != frameId) {
+			return std::nullopt;
+		}
+		return frame.matrix;
+	}
+
+};
+
+} // namespace type_safety
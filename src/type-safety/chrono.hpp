@@ -0,0 +1,26 @@
+#pragma once
+
+#include <chrono>
+
+#include "Unit.hpp"
+
+namespace type_safety {
+
+// Conversions between time values and std::chrono durations. Both are a single number scaled
+// by a compile-time ratio, so a conversion keeping the ratio is a plain copy:
+//
+//   const auto frameTime = fromDuration(end - begin); // Value<TimeUnit<clock period>>
+//   std::this_thread::sleep_for(toDuration(16_ms));   // duration<float, std::milli>
+
+template <class RepT, class PeriodT>
+constexpr Value<TimeUnit<PeriodT>> fromDuration(std::chrono::duration<RepT, PeriodT> duration) {
+	return Value<TimeUnit<PeriodT>>{TimeUnit<PeriodT>{}, static_cast<float>(duration.count())};
+}
+
+template <class UnitT>
+constexpr std::chrono::duration<float, typename UnitT::Scale> toDuration(Value<UnitT> value) {
+	static_assert(UnitT::template IS_CONVERTIBLE_TO<Seconds>, "Only time values convert to durations");
+	return std::chrono::duration<float, typename UnitT::Scale>{value.template value<UnitT>()};
+}
+
+} // namespace type_safety
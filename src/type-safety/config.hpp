@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+
 namespace type_safety {
 
 #ifdef _FLOAT_EQ_EPSILON
@@ -8,4 +10,17 @@ constexpr const auto FLOAT_EQ_EPSILON = _FLOAT_EQ_EPSILON;
 constexpr const auto FLOAT_EQ_EPSILON = 0.0001f;
 #endif /* _FLOAT_EQ_EPSILON */
 
+// For the small packet functions compilers would otherwise leave out of line in wide kernels,
+// which then pass their operands through the stack.
+#if defined(_MSC_VER)
+#	define TYPE_SAFETY_FORCE_INLINE __forceinline
+#elif defined(__GNUC__)
+#	define TYPE_SAFETY_FORCE_INLINE inline __attribute__((always_inline))
+#else
+#	define TYPE_SAFETY_FORCE_INLINE inline
+#endif /* _MSC_VER */
+
+// Alignment keeping data written by different threads on separate cache lines
+constexpr const auto CACHE_LINE_SIZE = std::size_t{64};
+
 } // namespace type_safety
@@ -4,7 +4,7 @@
 
 namespace type_safety {
 
-constexpr auto PI = 3.141592f;
+constexpr auto PI = 3.14159265f;
 
 inline constexpr bool floatLT(float lhs, float rhs) {
     return lhs < rhs - FLOAT_EQ_EPSILON;
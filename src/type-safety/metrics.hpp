@@ -0,0 +1,199 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ratio>
+#include <thread>
+
+#include "Unit.hpp"
+#include "config.hpp"
+
+namespace type_safety {
+
+namespace detail {
+
+// Threads are numbered in order of their first metric update and spread over the shards
+// round-robin, so up to shard count threads never share a cache line.
+inline std::size_t metricThreadIndex() {
+	static auto nextThread = std::atomic<std::size_t>{0};
+	thread_local const auto thread = nextThread.fetch_add(1, std::memory_order_relaxed);
+	return thread;
+}
+
+inline std::size_t defaultMetricShardCount() {
+	const auto threads = std::max(std::thread::hardware_concurrency(), 1u);
+	auto shards = std::size_t{1};
+	while (shards < threads) {
+		shards *= 2;
+	}
+	return shards;
+}
+
+// A fixed-point sum split into cache-line sized shards. Updates are a single uncontended
+// fetch_add on the caller's shard, reads add all shards up.
+class ShardedSum {
+public:
+
+	explicit ShardedSum(std::size_t shardCount) :
+		shards_(std::make_unique<Shard[]>(shardCount)),
+		mask_(shardCount - 1)
+	{
+		assert(shardCount != 0 && (shardCount & mask_) == 0);
+	}
+
+	void add(std::int64_t quanta) {
+		shards_[metricThreadIndex() & mask_].quanta.fetch_add(quanta, std::memory_order_relaxed);
+	}
+
+	std::int64_t sum() const {
+		auto result = std::int64_t{0};
+		for (auto shard = std::size_t{0}; shard <= mask_; ++shard) {
+			result += shards_[shard].quanta.load(std::memory_order_relaxed);
+		}
+		return result;
+	}
+
+	void set(std::int64_t quanta) {
+		for (auto shard = std::size_t{1}; shard <= mask_; ++shard) {
+			shards_[shard].quanta.store(0, std::memory_order_relaxed);
+		}
+		shards_[0].quanta.store(quanta, std::memory_order_relaxed);
+	}
+
+	std::size_t shardCount() const {
+		return mask_ + 1;
+	}
+
+private:
+
+	struct alignas(CACHE_LINE_SIZE) Shard {
+		std::atomic<std::int64_t> quanta = {0};
+	};
+
+	std::unique_ptr<Shard[]> shards_;
+
+	std::size_t mask_;
+
+};
+
+template <class UnitT, class QuantumT>
+std::int64_t toQuanta(Value<UnitT> value) {
+	return std::llround(static_cast<double>(value.template value<UnitT>()) * QuantumT::den / QuantumT::num);
+}
+
+template <class UnitT, class QuantumT>
+Value<UnitT> fromQuanta(std::int64_t quanta) {
+	return makeValue<UnitT>(static_cast<float>(static_cast<double>(quanta) * QuantumT::num / QuantumT::den));
+}
+
+} // namespace detail
+
+// Sum of unit values updated from many threads, e.g. the distance travelled by all the
+// simulation workers. Values are accumulated as whole multiples of QuantumT units in 64-bit
+// integers - micro-units by default, which keeps totals exact up to 9.2 * 10^12 units, where a
+// float would have stopped counting small additions at 1.6 * 10^7 of them.
+//
+//   static auto distanceTravelled = Counter<Metres>{};
+//   distanceTravelled.add(speed * dt);
+//   log(distanceTravelled.value());
+template <class UnitT, class QuantumT = std::micro>
+class Counter {
+public:
+
+	using Unit = UnitT;
+
+	using Quantum = QuantumT;
+
+	explicit Counter(std::size_t shardCount = detail::defaultMetricShardCount()) :
+		sum_(shardCount)
+	{
+	}
+
+	Counter(const Counter&) = delete;
+
+	Counter& operator=(const Counter&) = delete;
+
+	// Counters only go up, see Gauge for values that can also go down.
+	template <class CompatibleUnitT>
+	void add(Value<CompatibleUnitT> increment) {
+		const auto quanta = detail::toQuanta<UnitT, QuantumT>(increment);
+		assert(quanta >= 0);
+		sum_.add(quanta);
+	}
+
+	// Merges the shards. Increments made concurrently may or may not be included.
+	Value<UnitT> value() const {
+		return detail::fromQuanta<UnitT, QuantumT>(sum_.sum());
+	}
+
+	void reset() {
+		sum_.set(0);
+	}
+
+	std::size_t shardCount() const {
+		return sum_.shardCount();
+	}
+
+private:
+
+	detail::ShardedSum sum_;
+
+};
+
+// Current amount of something updated from many threads, e.g. the mass in transit, which
+// goes up when loaded and down when unloaded. Stored like Counter.
+template <class UnitT, class QuantumT = std::micro>
+class Gauge {
+public:
+
+	using Unit = UnitT;
+
+	using Quantum = QuantumT;
+
+	explicit Gauge(std::size_t shardCount = detail::defaultMetricShardCount()) :
+		sum_(shardCount)
+	{
+	}
+
+	Gauge(const Gauge&) = delete;
+
+	Gauge& operator=(const Gauge&) = delete;
+
+	template <class CompatibleUnitT>
+	void add(Value<CompatibleUnitT> delta) {
+		sum_.add(detail::toQuanta<UnitT, QuantumT>(delta));
+	}
+
+	template <class CompatibleUnitT>
+	void subtract(Value<CompatibleUnitT> delta) {
+		sum_.add(-detail::toQuanta<UnitT, QuantumT>(delta));
+	}
+
+	// Updates racing with set() count as made either before or after it, but readers may see
+	// the shards partially reset while it runs.
+	template <class CompatibleUnitT>
+	void set(Value<CompatibleUnitT> value) {
+		sum_.set(detail::toQuanta<UnitT, QuantumT>(value));
+	}
+
+	// Merges the shards. Updates made concurrently may or may not be included.
+	Value<UnitT> value() const {
+		return detail::fromQuanta<UnitT, QuantumT>(sum_.sum());
+	}
+
+	std::size_t shardCount() const {
+		return sum_.shardCount();
+	}
+
+private:
+
+	detail::ShardedSum sum_;
+
+};
+
+} // namespace type_safety
@@ -0,0 +1,528 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "Angle.hpp"
+#include "CompactPoint.hpp"
+#include "Unit.hpp"
+#include "VecN.hpp"
+#include "Xform.hpp"
+#include "simd.hpp"
+#include "space.hpp"
+
+namespace type_safety {
+
+// W lanes of Values, Angles, Vec3s, Points and Vectors, for hand-written loops that would
+// otherwise unwrap to raw intrinsics and lose their units and spaces:
+//
+//   for (auto i = std::size_t{0}; i + 8 <= count; i += 8) {
+//       const auto v = ValueN<MPS, 8>::load(speeds + i);
+//       (ValueN<Kilograms, 8>::load(masses + i) * v * v * 0.5f).store(energies + i);
+//   }
+//
+// Units and spaces are checked at compile time as for the scalar types, and the packets are
+// simd::FloatN underneath, which compiles to AVX or SSE2 instructions or, without either, to
+// scalar code. Loads and stores take arrays of the scalar types; Vec3s, Points and Vectors
+// are also kept as Vec3Blocks - W xs, W ys, then W zs - which load without shuffles.
+
+template <std::size_t W>
+using FloatN = simd::FloatN<W>;
+
+namespace detail {
+
+template <class FromUnitT, class ToUnitT, std::size_t W>
+inline FloatN<W> convertPacket(const FloatN<W>& values) {
+	static_assert(FromUnitT::template IS_CONVERTIBLE_TO<ToUnitT>, "Units are not convertible");
+	if constexpr (FromUnitT::template IS_IDENTITY_CONVERSION_TO<ToUnitT>) {
+		return values;
+	} else {
+		return values * FloatN<W>{FromUnitT{}.template convertTo<ToUnitT>(1.0f)};
+	}
+}
+
+template <class ScalarT>
+inline const float* floatData(const ScalarT* scalars) {
+	static_assert(sizeof(ScalarT) == sizeof(float) && std::is_standard_layout_v<ScalarT>);
+	return reinterpret_cast<const float*>(scalars);
+}
+
+template <class ScalarT>
+inline float* floatData(ScalarT* scalars) {
+	static_assert(sizeof(ScalarT) == sizeof(float) && std::is_standard_layout_v<ScalarT>);
+	return reinterpret_cast<float*>(scalars);
+}
+
+} // namespace detail
+
+template <class UnitT, std::size_t W>
+class ValueN {
+public:
+
+	using Unit = UnitT;
+
+	static constexpr auto WIDTH = W;
+
+	ValueN() = default;
+
+	template <class CompatibleUnitT>
+	ValueN(CompatibleUnitT, const FloatN<W>& values) :
+		values_(detail::convertPacket<CompatibleUnitT, UnitT>(values))
+	{
+	}
+
+	// Every lane set to value.
+	template <class CompatibleUnitT>
+	ValueN(Value<CompatibleUnitT> value) :
+		values_(value.template value<UnitT>())
+	{
+	}
+
+	template <class CompatibleUnitT>
+	ValueN(const ValueN<CompatibleUnitT, W>& compatibleValues) :
+		values_(compatibleValues.template values<UnitT>())
+	{
+	}
+
+	static ValueN load(const Value<UnitT>* source) {
+		return ValueN{UnitT{}, FloatN<W>::load(detail::floatData(source))};
+	}
+
+	void store(Value<UnitT>* target) const {
+		values_.store(detail::floatData(target));
+	}
+
+	template <class CompatibleUnitT>
+	FloatN<W> values() const {
+		return detail::convertPacket<UnitT, CompatibleUnitT>(values_);
+	}
+
+	Value<UnitT> get(std::size_t lane) const {
+		return makeValue<UnitT>(values_.get(lane));
+	}
+
+	template <class CompatibleUnitT>
+	friend ValueN operator+(const ValueN& lhs, const ValueN<CompatibleUnitT, W>& rhs) {
+		return ValueN{UnitT{}, lhs.values_ + rhs.template values<UnitT>()};
+	}
+
+	template <class CompatibleUnitT>
+	friend ValueN operator-(const ValueN& lhs, const ValueN<CompatibleUnitT, W>& rhs) {
+		return ValueN{UnitT{}, lhs.values_ - rhs.template values<UnitT>()};
+	}
+
+	friend ValueN operator-(const ValueN& v) {
+		return ValueN{UnitT{}, -v.values_};
+	}
+
+	template <class OtherUnitT>
+	friend auto operator*(const ValueN& lhs, const ValueN<OtherUnitT, W>& rhs) {
+		using UnitProduct = decltype(UnitT{} * OtherUnitT{});
+		return ValueN<UnitProduct, W>{UnitProduct{}, lhs.values_ * rhs.template values<OtherUnitT>()};
+	}
+
+	template <class OtherUnitT>
+	friend auto operator/(const ValueN& lhs, const ValueN<OtherUnitT, W>& rhs) {
+		using UnitQuotient = decltype(UnitT{} / OtherUnitT{});
+		return ValueN<UnitQuotient, W>{UnitQuotient{}, lhs.values_ / rhs.template values<OtherUnitT>()};
+	}
+
+	friend ValueN operator*(const ValueN& v, float scalar) {
+		return ValueN{UnitT{}, v.values_ * FloatN<W>{scalar}};
+	}
+
+	friend ValueN operator*(float scalar, const ValueN& v) {
+		return v * scalar;
+	}
+
+	friend ValueN operator/(const ValueN& v, float scalar) {
+		return ValueN{UnitT{}, v.values_ / FloatN<W>{scalar}};
+	}
+
+private:
+
+	FloatN<W> values_;
+
+};
+
+template <std::size_t W>
+class AngleN {
+public:
+
+	static constexpr auto WIDTH = W;
+
+	AngleN() = default;
+
+	AngleN(RadiansTag, const FloatN<W>& radians) :
+		radians_(radians)
+	{
+	}
+
+	// Every lane set to angle.
+	AngleN(Angle angle) :
+		radians_(angle.radians())
+	{
+	}
+
+	static AngleN load(const Angle* source) {
+		return AngleN{radiansTag, FloatN<W>::load(detail::floatData(source))};
+	}
+
+	void store(Angle* target) const {
+		radians_.store(detail::floatData(target));
+	}
+
+	const FloatN<W>& radians() const {
+		return radians_;
+	}
+
+	Angle get(std::size_t lane) const {
+		return Angle{radiansTag, radians_.get(lane)};
+	}
+
+	friend AngleN operator+(const AngleN& lhs, const AngleN& rhs) {
+		return AngleN{radiansTag, lhs.radians_ + rhs.radians_};
+	}
+
+	friend AngleN operator-(const AngleN& lhs, const AngleN& rhs) {
+		return AngleN{radiansTag, lhs.radians_ - rhs.radians_};
+	}
+
+	friend AngleN operator-(const AngleN& a) {
+		return AngleN{radiansTag, -a.radians_};
+	}
+
+	friend AngleN operator*(const AngleN& a, float scalar) {
+		return AngleN{radiansTag, a.radians_ * FloatN<W>{scalar}};
+	}
+
+	friend AngleN operator*(float scalar, const AngleN& a) {
+		return a * scalar;
+	}
+
+	// Lane-wise scaling, e.g. by per-lane interpolation factors.
+	friend AngleN operator*(const AngleN& a, const FloatN<W>& scalars) {
+		return AngleN{radiansTag, a.radians_ * scalars};
+	}
+
+	friend AngleN operator/(const AngleN& a, float scalar) {
+		return AngleN{radiansTag, a.radians_ / FloatN<W>{scalar}};
+	}
+
+private:
+
+	FloatN<W> radians_;
+
+};
+
+static_assert(sizeof(Angle) == sizeof(float) && std::is_standard_layout_v<Angle>);
+
+// W Vec3s as structures of arrays - an AoSoA array of these keeps whole packets contiguous.
+template <std::size_t W>
+struct Vec3Block {
+	std::array<float, W> x;
+	std::array<float, W> y;
+	std::array<float, W> z;
+};
+
+template <std::size_t W>
+class Vec3N {
+public:
+
+	static constexpr auto WIDTH = W;
+
+	Vec3N() = default;
+
+	Vec3N(const FloatN<W>& x, const FloatN<W>& y, const FloatN<W>& z) :
+		x_(x),
+		y_(y),
+		z_(z)
+	{
+	}
+
+	// Every lane set to v.
+	Vec3N(const Vec3& v) :
+		x_(v.get(0)),
+		y_(v.get(1)),
+		z_(v.get(2))
+	{
+	}
+
+	static Vec3N load(const Vec3Block<W>& block) {
+		return Vec3N{FloatN<W>::load(block.x.data()), FloatN<W>::load(block.y.data()), FloatN<W>::load(block.z.data())};
+	}
+
+	void store(Vec3Block<W>& block) const {
+		x_.store(block.x.data());
+		y_.store(block.y.data());
+		z_.store(block.z.data());
+	}
+
+	// W packed xyz triples, e.g. the coordinates of CompactPoints.
+	static Vec3N loadInterleaved(const float* source) {
+		auto block = Vec3Block<W>{};
+		for (auto lane = std::size_t{0}; lane < W; lane += simd::LANES) {
+			auto x = simd::Float4{};
+			auto y = simd::Float4{};
+			auto z = simd::Float4{};
+			simd::loadInterleaved3(source + 3 * lane, x, y, z);
+			x.store(block.x.data() + lane);
+			y.store(block.y.data() + lane);
+			z.store(block.z.data() + lane);
+		}
+		return load(block);
+	}
+
+	void storeInterleaved(float* target) const {
+		auto block = Vec3Block<W>{};
+		store(block);
+		for (auto lane = std::size_t{0}; lane < W; lane += simd::LANES) {
+			simd::storeInterleaved3(
+				simd::Float4::load(block.x.data() + lane),
+				simd::Float4::load(block.y.data() + lane),
+				simd::Float4::load(block.z.data() + lane),
+				target + 3 * lane
+				);
+		}
+	}
+
+	const FloatN<W>& x() const {
+		return x_;
+	}
+
+	const FloatN<W>& y() const {
+		return y_;
+	}
+
+	const FloatN<W>& z() const {
+		return z_;
+	}
+
+	Vec3 get(std::size_t lane) const {
+		return Vec3{x_.get(lane), y_.get(lane), z_.get(lane)};
+	}
+
+	friend Vec3N operator+(const Vec3N& lhs, const Vec3N& rhs) {
+		return Vec3N{lhs.x_ + rhs.x_, lhs.y_ + rhs.y_, lhs.z_ + rhs.z_};
+	}
+
+	friend Vec3N operator-(const Vec3N& lhs, const Vec3N& rhs) {
+		return Vec3N{lhs.x_ - rhs.x_, lhs.y_ - rhs.y_, lhs.z_ - rhs.z_};
+	}
+
+	friend Vec3N operator*(const Vec3N& v, const FloatN<W>& scalars) {
+		return Vec3N{v.x_ * scalars, v.y_ * scalars, v.z_ * scalars};
+	}
+
+	friend Vec3N operator/(const Vec3N& v, const FloatN<W>& scalars) {
+		return Vec3N{v.x_ / scalars, v.y_ / scalars, v.z_ / scalars};
+	}
+
+	friend FloatN<W> dot(const Vec3N& lhs, const Vec3N& rhs) {
+		return lhs.x_ * rhs.x_ + lhs.y_ * rhs.y_ + lhs.z_ * rhs.z_;
+	}
+
+	// (matrix * (v, w)).xyz in every lane, see multiplyAffineAndSet. Forced inline, as at -O2
+	// compilers otherwise call it out of line for the wider packets, spilling v to the stack.
+	friend TYPE_SAFETY_FORCE_INLINE Vec3N multiplyAffine(const Matrix& matrix, const Vec3N& v, float w) {
+		return Vec3N{
+			v.x_ * FloatN<W>{matrix.get(0, 0)} + v.y_ * FloatN<W>{matrix.get(0, 1)} + v.z_ * FloatN<W>{matrix.get(0, 2)} +
+				FloatN<W>{matrix.get(0, 3) * w},
+			v.x_ * FloatN<W>{matrix.get(1, 0)} + v.y_ * FloatN<W>{matrix.get(1, 1)} + v.z_ * FloatN<W>{matrix.get(1, 2)} +
+				FloatN<W>{matrix.get(1, 3) * w},
+			v.x_ * FloatN<W>{matrix.get(2, 0)} + v.y_ * FloatN<W>{matrix.get(2, 1)} + v.z_ * FloatN<W>{matrix.get(2, 2)} +
+				FloatN<W>{matrix.get(2, 3) * w}
+			};
+	}
+
+private:
+
+	FloatN<W> x_;
+
+	FloatN<W> y_;
+
+	FloatN<W> z_;
+
+};
+
+// W points or vectors of one space and unit. Spaces with run-time state are shared by all lanes.
+template <class SpaceT, class UnitT, std::size_t W>
+class VectorN : SpaceT {
+public:
+
+	using Space = SpaceT;
+	using Unit = UnitT;
+
+	static constexpr auto WIDTH = W;
+
+	template <class... SpaceParams>
+	VectorN(Vec3N<W> xyz, SpaceParams&&... spaceParams) :
+		SpaceT(std::forward<SpaceParams>(spaceParams)...),
+		xyz_(std::move(xyz))
+	{
+	}
+
+	template <class CompatibleUnitT>
+	VectorN(const VectorN<SpaceT, CompatibleUnitT, W>& compatibleVectors) :
+		SpaceT(compatibleVectors.space()),
+		xyz_(compatibleVectors.xyz() * detail::convertPacket<CompatibleUnitT, UnitT>(FloatN<W>{1.0f}))
+	{
+	}
+
+	// source[0, W), which must all be in this space.
+	static VectorN load(const CompactVector<SpaceT, UnitT>* source) {
+		static_assert(sizeof(CompactVector<SpaceT, UnitT>) == 3 * sizeof(float));
+		return VectorN{Vec3N<W>::loadInterleaved(reinterpret_cast<const float*>(source)), source->space()};
+	}
+
+	void store(CompactVector<SpaceT, UnitT>* target) const {
+		static_assert(sizeof(CompactVector<SpaceT, UnitT>) == 3 * sizeof(float));
+		xyz_.storeInterleaved(reinterpret_cast<float*>(target));
+	}
+
+	decltype(auto) space() const {
+		if constexpr (std::is_empty_v<SpaceT>) {
+			return SpaceT{};
+		} else {
+			return static_cast<const SpaceT&>(*this);
+		}
+	}
+
+	const Vec3N<W>& xyz() const {
+		return xyz_;
+	}
+
+	CompactVector<SpaceT, UnitT> get(std::size_t lane) const {
+		return CompactVector<SpaceT, UnitT>{xyz_.get(lane), space()};
+	}
+
+private:
+
+	Vec3N<W> xyz_;
+
+};
+
+template <class SpaceT, class UnitT, std::size_t W>
+class PointN : SpaceT {
+public:
+
+	using Space = SpaceT;
+	using Unit = UnitT;
+
+	static constexpr auto WIDTH = W;
+
+	template <class... SpaceParams>
+	PointN(Vec3N<W> xyz, SpaceParams&&... spaceParams) :
+		SpaceT(std::forward<SpaceParams>(spaceParams)...),
+		xyz_(std::move(xyz))
+	{
+	}
+
+	template <class CompatibleUnitT>
+	PointN(const PointN<SpaceT, CompatibleUnitT, W>& compatiblePoints) :
+		SpaceT(compatiblePoints.space()),
+		xyz_(compatiblePoints.xyz() * detail::convertPacket<CompatibleUnitT, UnitT>(FloatN<W>{1.0f}))
+	{
+	}
+
+	// source[0, W), which must all be in this space.
+	static PointN load(const CompactPoint<SpaceT, UnitT>* source) {
+		static_assert(sizeof(CompactPoint<SpaceT, UnitT>) == 3 * sizeof(float));
+		return PointN{Vec3N<W>::loadInterleaved(reinterpret_cast<const float*>(source)), source->space()};
+	}
+
+	void store(CompactPoint<SpaceT, UnitT>* target) const {
+		static_assert(sizeof(CompactPoint<SpaceT, UnitT>) == 3 * sizeof(float));
+		xyz_.storeInterleaved(reinterpret_cast<float*>(target));
+	}
+
+	decltype(auto) space() const {
+		if constexpr (std::is_empty_v<SpaceT>) {
+			return SpaceT{};
+		} else {
+			return static_cast<const SpaceT&>(*this);
+		}
+	}
+
+	const Vec3N<W>& xyz() const {
+		return xyz_;
+	}
+
+	CompactPoint<SpaceT, UnitT> get(std::size_t lane) const {
+		return CompactPoint<SpaceT, UnitT>{xyz_.get(lane), space()};
+	}
+
+private:
+
+	Vec3N<W> xyz_;
+
+};
+
+// As for Point and Vector, mixed units yield the unit of the left-hand side, or of the point.
+
+template <class SpaceT, class LhsUnitT, class RhsUnitT, std::size_t W>
+inline VectorN<SpaceT, LhsUnitT, W> operator+(const VectorN<SpaceT, LhsUnitT, W>& lhs, const VectorN<SpaceT, RhsUnitT, W>& rhs) {
+	checkSpacesMatch(lhs.space(), rhs.space());
+	return VectorN<SpaceT, LhsUnitT, W>{lhs.xyz() + VectorN<SpaceT, LhsUnitT, W>{rhs}.xyz(), lhs.space()};
+}
+
+template <class SpaceT, class LhsUnitT, class RhsUnitT, std::size_t W>
+inline VectorN<SpaceT, LhsUnitT, W> operator-(const VectorN<SpaceT, LhsUnitT, W>& lhs, const VectorN<SpaceT, RhsUnitT, W>& rhs) {
+	checkSpacesMatch(lhs.space(), rhs.space());
+	return VectorN<SpaceT, LhsUnitT, W>{lhs.xyz() - VectorN<SpaceT, LhsUnitT, W>{rhs}.xyz(), lhs.space()};
+}
+
+template <class SpaceT, class UnitT, std::size_t W>
+inline VectorN<SpaceT, UnitT, W> operator*(const VectorN<SpaceT, UnitT, W>& v, float scalar) {
+	return VectorN<SpaceT, UnitT, W>{v.xyz() * FloatN<W>{scalar}, v.space()};
+}
+
+template <class SpaceT, class UnitT, class ValueUnitT, std::size_t W>
+inline auto operator*(const VectorN<SpaceT, UnitT, W>& v, const ValueN<ValueUnitT, W>& values) {
+	using UnitProduct = decltype(UnitT{} * ValueUnitT{});
+	return VectorN<SpaceT, UnitProduct, W>{v.xyz() * values.template values<ValueUnitT>(), v.space()};
+}
+
+template <class SpaceT, class LhsUnitT, class RhsUnitT, std::size_t W>
+inline auto dot(const VectorN<SpaceT, LhsUnitT, W>& lhs, const VectorN<SpaceT, RhsUnitT, W>& rhs) {
+	checkSpacesMatch(lhs.space(), rhs.space());
+	using UnitProduct = decltype(LhsUnitT{} * RhsUnitT{});
+	return ValueN<UnitProduct, W>{UnitProduct{}, dot(lhs.xyz(), rhs.xyz())};
+}
+
+template <class SpaceT, class LhsUnitT, class RhsUnitT, std::size_t W>
+inline VectorN<SpaceT, LhsUnitT, W> operator-(const PointN<SpaceT, LhsUnitT, W>& lhs, const PointN<SpaceT, RhsUnitT, W>& rhs) {
+	checkSpacesMatch(lhs.space(), rhs.space());
+	return VectorN<SpaceT, LhsUnitT, W>{lhs.xyz() - PointN<SpaceT, LhsUnitT, W>{rhs}.xyz(), lhs.space()};
+}
+
+template <class SpaceT, class PointUnitT, class VectorUnitT, std::size_t W>
+inline PointN<SpaceT, PointUnitT, W> operator+(const PointN<SpaceT, PointUnitT, W>& lhs, const VectorN<SpaceT, VectorUnitT, W>& rhs) {
+	checkSpacesMatch(lhs.space(), rhs.space());
+	return PointN<SpaceT, PointUnitT, W>{lhs.xyz() + VectorN<SpaceT, PointUnitT, W>{rhs}.xyz(), lhs.space()};
+}
+
+template <class SpaceT, class PointUnitT, class VectorUnitT, std::size_t W>
+inline PointN<SpaceT, PointUnitT, W> operator-(const PointN<SpaceT, PointUnitT, W>& lhs, const VectorN<SpaceT, VectorUnitT, W>& rhs) {
+	checkSpacesMatch(lhs.space(), rhs.space());
+	return PointN<SpaceT, PointUnitT, W>{lhs.xyz() - VectorN<SpaceT, PointUnitT, W>{rhs}.xyz(), lhs.space()};
+}
+
+// Affine, like Xform::apply for CompactPoints and CompactVectors. Not an apply overload, which
+// argument-dependent lookup would make ambiguous with std::apply. Forced inline with
+// multiplyAffine, which compilers otherwise keep out of line one call higher up.
+template <class FromSpaceT, class ToSpaceT, class UnitT, std::size_t W>
+TYPE_SAFETY_FORCE_INLINE PointN<ToSpaceT, UnitT, W> applyPacket(const Xform<FromSpaceT, ToSpaceT>& xform, const PointN<FromSpaceT, UnitT, W>& points) {
+	checkSpacesMatch(xform.fromSpace(), points.space());
+	return PointN<ToSpaceT, UnitT, W>{multiplyAffine(xform.matrix(), points.xyz(), 1.0f), xform.toSpace()};
+}
+
+template <class FromSpaceT, class ToSpaceT, class UnitT, std::size_t W>
+TYPE_SAFETY_FORCE_INLINE VectorN<ToSpaceT, UnitT, W> applyPacket(const Xform<FromSpaceT, ToSpaceT>& xform, const VectorN<FromSpaceT, UnitT, W>& vectors) {
+	checkSpacesMatch(xform.fromSpace(), vectors.space());
+	return VectorN<ToSpaceT, UnitT, W>{multiplyAffine(xform.matrix(), vectors.xyz(), 0.0f), xform.toSpace()};
+}
+
+} // namespace type_safety
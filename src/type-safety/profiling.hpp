@@ -0,0 +1,391 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#	define TYPE_SAFETY_PROFILING_TSC
+#	ifdef _MSC_VER
+#		include <intrin.h>
+#	else
+#		include <x86intrin.h>
+#	endif /* _MSC_VER */
+#endif /* x86-64 */
+
+#include "Unit.hpp"
+
+// Uncomment me to enable the ScopedTimers - without it they compile to nothing
+// #define TYPE_SAFETY_PROFILING
+
+namespace type_safety {
+
+namespace detail {
+
+// Time stamps for the timers. On x86-64 these are TSC ticks (assumed invariant, as on every
+// CPU of the last decade), which take a few nanoseconds to read where steady_clock takes
+// 15-30. Ticks are converted with a factor measured against steady_clock on first use.
+class ProfilingClock {
+public:
+
+	using Ticks = std::uint64_t;
+
+	// now(), calibrating first on the first call, so that the calibration isn't timed.
+	static Ticks start() {
+		nanosecondsPerTick();
+		return now();
+	}
+
+	static Ticks now() {
+#ifdef TYPE_SAFETY_PROFILING_TSC
+		return __rdtsc();
+#else
+		return static_cast<Ticks>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif /* TYPE_SAFETY_PROFILING_TSC */
+	}
+
+	static std::uint64_t toNanoseconds(Ticks ticks) {
+#ifdef TYPE_SAFETY_PROFILING_TSC
+		return static_cast<std::uint64_t>(static_cast<double>(ticks) * nanosecondsPerTick());
+#else
+		return ticks;
+#endif /* TYPE_SAFETY_PROFILING_TSC */
+	}
+
+	// Busy-waits for the calibration the first time it is called.
+	static double nanosecondsPerTick() {
+#ifdef TYPE_SAFETY_PROFILING_TSC
+		static const auto factor = calibrate();
+		return factor;
+#else
+		return 1.0;
+#endif /* TYPE_SAFETY_PROFILING_TSC */
+	}
+
+private:
+
+	static double calibrate() {
+		using Clock = std::chrono::steady_clock;
+		constexpr auto CALIBRATION_TIME = std::chrono::milliseconds{2};
+
+		const auto startTime = Clock::now();
+		const auto startTicks = now();
+		auto endTime = startTime;
+		while (endTime - startTime < CALIBRATION_TIME) {
+			endTime = Clock::now();
+		}
+		const auto endTicks = now();
+
+		return std::chrono::duration<double, std::nano>(endTime - startTime).count()
+			/ static_cast<double>(endTicks - startTicks);
+	}
+
+};
+
+inline int floorLog2(std::uint64_t value) {
+#ifdef _MSC_VER
+	auto index = 0ul;
+	_BitScanReverse64(&index, value);
+	return static_cast<int>(index);
+#else
+	return 63 - __builtin_clzll(value);
+#endif /* _MSC_VER */
+}
+
+} // namespace detail
+
+// Log-linear latency buckets over nanoseconds: every power of two is split into
+// LATENCY_SUB_BUCKETS equal buckets, so a bucket is at most 1/8 of its lower bound wide.
+// Latencies under LATENCY_SUB_BUCKETS ns get a bucket each and everything from
+// 2^LATENCY_MAX_OCTAVE ns (about 18 minutes) on lands in the last bucket.
+constexpr auto LATENCY_SUB_BUCKET_BITS = 3;
+constexpr auto LATENCY_SUB_BUCKETS = std::size_t{1} << LATENCY_SUB_BUCKET_BITS;
+constexpr auto LATENCY_MAX_OCTAVE = 40;
+constexpr auto LATENCY_BUCKET_COUNT =
+	LATENCY_SUB_BUCKETS + (LATENCY_MAX_OCTAVE - LATENCY_SUB_BUCKET_BITS) * LATENCY_SUB_BUCKETS;
+
+inline std::size_t latencyBucket(std::uint64_t nanoseconds) {
+	if (nanoseconds < LATENCY_SUB_BUCKETS) {
+		return static_cast<std::size_t>(nanoseconds);
+	}
+
+	const auto octave = detail::floorLog2(nanoseconds);
+	if (octave >= LATENCY_MAX_OCTAVE) {
+		return LATENCY_BUCKET_COUNT - 1;
+	}
+
+	const auto shift = octave - LATENCY_SUB_BUCKET_BITS;
+	const auto subBucket = static_cast<std::size_t>(nanoseconds >> shift) & (LATENCY_SUB_BUCKETS - 1);
+	return LATENCY_SUB_BUCKETS + static_cast<std::size_t>(shift) * LATENCY_SUB_BUCKETS + subBucket;
+}
+
+// Smallest latency in the bucket, in nanoseconds.
+constexpr std::uint64_t latencyBucketLowerBound(std::size_t bucket) {
+	if (bucket < LATENCY_SUB_BUCKETS) {
+		return bucket;
+	}
+	const auto shift = (bucket - LATENCY_SUB_BUCKETS) / LATENCY_SUB_BUCKETS;
+	const auto subBucket = (bucket - LATENCY_SUB_BUCKETS) % LATENCY_SUB_BUCKETS;
+	return static_cast<std::uint64_t>(LATENCY_SUB_BUCKETS + subBucket) << shift;
+}
+
+// One past the largest latency in the bucket, in nanoseconds.
+constexpr std::uint64_t latencyBucketUpperBound(std::size_t bucket) {
+	return bucket + 1 < LATENCY_BUCKET_COUNT ?
+		latencyBucketLowerBound(bucket + 1) :
+		std::uint64_t{1} << LATENCY_MAX_OCTAVE;
+}
+
+// Plain copy of histogram counts, safe to keep, merge and query from any thread.
+class LatencySnapshot {
+public:
+
+	std::uint64_t count() const {
+		return count_;
+	}
+
+	std::uint64_t count(std::size_t bucket) const {
+		return counts_[bucket];
+	}
+
+	Value<Nanoseconds> lowerBound(std::size_t bucket) const {
+		return makeValue<Nanoseconds>(static_cast<float>(latencyBucketLowerBound(bucket)));
+	}
+
+	Value<Nanoseconds> upperBound(std::size_t bucket) const {
+		return makeValue<Nanoseconds>(static_cast<float>(latencyBucketUpperBound(bucket)));
+	}
+
+	Value<Nanoseconds> mean() const {
+		return makeValue<Nanoseconds>(count_ == 0 ? 0.0f : static_cast<float>(
+			static_cast<double>(sumNanoseconds_) / static_cast<double>(count_)));
+	}
+
+	// Midpoint of the bucket holding the given fraction of the samples, e.g. 0.99 for the 99th
+	// percentile. Zero if there are no samples.
+	Value<Nanoseconds> percentile(float fraction) const {
+		const auto rank = static_cast<std::uint64_t>(fraction * static_cast<float>(count_));
+		auto seen = std::uint64_t{0};
+		for (auto bucket = std::size_t{0}; bucket < LATENCY_BUCKET_COUNT; ++bucket) {
+			seen += counts_[bucket];
+			if (seen > rank || (seen == count_ && seen != 0)) {
+				const auto lower = latencyBucketLowerBound(bucket);
+				const auto upper = latencyBucketUpperBound(bucket);
+				return makeValue<Nanoseconds>(static_cast<float>(lower + (upper - lower - 1) / 2));
+			}
+		}
+		return makeValue<Nanoseconds>(0.0f);
+	}
+
+	void add(std::size_t bucket, std::uint64_t samples) {
+		counts_[bucket] += samples;
+		count_ += samples;
+	}
+
+	void addSum(std::uint64_t sumNanoseconds) {
+		sumNanoseconds_ += sumNanoseconds;
+	}
+
+	void merge(const LatencySnapshot& other) {
+		for (auto bucket = std::size_t{0}; bucket < LATENCY_BUCKET_COUNT; ++bucket) {
+			counts_[bucket] += other.counts_[bucket];
+		}
+		count_ += other.count_;
+		sumNanoseconds_ += other.sumNanoseconds_;
+	}
+
+private:
+
+	std::array<std::uint64_t, LATENCY_BUCKET_COUNT> counts_ = {};
+
+	std::uint64_t count_ = 0;
+
+	std::uint64_t sumNanoseconds_ = 0;
+
+};
+
+// Latency histogram written by a single thread and readable from any. Recording is wait-free -
+// counters are bumped with relaxed loads and stores, so snapshots taken concurrently may miss
+// the samples recorded meanwhile, but never see torn counts. Use PerThreadLatencyHistogram to
+// record from several threads.
+class LatencyHistogram {
+public:
+
+	LatencyHistogram() = default;
+
+	LatencyHistogram(const LatencyHistogram&) = delete;
+
+	LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+	void record(Value<Nanoseconds> latency) {
+		const auto nanoseconds = latency.value<Nanoseconds>();
+		recordNanoseconds(nanoseconds > 0.0f ? static_cast<std::uint64_t>(nanoseconds) : 0u);
+	}
+
+	void recordNanoseconds(std::uint64_t nanoseconds) {
+		increment(counts_[latencyBucket(nanoseconds)], 1u);
+		increment(sumNanoseconds_, nanoseconds);
+	}
+
+	LatencySnapshot snapshot() const {
+		auto result = LatencySnapshot{};
+		for (auto bucket = std::size_t{0}; bucket < LATENCY_BUCKET_COUNT; ++bucket) {
+			result.add(bucket, counts_[bucket].load(std::memory_order_relaxed));
+		}
+		result.addSum(sumNanoseconds_.load(std::memory_order_relaxed));
+		return result;
+	}
+
+private:
+
+	std::array<std::atomic<std::uint64_t>, LATENCY_BUCKET_COUNT> counts_ = {};
+
+	std::atomic<std::uint64_t> sumNanoseconds_ = {0};
+
+	// Single writer, so no read-modify-write instruction is needed
+	static void increment(std::atomic<std::uint64_t>& counter, std::uint64_t amount) {
+		counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+	}
+
+};
+
+// A LatencyHistogram per recording thread, merged when snapshotted. Each thread finds its
+// histogram through a thread_local table indexed by the instance id, so after a thread's first
+// record the lookup is an array access. Ids are never reused, so the tables of long-lived
+// threads grow by a pointer per PerThreadLatencyHistogram ever created.
+class PerThreadLatencyHistogram {
+public:
+
+	PerThreadLatencyHistogram() :
+		id_(nextId())
+	{
+	}
+
+	PerThreadLatencyHistogram(const PerThreadLatencyHistogram&) = delete;
+
+	PerThreadLatencyHistogram& operator=(const PerThreadLatencyHistogram&) = delete;
+
+	// The histogram of the calling thread.
+	LatencyHistogram& local() {
+		const auto& histograms = threadHistograms();
+		if (id_ < histograms.size() && histograms[id_] != nullptr) {
+			return *histograms[id_];
+		}
+		return addThread();
+	}
+
+	LatencySnapshot snapshot() const {
+		const auto lock = std::lock_guard<std::mutex>{mutex_};
+		auto result = LatencySnapshot{};
+		for (const auto& histogram : histograms_) {
+			result.merge(histogram.snapshot());
+		}
+		return result;
+	}
+
+private:
+
+	std::size_t id_;
+
+	mutable std::mutex mutex_;
+
+	// deque, so that adding a thread doesn't move the histograms of the others
+	std::deque<LatencyHistogram> histograms_;
+
+	static std::size_t nextId() {
+		static auto next = std::atomic<std::size_t>{0};
+		return next.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	static std::vector<LatencyHistogram*>& threadHistograms() {
+		thread_local auto histograms = std::vector<LatencyHistogram*>{};
+		return histograms;
+	}
+
+	LatencyHistogram& addThread() {
+		auto& histograms = threadHistograms();
+		if (histograms.size() <= id_) {
+			histograms.resize(id_ + 1, nullptr);
+		}
+
+		const auto lock = std::lock_guard<std::mutex>{mutex_};
+		histograms_.emplace_back();
+		histograms[id_] = &histograms_.back();
+		return histograms_.back();
+	}
+
+};
+
+// Records the time from its construction to its destruction in a latency histogram:
+//
+//   static auto physicsTimes = PerThreadLatencyHistogram{};
+//   {
+//       const auto timer = ScopedTimer{physicsTimes};
+//       integrate(positions, velocities, dt);
+//   }
+//   log(physicsTimes.snapshot().percentile(0.99f));
+//
+// Without TYPE_SAFETY_PROFILING the timer is empty and compiles to nothing. The two timers live
+// in different inline namespaces, so translation units built with and without profiling don't
+// share one ScopedTimer with differing definitions.
+#ifdef TYPE_SAFETY_PROFILING
+inline namespace profiling_enabled {
+#else
+inline namespace profiling_disabled {
+#endif /* TYPE_SAFETY_PROFILING */
+
+class ScopedTimer {
+public:
+
+#ifdef TYPE_SAFETY_PROFILING
+	explicit ScopedTimer(LatencyHistogram& histogram) :
+		histogram_(histogram),
+		start_(detail::ProfilingClock::start())
+	{
+	}
+
+	explicit ScopedTimer(PerThreadLatencyHistogram& histogram) :
+		ScopedTimer(histogram.local())
+	{
+	}
+
+	~ScopedTimer() {
+		const auto end = detail::ProfilingClock::now();
+		histogram_.recordNanoseconds(detail::ProfilingClock::toNanoseconds(end - start_));
+	}
+#else
+	explicit ScopedTimer([[maybe_unused]] LatencyHistogram& histogram) {
+	}
+
+	explicit ScopedTimer([[maybe_unused]] PerThreadLatencyHistogram& histogram) {
+	}
+
+	// User-provided like the enabled one's, so that timers used only for their scope don't
+	// warn as unused variables.
+	~ScopedTimer() {
+	}
+#endif /* TYPE_SAFETY_PROFILING */
+
+	ScopedTimer(const ScopedTimer&) = delete;
+
+	ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+#ifdef TYPE_SAFETY_PROFILING
+private:
+
+	LatencyHistogram& histogram_;
+
+	detail::ProfilingClock::Ticks start_;
+#endif /* TYPE_SAFETY_PROFILING */
+
+};
+
+} // inline namespace profiling_enabled / profiling_disabled
+
+} // namespace type_safety
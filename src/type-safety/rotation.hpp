@@ -0,0 +1,231 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <utility>
+
+#include "Angle.hpp"
+#include "Matrix.hpp"
+#include "Point.hpp"
+#include "Xform.hpp"
+#include "simd.hpp"
+#include "trigonometry.hpp"
+
+namespace type_safety {
+
+// Builders of rotation Xforms. Pitch rotates about the x axis, yaw about y and roll about z,
+// all of them right-handed. Matrices act on column vectors, like Xform::apply.
+
+// Axes named in the order in which the rotations are applied, so XYZ pitches first and rolls
+// last, i.e. builds Rz * Ry * Rx.
+enum class RotationOrder {
+	XYZ,
+	XZY,
+	YXZ,
+	YZX,
+	ZXY,
+	ZYX,
+};
+
+namespace detail {
+
+template <int FIRST_AXIS, int SECOND_AXIS, int THIRD_AXIS>
+struct RotationAxes {
+	static constexpr auto FIRST = FIRST_AXIS;
+	static constexpr auto SECOND = SECOND_AXIS;
+	static constexpr auto THIRD = THIRD_AXIS;
+};
+
+template <class FunctionT>
+inline decltype(auto) withRotationAxes(RotationOrder order, FunctionT function) {
+	switch (order) {
+	case RotationOrder::XYZ:
+		return function(RotationAxes<0, 1, 2>{});
+	case RotationOrder::XZY:
+		return function(RotationAxes<0, 2, 1>{});
+	case RotationOrder::YXZ:
+		return function(RotationAxes<1, 0, 2>{});
+	case RotationOrder::YZX:
+		return function(RotationAxes<1, 2, 0>{});
+	case RotationOrder::ZXY:
+		return function(RotationAxes<2, 0, 1>{});
+	case RotationOrder::ZYX:
+	default:
+		return function(RotationAxes<2, 1, 0>{});
+	}
+}
+
+// Row-major 3x3 rotation.
+template <class FloatT>
+using Rotation3 = std::array<FloatT, 9>;
+
+// Rotation about a single axis, with the axes following it cyclically as (u, v), i.e.
+// u' = c * u - s * v and v' = s * u + c * v.
+template <int AXIS, class FloatT>
+inline Rotation3<FloatT> axisRotation(FloatT s, FloatT c) {
+	constexpr auto U = (AXIS + 1) % 3;
+	constexpr auto V = (AXIS + 2) % 3;
+
+	auto result = Rotation3<FloatT>{};
+	result.fill(FloatT{0.0f});
+	result[AXIS * 3 + AXIS] = FloatT{1.0f};
+	result[U * 3 + U] = c;
+	result[U * 3 + V] = -s;
+	result[V * 3 + U] = s;
+	result[V * 3 + V] = c;
+	return result;
+}
+
+// rotation = axisRotation<AXIS>(s, c) * rotation - only the rows u and v change.
+template <int AXIS, class FloatT>
+inline void rotateAbout(Rotation3<FloatT>& rotation, FloatT s, FloatT c) {
+	constexpr auto U = (AXIS + 1) % 3;
+	constexpr auto V = (AXIS + 2) % 3;
+
+	for (auto column = 0; column < 3; ++column) {
+		const auto u = rotation[U * 3 + column];
+		const auto v = rotation[V * 3 + column];
+		rotation[U * 3 + column] = c * u - s * v;
+		rotation[V * 3 + column] = s * u + c * v;
+	}
+}
+
+// sines and cosines are indexed by axis.
+template <class AxesT, class FloatT>
+inline Rotation3<FloatT> eulerRotation(const FloatT* sines, const FloatT* cosines) {
+	auto result = axisRotation<AxesT::FIRST>(sines[AxesT::FIRST], cosines[AxesT::FIRST]);
+	rotateAbout<AxesT::SECOND>(result, sines[AxesT::SECOND], cosines[AxesT::SECOND]);
+	rotateAbout<AxesT::THIRD>(result, sines[AxesT::THIRD], cosines[AxesT::THIRD]);
+	return result;
+}
+
+// All three sincos pairs are computed in a single packet.
+template <TrigPrecision PRECISION, class AxesT>
+inline Rotation3<float> eulerRotation(Angle pitch, Angle yaw, Angle roll) {
+	const float radians[simd::LANES] = { pitch.radians(), yaw.radians(), roll.radians(), 0.0f };
+	const auto [s, c] = sinCosKernel<PRECISION>(simd::Float4::load(radians));
+
+	float sines[simd::LANES];
+	float cosines[simd::LANES];
+	s.store(sines);
+	c.store(cosines);
+	return eulerRotation<AxesT>(sines, cosines);
+}
+
+inline void setRotation(Matrix& matrix, const Rotation3<float>& rotation) {
+	for (auto row = 0u; row < 3u; ++row) {
+		for (auto column = 0u; column < 3u; ++column) {
+			matrix.get(row, column) = rotation[row * 3 + column];
+		}
+		matrix.get(row, 3) = 0.0f;
+		matrix.get(3, row) = 0.0f;
+	}
+	matrix.get(3, 3) = 1.0f;
+}
+
+} // namespace detail
+
+template <
+	class FromSpaceT,
+	class ToSpaceT,
+	TrigPrecision PRECISION = TrigPrecision::MEDIUM
+	>
+inline Xform<FromSpaceT, ToSpaceT> makeRotationXform(
+	Angle pitch,
+	Angle yaw,
+	Angle roll,
+	RotationOrder order,
+	FromSpaceT fromSpace = FromSpaceT{},
+	ToSpaceT toSpace = ToSpaceT{}
+) {
+	auto result = Xform<FromSpaceT, ToSpaceT>{std::move(fromSpace), std::move(toSpace)};
+	detail::setRotation(result.matrix(), detail::withRotationAxes(order, [&](auto axes) {
+			return detail::eulerRotation<PRECISION, decltype(axes)>(pitch, yaw, roll);
+		}));
+	return result;
+}
+
+// Rotation by angle about axis, which must be normalised.
+template <
+	class FromSpaceT,
+	class ToSpaceT,
+	TrigPrecision PRECISION = TrigPrecision::MEDIUM
+	>
+inline Xform<FromSpaceT, ToSpaceT> makeRotationXform(
+	const Vector<FromSpaceT>& axis,
+	Angle angle,
+	ToSpaceT toSpace = ToSpaceT{}
+) {
+	const auto [s, c] = sincos<PRECISION>(angle);
+	const auto t = 1.0f - c;
+	const auto x = axis.vector().get(0);
+	const auto y = axis.vector().get(1);
+	const auto z = axis.vector().get(2);
+
+	auto result = Xform<FromSpaceT, ToSpaceT>{axis.space(), std::move(toSpace)};
+	detail::setRotation(result.matrix(), {
+		c + x * x * t, x * y * t - z * s, x * z * t + y * s,
+		y * x * t + z * s, c + y * y * t, y * z * t - x * s,
+		z * x * t - y * s, z * y * t + x * s, c + z * z * t,
+		});
+	return result;
+}
+
+// Batch version - sets the matrices of results[i] to the rotation by pitches[i], yaws[i] and
+// rolls[i] for i in [0, count). The spaces of results are left untouched.
+template <
+	TrigPrecision PRECISION = TrigPrecision::MEDIUM,
+	class FromSpaceT,
+	class ToSpaceT
+	>
+inline void makeRotationXforms(
+	const Angle* pitches,
+	const Angle* yaws,
+	const Angle* rolls,
+	RotationOrder order,
+	Xform<FromSpaceT, ToSpaceT>* results,
+	std::size_t count
+) {
+	detail::withRotationAxes(order, [&](auto axes) {
+			using Axes = decltype(axes);
+
+			const float* radians[] = {
+				detail::radiansData(pitches),
+				detail::radiansData(yaws),
+				detail::radiansData(rolls),
+				};
+
+			auto i = std::size_t{0};
+			for (; i + simd::LANES <= count; i += simd::LANES) {
+				simd::Float4 sines[3];
+				simd::Float4 cosines[3];
+				for (auto axis = 0; axis < 3; ++axis) {
+					std::tie(sines[axis], cosines[axis]) =
+						detail::sinCosKernel<PRECISION>(simd::Float4::load(radians[axis] + i));
+				}
+
+				const auto packed = detail::eulerRotation<Axes>(sines, cosines);
+
+				float lanes[9][simd::LANES];
+				for (auto element = 0u; element < 9u; ++element) {
+					packed[element].store(lanes[element]);
+				}
+				for (auto lane = 0u; lane < simd::LANES; ++lane) {
+					auto rotation = detail::Rotation3<float>{};
+					for (auto element = 0u; element < 9u; ++element) {
+						rotation[element] = lanes[element][lane];
+					}
+					detail::setRotation(results[i + lane].matrix(), rotation);
+				}
+			}
+			for (; i < count; ++i) {
+				detail::setRotation(
+					results[i].matrix(),
+					detail::eulerRotation<PRECISION, Axes>(pitches[i], yaws[i], rolls[i])
+					);
+			}
+		});
+}
+
+} // namespace type_safety
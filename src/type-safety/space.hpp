@@ -1,5 +1,8 @@
 #pragma once
 
+#include <type_traits>
+#include <stdexcept>
+
 // Comment me out to disable space runtime checks
 // #define DO_SPACE_RUNTIME_CHECKS
 
@@ -28,6 +31,15 @@ struct World {};
 struct Camera {};
 struct Player {};
 
+// Homogeneous coordinates after a projection, before the perspective divide.
+struct Clip {};
+
+// Normalised device coordinates, x, y and z in [-1, 1] inside the view volume.
+struct NDC {};
+
+// Window coordinates in pixels, y pointing down, with the depth range of the viewport.
+struct Screen {};
+
 struct PlayerAtFrame : Player {
 #ifdef DO_SPACE_RUNTIME_CHECKS
 	int frameId;
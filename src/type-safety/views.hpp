@@ -0,0 +1,452 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include "Point.hpp"
+#include "Xform.hpp"
+#include "simd.hpp"
+#include "space.hpp"
+
+namespace type_safety {
+
+// Lazy pipelines over contiguous Points, replacing passes that each materialize a vector:
+//
+//   const auto visible = playerPoints
+//       | views::xformed(playerToWorld)
+//       | views::xformed(worldToCamera) // folded into playerToWorld: one matrix per point
+//       | views::filtered([](const CameraPoint& p) { return p.vector().get(2) > 0.0f; });
+//   visible.forEach(draw);
+//   for (const auto& p : visible) { ... }
+//
+// Consecutive xformed adaptors are composed with inSequence when the pipeline is built, so
+// however many there are, every point is multiplied by a single matrix. forEach runs the points
+// through a SIMD kernel in blocks of BLOCK_SIZE before handing them on, iterating transforms
+// them one at a time. Spaces are checked when the pipeline is built, at compile time unless
+// DO_SPACE_RUNTIME_CHECKS is defined.
+//
+// Views refer to the points and don't own them, so the points must outlive the pipeline. This
+// is C++17, so the adaptors are this header's own rather than std::ranges ones - std algorithms
+// still take views' iterators.
+
+namespace views {
+
+constexpr auto BLOCK_SIZE = std::size_t{64};
+
+} // namespace views
+
+namespace detail {
+
+// The matrix as Float4 columns. A point is the sum of the columns scaled by its coordinates,
+// which takes four broadcasts and four multiply-adds rather than sixteen scalar products.
+class ColumnMatrix {
+public:
+
+	explicit ColumnMatrix(const Matrix& matrix) {
+		for (auto column = 0u; column < 4u; ++column) {
+			auto elements = std::array<float, 4>{};
+			for (auto row = 0u; row < 4u; ++row) {
+				elements[row] = matrix.get(row, column);
+			}
+			columns_[column] = simd::Float4::load(elements.data());
+		}
+	}
+
+	Vec4 apply(const Vec4& v) const {
+		const auto result =
+			columns_[0] * simd::Float4{v.get(0)} +
+			columns_[1] * simd::Float4{v.get(1)} +
+			columns_[2] * simd::Float4{v.get(2)} +
+			columns_[3] * simd::Float4{v.get(3)};
+		auto elements = std::array<float, 4>{};
+		result.store(elements.data());
+		return Vec4{elements[0], elements[1], elements[2], elements[3]};
+	}
+
+private:
+
+	std::array<simd::Float4, 4> columns_;
+
+};
+
+template <class PointT>
+struct IsPoint : std::false_type {
+};
+
+template <class SpaceT, class UnitT>
+struct IsPoint<Point<SpaceT, UnitT>> : std::true_type {
+};
+
+// Contiguous containers of Points, which pipelines may start from.
+template <class ContainerT>
+using EnableIfPointContainer = std::enable_if_t<
+	IsPoint<std::remove_cv_t<std::remove_pointer_t<decltype(std::declval<const ContainerT&>().data())>>>::value
+	>;
+
+} // namespace detail
+
+// The start of a pipeline: points viewed without copying.
+template <class PointT>
+class PointSpan {
+public:
+
+	using value_type = PointT;
+
+	using iterator = const PointT*;
+
+	PointSpan(const PointT* data, std::size_t size) :
+		data_(data),
+		size_(size)
+	{
+	}
+
+	template <class ContainerT, class = detail::EnableIfPointContainer<ContainerT>>
+	PointSpan(const ContainerT& points) :
+		data_(points.data()),
+		size_(points.size())
+	{
+	}
+
+	const PointT* data() const {
+		return data_;
+	}
+
+	std::size_t size() const {
+		return size_;
+	}
+
+	iterator begin() const {
+		return data_;
+	}
+
+	iterator end() const {
+		return data_ + size_;
+	}
+
+	template <class FunctionT>
+	void forEach(FunctionT&& function) const {
+		for (auto i = std::size_t{0}; i < size_; ++i) {
+			function(data_[i]);
+		}
+	}
+
+private:
+
+	const PointT* data_;
+
+	std::size_t size_;
+
+};
+
+template <class ContainerT, class = detail::EnableIfPointContainer<ContainerT>>
+PointSpan(const ContainerT&) -> PointSpan<std::remove_cv_t<std::remove_pointer_t<decltype(std::declval<const ContainerT&>().data())>>>;
+
+// The source's points transformed by a single Xform.
+template <class SourceT, class FromSpaceT, class ToSpaceT>
+class XformedView {
+public:
+
+	using XformType = Xform<FromSpaceT, ToSpaceT>;
+
+	using value_type = Point<ToSpaceT, typename SourceT::value_type::Unit>;
+
+	class iterator {
+	public:
+
+		using iterator_category = std::input_iterator_tag;
+		using value_type = XformedView::value_type;
+		using difference_type = std::ptrdiff_t;
+		using pointer = void;
+		using reference = value_type;
+
+		iterator(typename SourceT::iterator source, const XformType& xform) :
+			source_(source),
+			xform_(&xform)
+		{
+		}
+
+		value_type operator*() const {
+			return xform_->apply(*source_);
+		}
+
+		iterator& operator++() {
+			++source_;
+			return *this;
+		}
+
+		iterator operator++(int) {
+			auto result = *this;
+			++source_;
+			return result;
+		}
+
+		friend bool operator==(const iterator& lhs, const iterator& rhs) {
+			return lhs.source_ == rhs.source_;
+		}
+
+		friend bool operator!=(const iterator& lhs, const iterator& rhs) {
+			return !(lhs == rhs);
+		}
+
+	private:
+
+		typename SourceT::iterator source_;
+
+		const XformType* xform_;
+
+	};
+
+	XformedView(SourceT source, XformType xform) :
+		source_(std::move(source)),
+		xform_(std::move(xform))
+	{
+	}
+
+	const SourceT& source() const {
+		return source_;
+	}
+
+	const XformType& xform() const {
+		return xform_;
+	}
+
+	iterator begin() const {
+		return iterator{source_.begin(), xform_};
+	}
+
+	iterator end() const {
+		return iterator{source_.end(), xform_};
+	}
+
+	template <class FunctionT>
+	void forEach(FunctionT&& function) const {
+		const auto matrix = detail::ColumnMatrix{xform_.matrix()};
+		if constexpr (std::is_same_v<SourceT, PointSpan<typename SourceT::value_type>>) {
+			// Transform a block, then hand it on, so the kernel's loop stays free of the
+			// function's code
+			auto block = std::array<Vec4, views::BLOCK_SIZE>{};
+			const auto* points = source_.data();
+			for (auto begin = std::size_t{0}; begin < source_.size(); begin += views::BLOCK_SIZE) {
+				const auto count = std::min(views::BLOCK_SIZE, source_.size() - begin);
+				for (auto i = std::size_t{0}; i < count; ++i) {
+					checkSpacesMatch(xform_.fromSpace(), points[begin + i].space());
+					block[i] = matrix.apply(points[begin + i].vector());
+				}
+				for (auto i = std::size_t{0}; i < count; ++i) {
+					function(makePoint(block[i]));
+				}
+			}
+		} else {
+			source_.forEach([&](const auto& point) {
+					checkSpacesMatch(xform_.fromSpace(), point.space());
+					function(makePoint(matrix.apply(point.vector())));
+				});
+		}
+	}
+
+private:
+
+	SourceT source_;
+
+	XformType xform_;
+
+	value_type makePoint(const Vec4& v) const {
+		// Not the Vec4 constructor, which asserts w == 1 - projections don't keep it
+		auto result = value_type{xform_.toSpace()};
+		result.vector() = v;
+		return result;
+	}
+
+};
+
+// The source's points for which the predicate returns true.
+template <class SourceT, class PredicateT>
+class FilteredView {
+public:
+
+	using value_type = typename SourceT::value_type;
+
+	class iterator {
+	public:
+
+		using iterator_category = std::input_iterator_tag;
+		using value_type = FilteredView::value_type;
+		using difference_type = std::ptrdiff_t;
+		using pointer = void;
+		using reference = value_type;
+
+		iterator(typename SourceT::iterator source, typename SourceT::iterator end, const PredicateT& predicate) :
+			source_(source),
+			end_(end),
+			predicate_(&predicate)
+		{
+			skipRejected();
+		}
+
+		value_type operator*() const {
+			return *source_;
+		}
+
+		iterator& operator++() {
+			++source_;
+			skipRejected();
+			return *this;
+		}
+
+		iterator operator++(int) {
+			auto result = *this;
+			++*this;
+			return result;
+		}
+
+		friend bool operator==(const iterator& lhs, const iterator& rhs) {
+			return lhs.source_ == rhs.source_;
+		}
+
+		friend bool operator!=(const iterator& lhs, const iterator& rhs) {
+			return !(lhs == rhs);
+		}
+
+	private:
+
+		typename SourceT::iterator source_;
+
+		typename SourceT::iterator end_;
+
+		const PredicateT* predicate_;
+
+		void skipRejected() {
+			while (source_ != end_ && !(*predicate_)(*source_)) {
+				++source_;
+			}
+		}
+
+	};
+
+	FilteredView(SourceT source, PredicateT predicate) :
+		source_(std::move(source)),
+		predicate_(std::move(predicate))
+	{
+	}
+
+	iterator begin() const {
+		return iterator{source_.begin(), source_.end(), predicate_};
+	}
+
+	iterator end() const {
+		return iterator{source_.end(), source_.end(), predicate_};
+	}
+
+	template <class FunctionT>
+	void forEach(FunctionT&& function) const {
+		source_.forEach([&](const value_type& point) {
+				if (predicate_(point)) {
+					function(point);
+				}
+			});
+	}
+
+private:
+
+	SourceT source_;
+
+	PredicateT predicate_;
+
+};
+
+namespace views {
+
+template <class FromSpaceT, class ToSpaceT>
+struct XformedAdaptor {
+	Xform<FromSpaceT, ToSpaceT> xform;
+};
+
+template <class PredicateT>
+struct FilteredAdaptor {
+	PredicateT predicate;
+};
+
+template <class FromSpaceT, class ToSpaceT>
+inline XformedAdaptor<FromSpaceT, ToSpaceT> xformed(const Xform<FromSpaceT, ToSpaceT>& xform) {
+	return XformedAdaptor<FromSpaceT, ToSpaceT>{xform};
+}
+
+template <class PredicateT>
+inline FilteredAdaptor<std::decay_t<PredicateT>> filtered(PredicateT&& predicate) {
+	return FilteredAdaptor<std::decay_t<PredicateT>>{std::forward<PredicateT>(predicate)};
+}
+
+template <class PointT>
+inline PointSpan<PointT> all(const PointT* data, std::size_t size) {
+	return PointSpan<PointT>{data, size};
+}
+
+template <class ContainerT, class = detail::EnableIfPointContainer<ContainerT>>
+inline auto all(const ContainerT& points) {
+	return PointSpan{points};
+}
+
+template <class PointT, class FromSpaceT, class ToSpaceT>
+inline auto operator|(const PointSpan<PointT>& points, const XformedAdaptor<FromSpaceT, ToSpaceT>& adaptor) {
+	static_assert(
+		SpaceTypesMatch_v<typename PointT::Space, FromSpaceT> || SpaceTypesMatch_v<FromSpaceT, typename PointT::Space>,
+		"The Xform doesn't transform from the points' space"
+		);
+	return XformedView<PointSpan<PointT>, FromSpaceT, ToSpaceT>{points, adaptor.xform};
+}
+
+template <class ContainerT, class FromSpaceT, class ToSpaceT, class = detail::EnableIfPointContainer<ContainerT>>
+inline auto operator|(const ContainerT& points, const XformedAdaptor<FromSpaceT, ToSpaceT>& adaptor) {
+	return all(points) | adaptor;
+}
+
+// Folds the Xforms into one.
+template <class SourceT, class FromSpaceT, class MiddleSpaceT, class NextFromSpaceT, class ToSpaceT>
+inline auto operator|(
+	const XformedView<SourceT, FromSpaceT, MiddleSpaceT>& view,
+	const XformedAdaptor<NextFromSpaceT, ToSpaceT>& adaptor
+) {
+	static_assert(
+		SpaceTypesMatch_v<MiddleSpaceT, NextFromSpaceT> || SpaceTypesMatch_v<NextFromSpaceT, MiddleSpaceT>,
+		"The Xform doesn't transform from the space of the previous one's result"
+		);
+	return XformedView<SourceT, FromSpaceT, ToSpaceT>{view.source(), inSequence(view.xform(), adaptor.xform)};
+}
+
+template <class SourceT, class PredicateT, class FromSpaceT, class ToSpaceT>
+inline auto operator|(const FilteredView<SourceT, PredicateT>& view, const XformedAdaptor<FromSpaceT, ToSpaceT>& adaptor) {
+	using Space = typename FilteredView<SourceT, PredicateT>::value_type::Space;
+	static_assert(
+		SpaceTypesMatch_v<Space, FromSpaceT> || SpaceTypesMatch_v<FromSpaceT, Space>,
+		"The Xform doesn't transform from the points' space"
+		);
+	return XformedView<FilteredView<SourceT, PredicateT>, FromSpaceT, ToSpaceT>{view, adaptor.xform};
+}
+
+template <class PointT, class PredicateT>
+inline auto operator|(const PointSpan<PointT>& points, const FilteredAdaptor<PredicateT>& adaptor) {
+	return FilteredView<PointSpan<PointT>, PredicateT>{points, adaptor.predicate};
+}
+
+template <class ContainerT, class PredicateT, class = detail::EnableIfPointContainer<ContainerT>>
+inline auto operator|(const ContainerT& points, const FilteredAdaptor<PredicateT>& adaptor) {
+	return all(points) | adaptor;
+}
+
+template <class SourceT, class FromSpaceT, class ToSpaceT, class PredicateT>
+inline auto operator|(const XformedView<SourceT, FromSpaceT, ToSpaceT>& view, const FilteredAdaptor<PredicateT>& adaptor) {
+	return FilteredView<XformedView<SourceT, FromSpaceT, ToSpaceT>, PredicateT>{view, adaptor.predicate};
+}
+
+template <class SourceT, class SourcePredicateT, class PredicateT>
+inline auto operator|(const FilteredView<SourceT, SourcePredicateT>& view, const FilteredAdaptor<PredicateT>& adaptor) {
+	return FilteredView<FilteredView<SourceT, SourcePredicateT>, PredicateT>{view, adaptor.predicate};
+}
+
+} // namespace views
+
+} // namespace type_safety
@@ -5,6 +5,7 @@
 #include <sstream>
 
 #include "type-safety/Angle.hpp"
+#include "type-safety/AngleIO.hpp"
 
 using namespace type_safety;
 using namespace type_safety::angle_literals;
@@ -89,6 +90,44 @@ TEST(AngleTest, AngleArithmetics) {
 	EXPECT_EQ(divEq, 21_deg);
 }
 
+TEST(AngleTest, NormalizedIsInMinusPiToPi) {
+    static_assert((0_deg).normalized() == 0_deg);
+    static_assert((90_deg).normalized() == 90_deg);
+    static_assert((-90_deg).normalized() == -90_deg);
+    static_assert((270_deg).normalized() == -90_deg);
+    static_assert((-270_deg).normalized() == 90_deg);
+    static_assert((720_deg).normalized() == 0_deg);
+    static_assert((1_pi).normalized() == -1_pi);
+    static_assert((-1_pi).normalized() == -1_pi);
+
+    for (auto turns = -1000; turns <= 1000; turns += 7) {
+        const auto a = 30_deg + 2_pi * static_cast<float>(turns);
+        const auto n = a.normalized();
+        EXPECT_GE(n.radians(), -PI);
+        EXPECT_LT(n.radians(), PI);
+        EXPECT_NEAR(n.radians(), (30_deg).radians(), 1e-3f) << turns;
+    }
+}
+
+TEST(AngleTest, WrappedIsInZeroToTwoPi) {
+    static_assert((0_deg).wrapped() == 0_deg);
+    static_assert((90_deg).wrapped() == 90_deg);
+    static_assert((-90_deg).wrapped() == 270_deg);
+    static_assert((360_deg).wrapped() == 0_deg);
+    static_assert((-630_deg).wrapped() == 90_deg);
+    static_assert((1_pi).wrapped() == 1_pi);
+
+    for (auto turns = -1000; turns <= 1000; turns += 7) {
+        const auto a = -30_deg + 2_pi * static_cast<float>(turns);
+        const auto w = a.wrapped();
+        EXPECT_GE(w.radians(), 0.0f);
+        EXPECT_LT(w.radians(), 2.0f * PI);
+        EXPECT_NEAR(w.radians(), (330_deg).radians(), 1e-3f) << turns;
+    }
+
+    EXPECT_LT((-1e-8_rad).wrapped().radians(), 2.0f * PI);
+}
+
 TEST(AngleTest, AnglePrintToOstream) {
     auto oss = std::ostringstream{};
 
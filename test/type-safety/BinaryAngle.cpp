@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <cmath>
+#include <sstream>
+
+#include "type-safety/AngleIO.hpp"
+#include "type-safety/BinaryAngle.hpp"
+
+using namespace type_safety;
+using namespace type_safety::angle_literals;
+
+namespace /* anonymous */ {
+
+TEST(BinaryAngleTest, StorageSize) {
+	static_assert(sizeof(BinaryAngle16) == 2);
+	static_assert(sizeof(BinaryAngle32) == 4);
+}
+
+TEST(BinaryAngleTest, ConvertsFromAndToAngle) {
+	static_assert(BinaryAngle16{90_deg}.raw() == 0x4000);
+	static_assert(BinaryAngle16{-90_deg}.raw() == 0xc000);
+	static_assert(BinaryAngle16{180_deg}.raw() == 0x8000);
+	static_assert(BinaryAngle16{450_deg} == BinaryAngle16{90_deg});
+
+	static_assert(BinaryAngle16{90_deg}.angle() == 90_deg);
+	static_assert(BinaryAngle16{270_deg}.angle() == -90_deg);
+	static_assert(BinaryAngle16{270_deg}.wrappedAngle() == 270_deg);
+	static_assert(BinaryAngle32{-45_deg}.angle() == -45_deg);
+	static_assert(BinaryAngle32{-45_deg}.wrappedAngle() == 315_deg);
+}
+
+TEST(BinaryAngleTest, ArithmeticsWrapAround) {
+	static_assert(BinaryAngle16{270_deg} + BinaryAngle16{180_deg} == BinaryAngle16{90_deg});
+	static_assert(BinaryAngle16{10_deg} - BinaryAngle16{30_deg} == BinaryAngle16{-20_deg});
+	static_assert(-BinaryAngle16{30_deg} == BinaryAngle16{330_deg});
+	static_assert(-BinaryAngle32::fromRaw(1u) == BinaryAngle32::fromRaw(0xffffffffu));
+
+	auto accumulated = BinaryAngle32{};
+	const auto step = BinaryAngle32{1_deg};
+	for (auto i = 0; i < 360 * 1000 + 45; ++i) {
+		accumulated += step;
+	}
+	EXPECT_NEAR(accumulated.angle().degrees(), 45.0f, 0.01f);
+}
+
+TEST(BinaryAngleTest, TableTrigonometry) {
+	for (auto degrees = -720; degrees <= 720; degrees += 5) {
+		const auto a = Angle{degreesTag, static_cast<float>(degrees) + 0.3f};
+		EXPECT_NEAR(sin(BinaryAngle32{a}), std::sin(a.radians()), 1e-5f);
+		EXPECT_NEAR(cos(BinaryAngle32{a}), std::cos(a.radians()), 1e-5f);
+		EXPECT_NEAR(sin(BinaryAngle16{a}), std::sin(a.radians()), 1e-4f);
+		EXPECT_NEAR(cos(BinaryAngle16{a}), std::cos(a.radians()), 1e-4f);
+	}
+}
+
+TEST(BinaryAngleTest, PrintToOstream) {
+	auto oss = std::ostringstream{};
+
+	oss << BinaryAngle16{-90_deg};
+
+	EXPECT_EQ(oss.str(), "-90_deg");
+}
+
+} // anonymous namespace
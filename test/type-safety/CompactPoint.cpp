@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+
+#include <type_traits>
+#include <vector>
+
+#include "type-safety/CompactPoint.hpp"
+#include "type-safety/Xform.hpp"
+#include "type-safety/XformFixtures.hpp"
+
+using namespace type_safety;
+
+namespace /* anonymous */ {
+
+void expectVec4Eq(const Vec4& actual, const Vec4& expected) {
+	for (auto i = 0u; i < 4u; ++i) {
+		EXPECT_FLOAT_EQ(actual.get(i), expected.get(i));
+	}
+}
+
+TEST(CompactPointTest, IsTwelveBytes) {
+	static_assert(sizeof(CompactPoint<space::World, Metres>) == 12);
+	static_assert(sizeof(CompactVector<space::World, MPS>) == 12);
+}
+
+TEST(CompactPointTest, ImpliesW) {
+	const auto p = CompactPoint<space::World, Metres>{Vec3{1.0f, 2.0f, 3.0f}};
+	const auto v = CompactVector<space::World, Metres>{Vec4{1.0f, 2.0f, 3.0f, 0.0f}};
+
+	expectVec4Eq(p.vector(), Vec4{1.0f, 2.0f, 3.0f, 1.0f});
+	expectVec4Eq(v.vector(), Vec4{1.0f, 2.0f, 3.0f, 0.0f});
+	expectVec4Eq(p.expanded().vector(), p.vector());
+	expectVec4Eq(v.expanded().vector(), v.vector());
+}
+
+TEST(CompactPointTest, ConvertsBetweenCompatibleUnits) {
+	const auto kms = CompactPoint<space::World, Kilometres>{Vec3{1.0f, 2.0f, 3.0f}};
+	const auto ms = CompactPoint<space::World, Metres>{kms};
+
+	expectVec4Eq(ms.vector(), Vec4{1000.0f, 2000.0f, 3000.0f, 1.0f});
+	expectVec4Eq(kms.vector<Metres>(), Vec4{1000.0f, 2000.0f, 3000.0f, 1.0f});
+}
+
+TEST(CompactPointTest, ArithmeticsMatchFullPoints) {
+	const auto p = CompactPoint<space::World, Metres>{Vec3{1.0f, 2.0f, 3.0f}};
+	const auto q = CompactPoint<space::World, Kilometres>{Vec3{0.001f, 0.0f, 0.0f}};
+	const auto v = CompactVector<space::World, Metres>{Vec3{1.0f, 1.0f, 1.0f}};
+
+	expectVec4Eq((p - q).vector(), (p.expanded() - q.expanded()).vector());
+	expectVec4Eq((p + v).vector(), (p.expanded() + v.expanded()).vector());
+	expectVec4Eq((p - v).vector(), (p.expanded() - v.expanded()).vector());
+	expectVec4Eq((v * 2.0f + v).vector(), Vec4{3.0f, 3.0f, 3.0f, 0.0f});
+}
+
+TEST(CompactPointTest, XformApplyMatchesFullPoints) {
+	const auto xform = fixtures::affineXform<space::World, space::Camera>();
+	const auto p = CompactPoint<space::World, Metres>{Vec3{1.0f, 2.0f, 3.0f}};
+	const auto v = CompactVector<space::World, Metres>{Vec3{1.0f, 2.0f, 3.0f}};
+
+	const auto transformedPoint = xform.apply(p);
+	static_assert(std::is_same_v<std::decay_t<decltype(transformedPoint)>, CompactPoint<space::Camera, Metres>>);
+	expectVec4Eq(transformedPoint.vector(), xform.apply(p.expanded()).vector());
+	expectVec4Eq(xform.apply(v).vector(), xform.apply(v.expanded()).vector());
+}
+
+TEST(CompactPointTest, ApplyAllMatchesApply) {
+	const auto xform = fixtures::affineXform<space::World, space::Camera>();
+	// Not a multiple of the packet size, so the scalar tail runs too
+	auto points = std::vector<CompactPoint<space::World, Metres>>{};
+	auto vectors = std::vector<CompactVector<space::World, Metres>>{};
+	for (auto i = 0u; i < 11u; ++i) {
+		const auto f = static_cast<float>(i);
+		points.emplace_back(Vec3{f, -f, 2.0f * f});
+		vectors.emplace_back(Vec3{-f, f, 0.5f * f});
+	}
+
+	auto transformedPoints = std::vector<CompactPoint<space::Camera, Metres>>(points.size());
+	auto transformedVectors = std::vector<CompactVector<space::Camera, Metres>>(vectors.size());
+	applyAll(xform, points.data(), points.size(), transformedPoints.data());
+	applyAll(xform, vectors.data(), vectors.size(), transformedVectors.data());
+
+	for (auto i = 0u; i < points.size(); ++i) {
+		expectVec4Eq(transformedPoints[i].vector(), xform.apply(points[i]).vector());
+		expectVec4Eq(transformedVectors[i].vector(), xform.apply(vectors[i]).vector());
+	}
+}
+
+} // anonymous namespace
@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <type_traits>
+
+#include "type-safety/CompressedTuple.hpp"
+
+namespace /* anonymous */ {
+
+using namespace type_safety;
+
+struct Empty {
+	constexpr Empty() = default;
+};
+
+struct OtherEmpty {
+	constexpr OtherEmpty() = default;
+};
+
+template <class Parent>
+struct Child : Parent {
+	bool b;
+};
+
+TEST(CompressedTupleTest, EmptyMembersTakeNoSpace) {
+	static_assert(std::is_empty_v<CompressedTuple<>>);
+	static_assert(std::is_empty_v<CompressedTuple<Empty, OtherEmpty, Empty>>);
+	static_assert(sizeof(Child<CompressedTuple<Empty, OtherEmpty, Empty>>) == sizeof(bool));
+
+	static_assert(sizeof(CompressedTuple<Empty, int, OtherEmpty>) == sizeof(int));
+	static_assert(sizeof(CompressedTuple<int, Empty, float, OtherEmpty, Empty>) == sizeof(int) + sizeof(float));
+	static_assert(sizeof(Child<CompressedTuple<Empty, bool, OtherEmpty>>) == sizeof(bool) * 2);
+}
+
+TEST(CompressedTupleTest, NonEmptyMembersHaveSizeOfStruct) {
+	struct Reference {
+		double d;
+		int i;
+		char c;
+	};
+	static_assert(sizeof(CompressedTuple<double, Empty, int, char>) == sizeof(Reference));
+}
+
+TEST(CompressedTupleTest, IsTriviallyCopyableIfMembersAre) {
+	static_assert(std::is_trivially_copyable_v<CompressedTuple<>>);
+	static_assert(std::is_trivially_copyable_v<CompressedTuple<Empty, int, float>>);
+
+	struct NotTriviallyCopyable {
+		NotTriviallyCopyable(const NotTriviallyCopyable& other) :
+			i(other.i)
+		{
+		}
+
+		int i;
+	};
+	static_assert(!std::is_trivially_copyable_v<CompressedTuple<Empty, NotTriviallyCopyable>>);
+}
+
+TEST(CompressedTupleTest, IsConstexpr) {
+	constexpr auto t = CompressedTuple<int, Empty, float, OtherEmpty>{1, Empty{}, 2.0f, OtherEmpty{}};
+	static_assert(t.get<0>() == 1);
+	static_assert(t.get<2>() == 2.0f);
+
+	[[maybe_unused]] constexpr auto empty = CompressedTuple<Empty, OtherEmpty>{};
+}
+
+TEST(CompressedTupleTest, GetReturnsReferencesToStoredMembers) {
+	auto t = CompressedTuple<Empty, int, OtherEmpty, int>{Empty{}, 1, OtherEmpty{}, 2};
+	static_assert(std::is_same_v<decltype(t.get<0>()), Empty>);
+	static_assert(std::is_same_v<decltype(t.get<1>()), int&>);
+	static_assert(std::is_same_v<decltype(std::as_const(t).get<3>()), const int&>);
+
+	t.get<3>() = 42;
+	EXPECT_EQ(t.get<1>(), 1);
+	EXPECT_EQ(t.get<3>(), 42);
+}
+
+TEST(CompressedTupleTest, CanBeRelocatedWithMemcpy) {
+	const CompressedTuple<Empty, int, float> source[] = { { Empty{}, 1, 1.5f }, { Empty{}, 2, 2.5f } };
+	CompressedTuple<Empty, int, float> target[2];
+	std::memcpy(target, source, sizeof(source));
+
+	EXPECT_EQ(target[1].get<1>(), 2);
+	EXPECT_EQ(target[1].get<2>(), 2.5f);
+}
+
+} // anonymous namespace
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <vector>
+
+#include "type-safety/DynamicValue.hpp"
+
+using namespace type_safety;
+using namespace type_safety::unit_literals;
+
+namespace /* anonymous */ {
+
+TEST(DynamicValueTest, DynamicUnitMirrorsStaticUnit) {
+	constexpr auto kph = DynamicUnit::of<KPH>();
+	static_assert(kph.exponent(Dimension::LENGTH) == 1);
+	static_assert(kph.exponent(Dimension::TIME) == -1);
+	static_assert(kph.exponent(Dimension::MASS) == 0);
+	EXPECT_FLOAT_EQ(kph.scale(), 1.0f / 3.6f);
+
+	static_assert(DynamicUnit::of<Newtons>().isConvertibleTo<decltype(Kilograms{} * MPS2{})>());
+	static_assert(!DynamicUnit::of<Newtons>().isConvertibleTo<Joules>());
+}
+
+TEST(DynamicValueTest, ProductsMatchStaticProducts) {
+	const auto metres = DynamicUnit::of<Metres>();
+	const auto seconds = DynamicUnit::of<Seconds>();
+	EXPECT_EQ(metres / seconds / seconds, DynamicUnit::of<MPS2>());
+	EXPECT_EQ(DynamicUnit::of<Kilometres>() / DynamicUnit::of<Hours>(), DynamicUnit::of<KPH>());
+	EXPECT_NE(metres / seconds, DynamicUnit::of<KPH>());
+}
+
+TEST(DynamicValueTest, UnitsFromSymbols) {
+	EXPECT_EQ(unitFromSymbol("km/h"), DynamicUnit::of<KPH>());
+	EXPECT_EQ(unitFromSymbol("J"), DynamicUnit::of<Joules>());
+	EXPECT_EQ(unitFromSymbol(""), DynamicUnit::of<Dimensionless>());
+	EXPECT_FALSE(unitFromSymbol("furlong").has_value());
+}
+
+TEST(DynamicValueTest, ArithmeticConvertsToLhsUnit) {
+	const auto sum = DynamicValue{2_km} + DynamicValue{500_m};
+	EXPECT_EQ(sum.unit(), DynamicUnit::of<Kilometres>());
+	EXPECT_FLOAT_EQ(sum.value(), 2.5f);
+	EXPECT_EQ(sum, DynamicValue{2500_m});
+
+	const auto speed = DynamicValue{100_m} / DynamicValue{10_s};
+	EXPECT_EQ(speed.unit(), DynamicUnit::of<MPS>());
+	EXPECT_FLOAT_EQ(speed.value(), 10.0f);
+	EXPECT_TRUE(DynamicValue{1_mps} < speed);
+}
+
+TEST(DynamicValueTest, MismatchedDimensionsThrow) {
+	EXPECT_THROW(DynamicValue{2_km} + DynamicValue{2_s}, std::runtime_error);
+	EXPECT_THROW(DynamicValue{2_km}.value(DynamicUnit::of<Kilograms>()), std::runtime_error);
+}
+
+TEST(DynamicValueTest, PromotesToStaticValue) {
+	const auto value = DynamicValue{72.0f, *unitFromSymbol("km/h")};
+
+	const auto speed = value.as<MPS>();
+	ASSERT_TRUE(speed.has_value());
+	EXPECT_FLOAT_EQ(speed->value<MPS>(), 20.0f);
+	EXPECT_FALSE(value.as<Metres>().has_value());
+}
+
+TEST(DynamicValueTest, ColumnPromotesWithoutCopying) {
+	auto samples = std::vector<float>{1.0f, 2.0f, 3.0f};
+	auto column = DynamicColumn{samples.data(), samples.size(), *unitFromSymbol("m")};
+
+	EXPECT_FALSE(column.promote<Seconds>().has_value());
+
+	const auto distances = column.promote<Metres>();
+	ASSERT_TRUE(distances.has_value());
+	EXPECT_EQ(static_cast<void*>(distances->data()), static_cast<void*>(samples.data()));
+	EXPECT_EQ(distances->size(), 3u);
+	EXPECT_EQ((*distances)[1], 2_m);
+
+	(*distances)[2] += 1_m;
+	EXPECT_FLOAT_EQ(samples[2], 4.0f);
+}
+
+TEST(DynamicValueTest, ColumnConvertsWithoutModifyingSamples) {
+	auto samples = std::vector<float>{1.0f, 2.5f, 0.25f, 4.0f, 8.0f, 0.5f, 3.0f, 6.0f, 7.5f};
+	const auto column = DynamicColumn{samples.data(), samples.size(), *unitFromSymbol("km")};
+
+	EXPECT_FALSE(column.promote<Metres>().has_value());
+
+	auto converted = std::vector<Distance>(samples.size());
+	EXPECT_FALSE(column.convertTo<Seconds>(nullptr).has_value());
+	const auto distances = column.convertTo<Metres>(converted.data());
+	ASSERT_TRUE(distances.has_value());
+	EXPECT_EQ(distances->data(), converted.data());
+	for (auto i = std::size_t{0}; i < samples.size(); ++i) {
+		EXPECT_EQ(converted[i], makeValue<Metres>(samples[i] * 1000.0f));
+	}
+	EXPECT_FLOAT_EQ(samples[1], 2.5f);
+	EXPECT_EQ(column.unit(), DynamicUnit::of<Kilometres>());
+}
+
+TEST(DynamicValueTest, ConversionFactorsMatchScales) {
+	const auto kph = *unitFromSymbol("km/h");
+	const auto mps = DynamicUnit::of<MPS>();
+	EXPECT_EQ(kph.conversionFactorTo(mps), kph.scale() / mps.scale());
+	EXPECT_EQ(mps.conversionFactorTo(kph), mps.scale() / kph.scale());
+
+	// Products have no symbol and divide the scales instead
+	const auto product = DynamicUnit::of<Kilometres>() / DynamicUnit::of<Hours>();
+	EXPECT_FLOAT_EQ(product.conversionFactorTo(mps), kph.conversionFactorTo(mps));
+}
+
+TEST(DynamicValueTest, ComparisonsConvertToLhsUnit) {
+	const auto kilometre = DynamicValue{1_km};
+	const auto metres = DynamicValue{999_m};
+
+	EXPECT_TRUE(kilometre > metres);
+	EXPECT_TRUE(kilometre >= metres);
+	EXPECT_TRUE(metres <= kilometre);
+	EXPECT_FALSE(metres > kilometre);
+	EXPECT_TRUE(kilometre <= DynamicValue{1000_m});
+	EXPECT_TRUE(kilometre >= DynamicValue{1000_m});
+	EXPECT_THROW(kilometre > DynamicValue{1_s}, std::runtime_error);
+}
+
+} // anonymous namespace
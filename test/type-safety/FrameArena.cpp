@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+#include "type-safety/FrameArena.hpp"
+#include "type-safety/Xform.hpp"
+
+using namespace type_safety;
+
+namespace /* anonymous */ {
+
+using PlayerToWorld = Xform<space::Player, space::World>;
+
+bool isAligned(const void* p, std::size_t alignment) {
+	return reinterpret_cast<std::uintptr_t>(p) % alignment == 0;
+}
+
+TEST(FrameArenaTest, AllocationsAreCacheLineAligned) {
+	auto arena = FrameArena{4096};
+	for (auto bytes : { 1u, 3u, 64u, 100u }) {
+		EXPECT_TRUE(isAligned(arena.allocateBytes(bytes, 4), FrameArena::ALIGNMENT));
+	}
+	EXPECT_TRUE(isAligned(arena.allocateBytes(16, 256), 256));
+}
+
+TEST(FrameArenaTest, ResetReusesBlocks) {
+	auto arena = FrameArena{4096};
+	auto* first = arena.allocateBytes(1000);
+	arena.allocateBytes(1000);
+	EXPECT_EQ(arena.bytesUsed(), 2000u);
+	EXPECT_EQ(arena.blockCount(), 1u);
+
+	arena.reset();
+	EXPECT_EQ(arena.bytesUsed(), 0u);
+	EXPECT_EQ(arena.allocateBytes(1000), first);
+	EXPECT_EQ(arena.blockCount(), 1u);
+}
+
+TEST(FrameArenaTest, GrowsWithBlocksKeptAcrossResets) {
+	auto arena = FrameArena{4096};
+	arena.allocateBytes(3000);
+	arena.allocateBytes(3000);
+	arena.allocateBytes(10000);
+	EXPECT_EQ(arena.blockCount(), 3u);
+	// Oversized blocks are whole cache lines
+	EXPECT_EQ(arena.capacity(), 4096u + 4096u + 10048u);
+
+	arena.reset();
+	arena.allocateBytes(3000);
+	arena.allocateBytes(3000);
+	arena.allocateBytes(10000);
+	EXPECT_EQ(arena.blockCount(), 3u);
+}
+
+TEST(FrameArenaTest, SmallAllocationAfterLargeOneGetsItsOwnSpace) {
+	for (auto blockSize : { 1024u, 1000u }) {
+		auto arena = FrameArena{blockSize};
+		auto* large = static_cast<std::byte*>(arena.allocateBytes(2000));
+		auto* small = static_cast<std::byte*>(arena.allocateBytes(8));
+		EXPECT_EQ(arena.blockCount(), 2u);
+		EXPECT_TRUE(small + 8 <= large || small >= large + 2000);
+		std::memset(large, 0, 2000);
+		std::memset(small, 0, 8);
+	}
+
+	// The rounded up block size
+	auto arena = FrameArena{1000};
+	arena.allocateBytes(1000);
+	arena.allocateBytes(8);
+	EXPECT_EQ(arena.blockCount(), 2u);
+	EXPECT_EQ(arena.capacity(), 2u * 1024u);
+}
+
+TEST(FrameArenaTest, AllocatorBacksVectorsOfXforms) {
+	auto arena = FrameArena{4096};
+	// Parentheses, as Xforms are constructible from anything and braces would make a list of one
+	auto xforms = FrameVector<PlayerToWorld>(ArenaAllocator<PlayerToWorld>{arena});
+	for (auto i = 0; i < 100; ++i) {
+		auto xform = PlayerToWorld{};
+		xform.matrix().get(0, 3) = static_cast<float>(i);
+		xforms.push_back(xform);
+	}
+
+	EXPECT_TRUE(isAligned(xforms.data(), FrameArena::ALIGNMENT));
+	for (auto i = 0u; i < xforms.size(); ++i) {
+		EXPECT_EQ(xforms[i].matrix().get(0, 3), static_cast<float>(i));
+	}
+	EXPECT_GE(arena.bytesUsed(), 100 * sizeof(PlayerToWorld));
+}
+
+TEST(FrameArenaTest, IsAPmrMemoryResource) {
+	auto arena = FrameArena{4096};
+	auto points = std::pmr::vector<Point<space::World, Metres>>{&arena};
+	points.emplace_back(Vec3{1.0f, 2.0f, 3.0f});
+	points.emplace_back(Vec3{4.0f, 5.0f, 6.0f});
+
+	EXPECT_TRUE(isAligned(points.data(), FrameArena::ALIGNMENT));
+	EXPECT_EQ(points[1].vector().get(1), 5.0f);
+	EXPECT_GT(arena.bytesUsed(), 0u);
+}
+
+TEST(FrameArenaTest, ContainersDestroyedAfterResetKeepTheNextFrameIntact) {
+	auto arena = FrameArena{4096};
+	auto previousFrame = std::make_unique<FrameVector<float>>(64, 1.0f, ArenaAllocator<float>{arena});
+
+	arena.reset();
+	auto live = FrameVector<float>(64, 2.0f, ArenaAllocator<float>{arena});
+	ASSERT_EQ(static_cast<void*>(live.data()), static_cast<void*>(previousFrame->data()));
+
+	previousFrame.reset();
+	for (const auto f : live) {
+		EXPECT_EQ(f, 2.0f);
+	}
+}
+
+TEST(FrameArenaTest, AllocatorsCompareByArena) {
+	auto arena = FrameArena{};
+	auto otherArena = FrameArena{};
+	EXPECT_EQ(ArenaAllocator<int>{arena}, ArenaAllocator<float>{arena});
+	EXPECT_NE(ArenaAllocator<int>{arena}, ArenaAllocator<int>{otherArena});
+}
+
+#ifdef TYPE_SAFETY_ARENA_POISON
+
+bool isPoisoned(const void* p, std::size_t bytes) {
+	const auto* begin = static_cast<const std::byte*>(p);
+	for (auto i = std::size_t{0}; i < bytes; ++i) {
+		if (begin[i] != FrameArena::POISON_BYTE) {
+			return false;
+		}
+	}
+	return true;
+}
+
+TEST(FrameArenaTest, PoisonsResetMemory) {
+	auto arena = FrameArena{4096};
+	auto* deallocated = arena.allocateBytes(128);
+	auto* kept = arena.allocateBytes(128);
+	std::memset(deallocated, 0, 128);
+	std::memset(kept, 0, 128);
+
+	// Left alone, as the next frame may have reused it by the time it is deallocated
+	arena.deallocateBytes(deallocated, 128);
+	EXPECT_FALSE(isPoisoned(deallocated, 128));
+	EXPECT_FALSE(isPoisoned(kept, 128));
+
+	arena.reset();
+	EXPECT_TRUE(isPoisoned(deallocated, 128));
+	EXPECT_TRUE(isPoisoned(kept, 128));
+}
+
+#endif /* TYPE_SAFETY_ARENA_POISON */
+
+} // anonymous namespace
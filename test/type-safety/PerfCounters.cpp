@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+
+#include "type-safety/PerfCounters.hpp"
+
+namespace /* anonymous */ {
+
+using namespace type_safety;
+
+float busyLoop(int iterations) {
+	auto result = 0.0f;
+	for (auto i = 0; i < iterations; ++i) {
+		result = result * 0.5f + static_cast<float>(i);
+	}
+	return result;
+}
+
+TEST(PerfCountersTest, SampleIsEmptyByDefault) {
+	const auto sample = PerfSample{};
+	EXPECT_FALSE(sample[PerfEvent::CYCLES].has_value());
+	EXPECT_FALSE(sample.ipc().has_value());
+}
+
+TEST(PerfCountersTest, IpcIsInstructionsPerCycle) {
+	auto sample = PerfSample{};
+	sample[PerfEvent::CYCLES] = 200.0;
+	sample[PerfEvent::INSTRUCTIONS] = 300.0;
+	ASSERT_TRUE(sample.ipc().has_value());
+	EXPECT_DOUBLE_EQ(*sample.ipc(), 1.5);
+}
+
+TEST(PerfCountersTest, ProbeFillsOnlyAvailableEvents) {
+	auto counters = PerfCounters{};
+	auto sample = PerfSample{};
+	{
+		const auto probe = ScopedPerfProbe{counters, sample};
+		volatile auto result = busyLoop(100000);
+		static_cast<void>(result);
+	}
+
+	// Counters are typically unavailable in containers - this must not fail, just be empty
+	for (auto i = 0u; i < PERF_EVENT_COUNT; ++i) {
+		const auto event = static_cast<PerfEvent>(i);
+		if (!counters.available(event)) {
+			EXPECT_FALSE(sample[event].has_value());
+		}
+	}
+
+	if (counters.available(PerfEvent::INSTRUCTIONS) && sample[PerfEvent::INSTRUCTIONS]) {
+		EXPECT_GT(*sample[PerfEvent::INSTRUCTIONS], 100000.0);
+	}
+}
+
+} // anonymous namespace
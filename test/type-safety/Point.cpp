@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <type_traits>
+
+#include "type-safety/Point.hpp"
+#include "type-safety/Xform.hpp"
+
+using namespace type_safety;
+using namespace type_safety::unit_literals;
+
+namespace /* anonymous */ {
+
+template <class UnitT>
+using WorldVector = Vector<space::World, UnitT>;
+
+template <class UnitT>
+using WorldPoint = Point<space::World, UnitT>;
+
+void expectVec4Eq(const Vec4& actual, const Vec4& expected) {
+	for (auto i = 0u; i < 4u; ++i) {
+		EXPECT_FLOAT_EQ(actual.get(i), expected.get(i));
+	}
+}
+
+TEST(PointTest, UnitDefaultsToDimensionless) {
+	static_assert(std::is_same_v<Vector<space::World>::Unit, Dimensionless>);
+	static_assert(std::is_same_v<Point<space::World>::Unit, Dimensionless>);
+	static_assert(std::is_same_v<Velocity<space::World>, Vector<space::World, MPS>>);
+}
+
+TEST(PointTest, UnitTypedVectorsHaveNoOverhead) {
+	static_assert(sizeof(Velocity<space::World>) == sizeof(Vec4));
+	static_assert(sizeof(Position<space::Camera>) == sizeof(Vec4));
+}
+
+TEST(PointTest, VectorConvertsBetweenCompatibleUnits) {
+	const auto kms = WorldVector<Kilometres>{Vec3{1.0f, 2.0f, 3.0f}};
+	const auto ms = WorldVector<Metres>{kms};
+
+	expectVec4Eq(ms.vector(), Vec4{1000.0f, 2000.0f, 3000.0f, 0.0f});
+	expectVec4Eq(kms.vector<Metres>(), Vec4{1000.0f, 2000.0f, 3000.0f, 0.0f});
+}
+
+TEST(PointTest, PointConversionKeepsW) {
+	const auto kms = WorldPoint<Kilometres>{Vec3{1.0f, 2.0f, 3.0f}};
+	const auto ms = WorldPoint<Metres>{kms};
+
+	expectVec4Eq(ms.vector(), Vec4{1000.0f, 2000.0f, 3000.0f, 1.0f});
+}
+
+TEST(PointTest, MixedUnitVectorAdditionYieldsLhsUnit) {
+	const auto ms = WorldVector<Metres>{Vec3{1.0f, 2.0f, 3.0f}};
+	const auto kms = WorldVector<Kilometres>{Vec3{1.0f, 0.0f, -1.0f}};
+
+	const auto sum = ms + kms;
+	static_assert(std::is_same_v<std::decay_t<decltype(sum)>, WorldVector<Metres>>);
+	expectVec4Eq(sum.vector(), Vec4{1001.0f, 2.0f, -997.0f, 0.0f});
+
+	const auto diff = kms - ms;
+	static_assert(std::is_same_v<std::decay_t<decltype(diff)>, WorldVector<Kilometres>>);
+	expectVec4Eq(diff.vector(), Vec4{0.999f, -0.002f, -1.003f, 0.0f});
+
+	// Should not compile:
+	// WorldVector<MPS>{Vec3{1.0f, 0.0f, 0.0f}} + kms;
+}
+
+TEST(PointTest, PointVectorArithmetics) {
+	const auto p = WorldPoint<Metres>{Vec3{1.0f, 2.0f, 3.0f}};
+	const auto q = WorldPoint<Kilometres>{Vec3{0.001f, 0.001f, 0.001f}};
+	const auto v = WorldVector<Kilometres>{Vec3{0.001f, 0.0f, 0.0f}};
+
+	const auto pq = p - q;
+	static_assert(std::is_same_v<std::decay_t<decltype(pq)>, WorldVector<Metres>>);
+	expectVec4Eq(pq.vector(), Vec4{0.0f, 1.0f, 2.0f, 0.0f});
+
+	const auto moved = p + v;
+	static_assert(std::is_same_v<std::decay_t<decltype(moved)>, WorldPoint<Metres>>);
+	expectVec4Eq(moved.vector(), Vec4{2.0f, 2.0f, 3.0f, 1.0f});
+
+	expectVec4Eq((v + p).vector(), moved.vector());
+	expectVec4Eq((p - v).vector(), Vec4{0.0f, 2.0f, 3.0f, 1.0f});
+}
+
+TEST(PointTest, VectorScalingByValueChangesUnit) {
+	const auto velocity = Velocity<space::World>{Vec3{1.0f, 2.0f, 3.0f}};
+
+	const auto displacement = velocity * 2_s;
+	static_assert(std::is_same_v<std::decay_t<decltype(displacement)>, Displacement<space::World>>);
+	expectVec4Eq(displacement.vector(), Vec4{2.0f, 4.0f, 6.0f, 0.0f});
+
+	const auto acceleration = velocity / 0.5_s;
+	static_assert(std::is_same_v<std::decay_t<decltype(acceleration)>, AccelerationVector<space::World>>);
+	expectVec4Eq(acceleration.vector(), Vec4{2.0f, 4.0f, 6.0f, 0.0f});
+
+	const auto force = 2_kg * acceleration;
+	static_assert(std::is_same_v<std::decay_t<decltype(force)>, Vector<space::World, decltype(MPS2{} * Kilograms{})>>);
+	expectVec4Eq(force.vector<Newtons>(), Vec4{4.0f, 8.0f, 12.0f, 0.0f});
+
+	expectVec4Eq((-velocity * 2.0f / 4.0f).vector(), Vec4{-0.5f, -1.0f, -1.5f, 0.0f});
+}
+
+TEST(PointTest, XformApplyKeepsUnit) {
+	auto matrix = Matrix{};
+	for (auto row = 0u; row < 4u; ++row) {
+		for (auto col = 0u; col < 4u; ++col) {
+			matrix.get(row, col) = (row == col) ? 2.0f : 0.0f;
+		}
+	}
+	matrix.get(3, 3) = 1.0f;
+	matrix.get(0, 3) = 1.0f;
+
+	const auto worldToCamera = Xform<space::World, space::Camera>{matrix};
+
+	const auto velocity = worldToCamera.apply(Velocity<space::World>{Vec3{1.0f, 2.0f, 3.0f}});
+	static_assert(std::is_same_v<std::decay_t<decltype(velocity)>, Velocity<space::Camera>>);
+	expectVec4Eq(velocity.vector(), Vec4{2.0f, 4.0f, 6.0f, 0.0f});
+
+	const auto position = worldToCamera.apply(WorldPoint<Kilometres>{Vec3{1.0f, 2.0f, 3.0f}});
+	static_assert(std::is_same_v<std::decay_t<decltype(position)>, Point<space::Camera, Kilometres>>);
+	expectVec4Eq(position.vector(), Vec4{3.0f, 4.0f, 6.0f, 1.0f});
+}
+
+} // anonymous namespace
@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include "type-safety/Projection.hpp"
+
+using namespace type_safety;
+
+namespace /* anonymous */ {
+
+const auto FIELD_OF_VIEW = Angle{degreesTag, 90.0f};
+constexpr auto ASPECT_RATIO = 2.0f;
+constexpr auto NEAR_DISTANCE = 1.0f;
+constexpr auto FAR_DISTANCE = 100.0f;
+
+Point<space::NDC> project(
+	const ProjectiveXform<space::Camera>& projection,
+	const Vec3& cameraPoint
+) {
+	return perspectiveDivide(projection.apply(Point<space::Camera, Metres>{cameraPoint}));
+}
+
+void expectVec4Near(const Vec4& actual, const Vec4& expected, float tolerance) {
+	for (auto i = 0u; i < 4u; ++i) {
+		EXPECT_NEAR(actual.get(i), expected.get(i), tolerance);
+	}
+}
+
+TEST(ProjectionTest, PerspectiveMapsFrustumToNDCCube) {
+	const auto projection = makePerspectiveXform(FIELD_OF_VIEW, ASPECT_RATIO, NEAR_DISTANCE, FAR_DISTANCE);
+
+	const auto clip = projection.apply(Point<space::Camera, Metres>{Vec3{0.0f, 0.0f, -10.0f}});
+	static_assert(std::is_same_v<std::decay_t<decltype(clip)>, HomogeneousPoint<space::Clip, Metres>>);
+	EXPECT_FLOAT_EQ(clip.vector().get(3), 10.0f);
+
+	// tan(45 degrees) == 1, so the top right corner of a plane at distance d is (2d, d).
+	expectVec4Near(project(projection, Vec3{2.0f, 1.0f, -NEAR_DISTANCE}).vector(), Vec4{1.0f, 1.0f, -1.0f, 1.0f}, 1e-5f);
+	expectVec4Near(project(projection, Vec3{-200.0f, -100.0f, -FAR_DISTANCE}).vector(), Vec4{-1.0f, -1.0f, 1.0f, 1.0f}, 1e-5f);
+}
+
+TEST(ProjectionTest, InfinitePerspectiveApproachesOneAtInfinity) {
+	const auto projection = makeInfinitePerspectiveXform(FIELD_OF_VIEW, ASPECT_RATIO, NEAR_DISTANCE);
+	const auto finite = makePerspectiveXform(FIELD_OF_VIEW, ASPECT_RATIO, NEAR_DISTANCE, FAR_DISTANCE);
+
+	expectVec4Near(project(projection, Vec3{2.0f, 1.0f, -NEAR_DISTANCE}).vector(), Vec4{1.0f, 1.0f, -1.0f, 1.0f}, 1e-5f);
+	const auto far = project(projection, Vec3{0.0f, 0.0f, -1e6f}).vector();
+	EXPECT_NEAR(far.get(2), 1.0f, 1e-5f);
+	EXPECT_LT(project(projection, Vec3{0.0f, 0.0f, -FAR_DISTANCE}).vector().get(2), 1.0f);
+	EXPECT_FLOAT_EQ(projection.matrix().get(0, 0), finite.matrix().get(0, 0));
+	EXPECT_FLOAT_EQ(projection.matrix().get(1, 1), finite.matrix().get(1, 1));
+}
+
+TEST(ProjectionTest, OrthographicMapsBoxToNDCCube) {
+	const auto projection = makeOrthographicXform(-4.0f, 4.0f, -2.0f, 2.0f, NEAR_DISTANCE, FAR_DISTANCE);
+
+	const auto clip = projection.apply(Point<space::Camera, Metres>{Vec3{4.0f, -2.0f, -NEAR_DISTANCE}});
+	EXPECT_FLOAT_EQ(clip.vector().get(3), 1.0f);
+	expectVec4Near(perspectiveDivide(clip).vector(), Vec4{1.0f, -1.0f, -1.0f, 1.0f}, 1e-6f);
+	expectVec4Near(project(projection, Vec3{0.0f, 0.0f, -FAR_DISTANCE}).vector(), Vec4{0.0f, 0.0f, 1.0f, 1.0f}, 1e-6f);
+}
+
+TEST(ProjectionTest, ViewportMapsNDCToPixels) {
+	const auto viewport = makeViewportXform(10.0f, 20.0f, 640.0f, 480.0f);
+
+	const auto topLeft = viewport.apply(Point<space::NDC>{Vec3{-1.0f, 1.0f, -1.0f}});
+	static_assert(std::is_same_v<std::decay_t<decltype(topLeft)>, Point<space::Screen>>);
+	expectVec4Near(topLeft.vector(), Vec4{10.0f, 20.0f, 0.0f, 1.0f}, 1e-5f);
+	expectVec4Near(viewport.apply(Point<space::NDC>{Vec3{1.0f, -1.0f, 1.0f}}).vector(), Vec4{650.0f, 500.0f, 1.0f, 1.0f}, 1e-5f);
+}
+
+TEST(ProjectionTest, ChainsStayProjective) {
+	const auto worldToCamera = makeTranslationXform<space::World, space::Camera>(Vec3{0.0f, 0.0f, -10.0f});
+	const auto projection = makePerspectiveXform(FIELD_OF_VIEW, ASPECT_RATIO, NEAR_DISTANCE, FAR_DISTANCE);
+
+	const auto worldToClip = inSequence(worldToCamera, projection);
+	static_assert(std::is_same_v<decltype(worldToClip), const ProjectiveXform<space::World, space::Clip>>);
+	const auto p = Point<space::World, Metres>{Vec3{1.0f, 2.0f, 3.0f}};
+	expectVec4Near(worldToClip.apply(p).vector(), projection.apply(worldToCamera.apply(p)).vector(), 1e-5f);
+}
+
+TEST(ProjectionTest, ReciprocalIsAccurate) {
+	const float values[] = { 1.0f, 3.0f, -0.1f, 12345.0f };
+	const auto reciprocals = simd::reciprocal(simd::Float4::load(values));
+	float results[simd::LANES];
+	reciprocals.store(results);
+	for (auto lane = 0u; lane < simd::LANES; ++lane) {
+		EXPECT_NEAR(results[lane] * values[lane], 1.0f, 1e-6f);
+	}
+}
+
+TEST(ProjectionTest, ProjectAllMatchesStepByStep) {
+	const auto projection = makePerspectiveXform(FIELD_OF_VIEW, ASPECT_RATIO, NEAR_DISTANCE, FAR_DISTANCE);
+	const auto viewport = makeViewportXform(0.0f, 0.0f, 1920.0f, 1080.0f);
+
+	// Not a multiple of the SIMD width
+	auto points = std::vector<CompactPoint<space::Camera, Metres>>{};
+	for (auto i = 0u; i < 11u; ++i) {
+		const auto f = static_cast<float>(i);
+		points.emplace_back(Vec3{f - 5.0f, 0.5f * f - 2.0f, -2.0f - 3.0f * f});
+	}
+	auto results = std::vector<CompactPoint<space::Screen>>(points.size());
+
+	projectAll(projection, viewport, points.data(), points.size(), results.data());
+
+	for (auto i = std::size_t{0}; i < points.size(); ++i) {
+		const auto expected = viewport.apply(perspectiveDivide(projection.apply(points[i])));
+		expectVec4Near(results[i].vector(), expected.vector(), 1e-3f);
+	}
+}
+
+} // anonymous namespace
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <vector>
+
+#include "type-safety/StridedView.hpp"
+#include "type-safety/XformFixtures.hpp"
+
+using namespace type_safety;
+
+namespace /* anonymous */ {
+
+struct Vertex {
+	float position[3];
+	float normal[3];
+	float uv[2];
+};
+
+// Not a multiple of any packet size, so both the packet and the scalar path run
+constexpr auto VERTEX_COUNT = std::size_t{19};
+
+std::vector<Vertex> makeVertices() {
+	auto vertices = std::vector<Vertex>(VERTEX_COUNT);
+	for (auto i = 0u; i < vertices.size(); ++i) {
+		const auto f = static_cast<float>(i);
+		vertices[i] = Vertex{ { f, 2.0f * f, -f }, { 0.0f, 1.0f, f }, { 0.5f, 0.25f } };
+	}
+	return vertices;
+}
+
+template <class ElementT>
+void expectElementEq(const ElementT& actual, const ElementT& expected) {
+	for (auto axis = 0u; axis < 4u; ++axis) {
+		EXPECT_FLOAT_EQ(actual.vector().get(axis), expected.vector().get(axis));
+	}
+}
+
+TEST(StridedViewTest, ReadsAndWritesInterleavedElements) {
+	auto vertices = makeVertices();
+	const auto positions = StridedPointView<space::Player, Metres>{vertices.data(), vertices.size(), sizeof(Vertex), offsetof(Vertex, position)};
+	const auto normals = StridedVectorView<space::Player>{vertices.data(), vertices.size(), sizeof(Vertex), offsetof(Vertex, normal)};
+
+	EXPECT_EQ(positions.size(), VERTEX_COUNT);
+	expectElementEq(positions[3], Point<space::Player, Metres>{Vec3{3.0f, 6.0f, -3.0f}});
+	expectElementEq(normals[3], Vector<space::Player>{Vec3{0.0f, 1.0f, 3.0f}});
+
+	positions.set(3, Point<space::Player, Metres>{Vec3{7.0f, 8.0f, 9.0f}});
+	EXPECT_EQ(vertices[3].position[0], 7.0f);
+	EXPECT_EQ(vertices[3].position[2], 9.0f);
+	EXPECT_EQ(vertices[3].normal[2], 3.0f);
+	EXPECT_EQ(vertices[3].uv[0], 0.5f);
+}
+
+TEST(StridedViewTest, InPlaceApplyMatchesPerElementApply) {
+	auto vertices = makeVertices();
+	const auto xform = fixtures::affineXform<space::Player, space::World>();
+	const auto positions = StridedPointView<space::Player, Metres>{vertices.data(), vertices.size(), sizeof(Vertex), offsetof(Vertex, position)};
+	const auto normals = StridedVectorView<space::Player>{vertices.data(), vertices.size(), sizeof(Vertex), offsetof(Vertex, normal)};
+
+	auto expectedPositions = std::vector<Point<space::World, Metres>>{};
+	auto expectedNormals = std::vector<Vector<space::World>>{};
+	for (auto i = 0u; i < VERTEX_COUNT; ++i) {
+		expectedPositions.push_back(xform.apply(positions[i]));
+		expectedNormals.push_back(xform.apply(normals[i]));
+	}
+
+	const auto worldPositions = applyInPlace(xform, positions);
+	const auto worldNormals = applyInPlace(xform, normals);
+	static_assert(std::is_same_v<std::decay_t<decltype(worldPositions)>, StridedPointView<space::World, Metres>>);
+
+	for (auto i = 0u; i < VERTEX_COUNT; ++i) {
+		expectElementEq(worldPositions[i], expectedPositions[i]);
+		expectElementEq(worldNormals[i], expectedNormals[i]);
+		EXPECT_EQ(vertices[i].uv[1], 0.25f);
+	}
+}
+
+TEST(StridedViewTest, OutOfPlaceApplyMatchesPerElementApply) {
+	auto vertices = makeVertices();
+	const auto xform = fixtures::affineXform<space::Player, space::World>();
+	const auto positions = StridedPointView<space::Player, Metres>{vertices.data(), vertices.size(), sizeof(Vertex), offsetof(Vertex, position)};
+
+	auto packed = std::vector<float>(3 * VERTEX_COUNT);
+	const auto worldPositions = StridedPointView<space::World, Metres>{packed.data(), VERTEX_COUNT, 3 * sizeof(float), 0};
+	apply(xform, positions, worldPositions);
+
+	for (auto i = 0u; i < VERTEX_COUNT; ++i) {
+		expectElementEq(worldPositions[i], xform.apply(positions[i]));
+	}
+	EXPECT_EQ(vertices[1].position[0], 1.0f);
+}
+
+} // anonymous namespace
@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <type_traits>
+
+#include "type-safety/StructuredXform.hpp"
+
+using namespace type_safety;
+
+namespace /* anonymous */ {
+
+void expectVec4Eq(const Vec4& actual, const Vec4& expected) {
+	for (auto i = 0u; i < 4u; ++i) {
+		EXPECT_FLOAT_EQ(actual.get(i), expected.get(i));
+	}
+}
+
+void expectMatrixEq(const Matrix& actual, const Matrix& expected) {
+	for (auto row = 0u; row < 4u; ++row) {
+		for (auto column = 0u; column < 4u; ++column) {
+			EXPECT_NEAR(actual.get(row, column), expected.get(row, column), 1e-5f);
+		}
+	}
+}
+
+Matrix rotationAboutZ(float radians, float scale = 1.0f) {
+	auto matrix = Matrix::identity();
+	matrix.get(0, 0) = scale * std::cos(radians);
+	matrix.get(0, 1) = -scale * std::sin(radians);
+	matrix.get(1, 0) = scale * std::sin(radians);
+	matrix.get(1, 1) = scale * std::cos(radians);
+	matrix.get(2, 2) = scale;
+	matrix.get(0, 3) = 5.0f;
+	return matrix;
+}
+
+Matrix shear() {
+	auto matrix = Matrix::identity();
+	matrix.get(0, 1) = 0.5f;
+	matrix.get(2, 3) = -1.0f;
+	return matrix;
+}
+
+Matrix perspective() {
+	auto matrix = Matrix::identity();
+	matrix.get(3, 2) = -1.0f;
+	matrix.get(3, 3) = 0.0f;
+	return matrix;
+}
+
+TEST(StructuredXformTest, ClassifiesMatrices) {
+	auto translation = Matrix::identity();
+	translation.get(1, 3) = 2.0f;
+
+	EXPECT_EQ(classify(Matrix::identity()), XformStructure::IDENTITY);
+	EXPECT_EQ(classify(translation), XformStructure::TRANSLATION);
+	EXPECT_EQ(classify(rotationAboutZ(0.3f)), XformStructure::RIGID);
+	EXPECT_EQ(classify(rotationAboutZ(0.3f, 2.0f)), XformStructure::SIMILARITY);
+	EXPECT_EQ(classify(shear()), XformStructure::AFFINE);
+	EXPECT_EQ(classify(perspective()), XformStructure::PROJECTIVE);
+}
+
+TEST(StructuredXformTest, CostsNoStorage) {
+	static_assert(sizeof(TranslationXform<space::World, space::Camera>) == sizeof(Matrix));
+	static_assert(std::is_empty_v<IdentityXform<space::World>>);
+}
+
+TEST(StructuredXformTest, ApplyMatchesGeneralXform) {
+	const auto p = Point<space::World, Metres>{Vec3{1.0f, 2.0f, 3.0f}};
+	const auto v = Vector<space::World, Metres>{Vec3{-1.0f, 0.5f, 2.0f}};
+	const auto cp = CompactPoint<space::World, Metres>{Vec3{1.0f, 2.0f, 3.0f}};
+	const auto cv = CompactVector<space::World, Metres>{Vec3{-1.0f, 0.5f, 2.0f}};
+
+	const auto check = [&](const auto& structured) {
+		const auto& general = static_cast<const Xform<space::World, space::Camera>&>(structured);
+		expectVec4Eq(structured.apply(p).vector(), general.apply(p).vector());
+		expectVec4Eq(structured.apply(v).vector(), general.apply(v).vector());
+		expectVec4Eq(structured.apply(cp).vector(), general.apply(cp).vector());
+		expectVec4Eq(structured.apply(cv).vector(), general.apply(cv).vector());
+	};
+
+	check(StructuredXform<space::World, space::Camera, XformStructure::IDENTITY>{Matrix::identity()});
+	check(makeTranslationXform<space::World, space::Camera>(Vec3{1.0f, -2.0f, 3.0f}));
+	check(RigidXform<space::World, space::Camera>{rotationAboutZ(0.3f)});
+	check(makeUniformScaleXform<space::World, space::Camera>(3.0f));
+	check(AffineXform<space::World, space::Camera>{shear()});
+	check(StructuredXform<space::World, space::Camera, XformStructure::PROJECTIVE>{perspective()});
+}
+
+TEST(StructuredXformTest, CompositionPropagatesStructure) {
+	const auto translation = makeTranslationXform<space::World, space::Player>(Vec3{1.0f, 2.0f, 3.0f});
+	const auto moreTranslation = makeTranslationXform<space::Player, space::Camera>(Vec3{-1.0f, 0.0f, 1.0f});
+	const auto rotation = RigidXform<space::Player, space::Camera>{rotationAboutZ(0.3f)};
+	const auto scale = makeUniformScaleXform<space::Camera, space::Camera>(2.0f);
+
+	const auto translations = inSequence(translation, moreTranslation);
+	static_assert(std::is_same_v<decltype(translations), const TranslationXform<space::World, space::Camera>>);
+	expectMatrixEq(translations.matrix(), moreTranslation.matrix() * translation.matrix());
+
+	const auto rigid = inSequence(translation, rotation);
+	static_assert(std::is_same_v<decltype(rigid), const RigidXform<space::World, space::Camera>>);
+	expectMatrixEq(rigid.matrix(), rotation.matrix() * translation.matrix());
+
+	const auto similarity = inSequence(rigid, scale);
+	static_assert(std::is_same_v<decltype(similarity), const SimilarityXform<space::World, space::Camera>>);
+	expectMatrixEq(similarity.matrix(), scale.matrix() * rigid.matrix());
+	EXPECT_EQ(classify(similarity.matrix()), XformStructure::SIMILARITY);
+
+	// With a plain Xform the structure is lost
+	const auto general = inSequence(translation, Xform<space::Player, space::Camera>{shear()});
+	static_assert(std::is_same_v<decltype(general), const Xform<space::World, space::Camera>>);
+	expectMatrixEq(general.matrix(), shear() * translation.matrix());
+}
+
+TEST(StructuredXformTest, IdentityDisappearsFromChains) {
+	const auto identity = IdentityXform<space::World>{};
+	const auto translation = makeTranslationXform<space::World, space::Camera>(Vec3{1.0f, 2.0f, 3.0f});
+	const auto general = Xform<space::Camera, space::World>{shear()};
+
+	const auto chain = inSequence(identity, inSequence(translation, IdentityXform<space::Camera>{}));
+	static_assert(std::is_same_v<decltype(chain), const TranslationXform<space::World, space::Camera>>);
+	expectMatrixEq(chain.matrix(), translation.matrix());
+
+	const auto generalChain = inSequence(general, identity);
+	static_assert(std::is_same_v<decltype(generalChain), const Xform<space::Camera, space::World>>);
+	expectMatrixEq(generalChain.matrix(), general.matrix());
+
+	static_assert(std::is_same_v<decltype(inSequence(identity, identity)), IdentityXform<space::World>>);
+
+	const auto p = Point<space::World, Metres>{Vec3{1.0f, 2.0f, 3.0f}};
+	expectVec4Eq(identity.apply(p).vector(), p.vector());
+}
+
+TEST(StructuredXformTest, WithXformStructureDispatchesOnClassification) {
+	const auto check = [](const Matrix& matrix, XformStructure expected) {
+		const auto xform = Xform<space::World, space::Camera>{matrix};
+		const auto p = Point<space::World, Metres>{Vec3{1.0f, 2.0f, 3.0f}};
+		withXformStructure(xform, [&](const auto& structured) {
+				EXPECT_EQ(std::decay_t<decltype(structured)>::STRUCTURE_CLASS, expected);
+				expectVec4Eq(structured.apply(p).vector(), xform.apply(p).vector());
+			});
+	};
+
+	auto translation = Matrix::identity();
+	translation.get(0, 3) = 4.0f;
+
+	check(Matrix::identity(), XformStructure::IDENTITY);
+	check(translation, XformStructure::TRANSLATION);
+	check(rotationAboutZ(1.0f), XformStructure::RIGID);
+	check(rotationAboutZ(1.0f, 0.5f), XformStructure::SIMILARITY);
+	check(shear(), XformStructure::AFFINE);
+	check(perspective(), XformStructure::PROJECTIVE);
+}
+
+} // anonymous namespace
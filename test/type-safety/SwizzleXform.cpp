@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+
+#include <type_traits>
+
+#include "type-safety/SwizzleXform.hpp"
+
+using namespace type_safety;
+
+namespace /* anonymous */ {
+
+void expectVec4Eq(const Vec4& actual, const Vec4& expected) {
+	for (auto i = 0u; i < 4u; ++i) {
+		EXPECT_FLOAT_EQ(actual.get(i), expected.get(i));
+	}
+}
+
+void expectMatrixEq(const Matrix& actual, const Matrix& expected) {
+	for (auto row = 0u; row < 4u; ++row) {
+		for (auto column = 0u; column < 4u; ++column) {
+			EXPECT_FLOAT_EQ(actual.get(row, column), expected.get(row, column));
+		}
+	}
+}
+
+Matrix someMatrix() {
+	auto matrix = Matrix{};
+	for (auto row = 0u; row < 4u; ++row) {
+		for (auto column = 0u; column < 4u; ++column) {
+			matrix.get(row, column) = static_cast<float>(row * 4u + column + 1u);
+		}
+	}
+	return matrix;
+}
+
+TEST(SwizzleXformTest, IsEmpty) {
+	static_assert(std::is_empty_v<ConventionXform<space::ZUpRightHanded, space::YUpRightHanded>>);
+}
+
+TEST(SwizzleXformTest, ConvertsBetweenConventions) {
+	// Up, right and away from the viewer in every convention
+	const auto yUpRight = Point<space::YUpRightHanded, Metres>{Vec3{1.0f, 2.0f, -3.0f}};
+	const auto zUpRight = Point<space::ZUpRightHanded, Metres>{Vec3{1.0f, 3.0f, 2.0f}};
+	const auto yUpLeft = Point<space::YUpLeftHanded, Metres>{Vec3{1.0f, 2.0f, 3.0f}};
+	const auto zUpLeft = Point<space::ZUpLeftHanded, Metres>{Vec3{3.0f, 1.0f, 2.0f}};
+
+	expectVec4Eq(ConventionXform<space::ZUpRightHanded, space::YUpRightHanded>{}.apply(zUpRight).vector(), yUpRight.vector());
+	expectVec4Eq(ConventionXform<space::YUpRightHanded, space::ZUpRightHanded>{}.apply(yUpRight).vector(), zUpRight.vector());
+	expectVec4Eq(ConventionXform<space::YUpLeftHanded, space::YUpRightHanded>{}.apply(yUpLeft).vector(), yUpRight.vector());
+	expectVec4Eq(ConventionXform<space::ZUpLeftHanded, space::ZUpRightHanded>{}.apply(zUpLeft).vector(), zUpRight.vector());
+	expectVec4Eq(ConventionXform<space::ZUpRightHanded, space::ZUpLeftHanded>{}.apply(zUpRight).vector(), zUpLeft.vector());
+}
+
+TEST(SwizzleXformTest, ApplyMatchesMatrix) {
+	const auto xform = ConventionXform<space::ZUpLeftHanded, space::YUpRightHanded>{};
+	const auto general = Xform<space::ZUpLeftHanded, space::YUpRightHanded>{xform};
+	const auto p = Point<space::ZUpLeftHanded, Metres>{Vec3{1.0f, 2.0f, 3.0f}};
+	const auto v = Vector<space::ZUpLeftHanded, Metres>{Vec3{-1.0f, 0.5f, 2.0f}};
+	const auto cp = CompactPoint<space::ZUpLeftHanded, Metres>{Vec3{1.0f, 2.0f, 3.0f}};
+	const auto cv = CompactVector<space::ZUpLeftHanded, Metres>{Vec3{-1.0f, 0.5f, 2.0f}};
+
+	expectVec4Eq(xform.apply(p).vector(), general.apply(p).vector());
+	expectVec4Eq(xform.apply(v).vector(), general.apply(v).vector());
+	expectVec4Eq(xform.apply(cp).vector(), general.apply(cp).vector());
+	expectVec4Eq(xform.apply(cv).vector(), general.apply(cv).vector());
+}
+
+TEST(SwizzleXformTest, ComposesAtCompileTime) {
+	const auto there = ConventionXform<space::ZUpLeftHanded, space::YUpLeftHanded>{};
+	const auto back = ConventionXform<space::YUpLeftHanded, space::ZUpLeftHanded>{};
+
+	const auto roundTrip = inSequence(there, back);
+	static_assert(std::is_same_v<
+		std::decay_t<decltype(roundTrip)>,
+		SwizzleXform<space::ZUpLeftHanded, space::ZUpLeftHanded, SignedAxis::PLUS_X, SignedAxis::PLUS_Y, SignedAxis::PLUS_Z>
+		>);
+
+	const auto viaYUpLeft = inSequence(there, ConventionXform<space::YUpLeftHanded, space::ZUpRightHanded>{});
+	static_assert(std::is_same_v<
+		std::decay_t<decltype(viaYUpLeft)>,
+		ConventionXform<space::ZUpLeftHanded, space::ZUpRightHanded>
+		>);
+}
+
+TEST(SwizzleXformTest, FoldsIntoXforms) {
+	const auto swizzle = ConventionXform<space::ZUpRightHanded, space::YUpLeftHanded>{};
+	const auto before = Xform<space::World, space::ZUpRightHanded>{someMatrix()};
+	const auto after = Xform<space::YUpLeftHanded, space::World>{someMatrix()};
+
+	const auto swizzleFirst = inSequence(swizzle, after);
+	static_assert(std::is_same_v<decltype(swizzleFirst), const Xform<space::ZUpRightHanded, space::World>>);
+	expectMatrixEq(swizzleFirst.matrix(), after.matrix() * swizzle.matrix());
+
+	const auto swizzleLast = inSequence(before, swizzle);
+	static_assert(std::is_same_v<decltype(swizzleLast), const Xform<space::World, space::YUpLeftHanded>>);
+	expectMatrixEq(swizzleLast.matrix(), swizzle.matrix() * before.matrix());
+}
+
+} // anonymous namespace
@@ -0,0 +1,203 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "type-safety/TransformTable.hpp"
+
+using namespace type_safety;
+
+namespace /* anonymous */ {
+
+using PlayerToWorld = Xform<space::Player, space::World>;
+
+// Every element of the matrix is the same value, so a torn read shows as differing elements
+PlayerToWorld uniformXform(float value) {
+	auto xform = PlayerToWorld{};
+	for (auto row = 0u; row < 4u; ++row) {
+		for (auto column = 0u; column < 4u; ++column) {
+			xform.matrix().get(row, column) = value;
+		}
+	}
+	return xform;
+}
+
+bool isUniform(const PlayerToWorld& xform, float value) {
+	for (auto row = 0u; row < 4u; ++row) {
+		for (auto column = 0u; column < 4u; ++column) {
+			if (xform.matrix().get(row, column) != value) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+float firstElement(const PlayerToWorld& xform) {
+	return xform.matrix().get(0, 0);
+}
+
+TEST(TransformTableTest, StartsWithInitialXforms) {
+	const auto table = TransformTable<space::Player, space::World>{3, uniformXform(1.0f)};
+	EXPECT_EQ(table.size(), 3u);
+	EXPECT_EQ(table.epoch(), 0u);
+	for (auto index = 0u; index < table.size(); ++index) {
+		EXPECT_TRUE(isUniform(table.read(index), 1.0f));
+	}
+}
+
+TEST(TransformTableTest, ReadsWrittenXforms) {
+	auto table = TransformTable<space::Player, space::World>{3, uniformXform(0.0f)};
+	table.write(1, uniformXform(2.0f));
+
+	EXPECT_TRUE(isUniform(table.read(0), 0.0f));
+	EXPECT_TRUE(isUniform(table.read(1), 2.0f));
+	EXPECT_TRUE(isUniform(table.read(2), 0.0f));
+}
+
+TEST(TransformTableTest, BulkUpdateIsInvisibleUntilPublished) {
+	auto table = TransformTable<space::Player, space::World>{2, uniformXform(0.0f)};
+	table.write(0, uniformXform(1.0f));
+
+	auto update = table.beginBulkUpdate();
+	update.write(1, uniformXform(2.0f));
+	EXPECT_TRUE(isUniform(table.read(1), 0.0f));
+
+	update.publish();
+	EXPECT_EQ(table.epoch(), 1u);
+	EXPECT_TRUE(isUniform(table.read(0), 1.0f));
+	EXPECT_TRUE(isUniform(table.read(1), 2.0f));
+}
+
+TEST(TransformTableTest, UnpublishedBulkUpdateIsDiscarded) {
+	auto table = TransformTable<space::Player, space::World>{1, uniformXform(0.0f)};
+	{
+		auto update = table.beginBulkUpdate();
+		update.write(0, uniformXform(5.0f));
+	}
+	EXPECT_EQ(table.epoch(), 0u);
+	EXPECT_TRUE(isUniform(table.read(0), 0.0f));
+
+	// The next update starts from the current entries, not the discarded ones
+	auto update = table.beginBulkUpdate();
+	update.publish();
+	EXPECT_TRUE(isUniform(table.read(0), 0.0f));
+}
+
+TEST(TransformTableTest, KeepsRuntimeSpaces) {
+	auto table = TransformTable<space::PlayerAtFrame, space::World>{
+		1, makeXform(space::PlayerAtFrame{7}, space::World{})};
+	const auto xform = table.read(0);
+#ifdef DO_SPACE_RUNTIME_CHECKS
+	EXPECT_EQ(xform.fromSpace().frameId, 7);
+#else
+	static_cast<void>(xform);
+#endif /* DO_SPACE_RUNTIME_CHECKS */
+}
+
+TEST(TransformTableTest, ConcurrentReadersNeverSeeTornXforms) {
+	constexpr auto ENTRIES = 4u;
+	constexpr auto READERS = 3;
+	constexpr auto UPDATES = 20000;
+
+	auto table = TransformTable<space::Player, space::World>{ENTRIES, uniformXform(0.0f)};
+	auto done = std::atomic<bool>{false};
+	auto tornReads = std::atomic<int>{0};
+	auto inconsistentEpochs = std::atomic<int>{0};
+
+	auto readers = std::vector<std::thread>{};
+	for (auto reader = 0; reader < READERS; ++reader) {
+		readers.emplace_back([&]() {
+			auto all = std::vector<PlayerToWorld>(ENTRIES);
+			while (!done.load()) {
+				const auto xform = table.read(1);
+				if (!isUniform(xform, firstElement(xform))) {
+					++tornReads;
+				}
+
+				// Bulk updates write the same value to every entry
+				table.readAll(all.data());
+				for (const auto& entry : all) {
+					if (!isUniform(entry, firstElement(all[0]))) {
+						++inconsistentEpochs;
+					}
+				}
+			}
+		});
+	}
+
+	for (auto update = 1; update <= UPDATES; ++update) {
+		auto bulk = table.beginBulkUpdate();
+		for (auto index = 0u; index < ENTRIES; ++index) {
+			bulk.write(index, uniformXform(static_cast<float>(update)));
+		}
+		bulk.publish();
+	}
+	done = true;
+	for (auto& reader : readers) {
+		reader.join();
+	}
+
+	EXPECT_EQ(tornReads.load(), 0);
+	EXPECT_EQ(inconsistentEpochs.load(), 0);
+	EXPECT_TRUE(isUniform(table.read(ENTRIES - 1), static_cast<float>(UPDATES)));
+}
+
+TEST(TransformTableTest, ConcurrentReadersNeverSeeDiscardedBulkUpdates) {
+	constexpr auto ENTRIES = 4u;
+	constexpr auto READERS = 3;
+	constexpr auto UPDATES = 20000;
+	constexpr auto DISCARDED = -1.0f;
+
+	auto table = TransformTable<space::Player, space::World>{ENTRIES, uniformXform(0.0f)};
+	auto done = std::atomic<bool>{false};
+	auto discardedReads = std::atomic<int>{0};
+
+	auto readers = std::vector<std::thread>{};
+	for (auto reader = 0; reader < READERS; ++reader) {
+		readers.emplace_back([&]() {
+			auto all = std::vector<PlayerToWorld>(ENTRIES);
+			while (!done.load()) {
+				for (auto index = 0u; index < ENTRIES; ++index) {
+					if (firstElement(table.read(index)) == DISCARDED) {
+						++discardedReads;
+					}
+				}
+				table.readAll(all.data());
+				for (const auto& entry : all) {
+					if (firstElement(entry) == DISCARDED) {
+						++discardedReads;
+					}
+				}
+			}
+		});
+	}
+
+	// Every published update is followed by one written to the buffer readers of the previous
+	// epoch may still be reading, and discarded
+	for (auto update = 1; update <= UPDATES; ++update) {
+		{
+			auto bulk = table.beginBulkUpdate();
+			for (auto index = 0u; index < ENTRIES; ++index) {
+				bulk.write(index, uniformXform(static_cast<float>(update)));
+			}
+			bulk.publish();
+		}
+		{
+			auto discarded = table.beginBulkUpdate();
+			for (auto index = 0u; index < ENTRIES; ++index) {
+				discarded.write(index, uniformXform(DISCARDED));
+			}
+		}
+	}
+	done = true;
+	for (auto& reader : readers) {
+		reader.join();
+	}
+
+	EXPECT_EQ(discardedReads.load(), 0);
+	EXPECT_TRUE(isUniform(table.read(0), static_cast<float>(UPDATES)));
+}
+
+} // anonymous namespace
@@ -1,7 +1,10 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <sstream>
+
 #include "type-safety/Unit.hpp"
+#include "type-safety/UnitIO.hpp"
 
 using namespace type_safety;
 using namespace type_safety::unit_literals;
@@ -109,6 +112,9 @@ TEST(UnitTest, LiteralsCreation) {
 
 	static_assert(floatEq((4.2_N).value<Newtons>(), 4.2f));
 	static_assert(floatEq((4_N).value<Newtons>(), 4.0f));
+
+	static_assert(floatEq((4.2_J).value<Joules>(), 4.2f));
+	static_assert(floatEq((4_J).value<Joules>(), 4.0f));
 }
 
 TEST(UnitTest, ValueAddition) {
@@ -154,25 +160,16 @@ TEST(UnitTest, MassValueMultiplication) {
 	constexpr auto threeG = 3_g;
 
 	using GKg = decltype(Grams{} * Kilograms{});
-	static_assert(std::ratio_equal_v<GKg::TO_M_RATIO, std::ratio<1, 1>>);
-	static_assert(GKg::M_EXP == 0);
-	static_assert(std::ratio_equal_v<GKg::TO_KG_RATIO, Grams::TO_KG_RATIO>);
-	static_assert(GKg::KG_EXP == 2);
-	static_assert(std::ratio_equal_v<GKg::TO_S_RATIO, std::ratio<1, 1>>);
-	static_assert(GKg::S_EXP == 0);
+	static_assert(std::is_same_v<GKg::Scale, Grams::Scale>);
+	static_assert(GKg::EXPONENT<Dimension::LENGTH> == 0);
+	static_assert(GKg::EXPONENT<Dimension::MASS> == 2);
+	static_assert(GKg::EXPONENT<Dimension::TIME> == 0);
 
 	using GramsSq = decltype(Grams{} * Grams{});
-	static_assert(std::ratio_equal_v<GramsSq::TO_M_RATIO, std::ratio<1, 1>>);
-	static_assert(GramsSq::M_EXP == 0);
-	static_assert(
-		std::ratio_equal_v<
-			GramsSq::TO_KG_RATIO,
-			std::ratio_multiply<Grams::TO_KG_RATIO, Grams::TO_KG_RATIO>
-		>
-	);
-	static_assert(GramsSq::KG_EXP == 2);
-	static_assert(std::ratio_equal_v<GramsSq::TO_S_RATIO, std::ratio<1, 1>>);
-	static_assert(GramsSq::S_EXP == 0);
+	static_assert(std::is_same_v<GramsSq::Scale, std::micro>);
+	static_assert(GramsSq::EXPONENT<Dimension::LENGTH> == 0);
+	static_assert(GramsSq::EXPONENT<Dimension::MASS> == 2);
+	static_assert(GramsSq::EXPONENT<Dimension::TIME> == 0);
 
 	constexpr auto sixThousandGSq = threeKg * twoG;
 	static_assert(std::is_same_v<std::decay_t<decltype(sixThousandGSq)>, Value<GKg>>);
@@ -186,6 +183,42 @@ TEST(UnitTest, MassValueMultiplication) {
 	static_assert(floatEq(sixGSq.value<decltype(Kilograms{} * Kilograms{})> (), 0.000006f));
 }
 
+TEST(UnitTest, UnitAlgebraYieldsReducedRatios) {
+	using KmPerM = decltype(Kilometres{} / Metres{});
+	static_assert(std::is_same_v<KmPerM::Scale, std::kilo>);
+	static_assert(std::is_same_v<decltype(KmPerM{} * Metres{}), Kilometres>);
+
+	using MsPerH = decltype(Milliseconds{} / Hours{});
+	static_assert(std::is_same_v<MsPerH::Scale, std::ratio<1, 3600000>>);
+	static_assert(std::is_same_v<decltype(MsPerH{} * Hours{}), Milliseconds>);
+
+	static_assert(std::is_same_v<MassUnit<std::ratio<2000, 2>>, Tonnes>);
+
+	static_assert(Kilometres::IS_IDENTITY_CONVERSION_TO<decltype(Metres{} * Kilometres{} / Metres{})>);
+	static_assert(!Kilometres::IS_IDENTITY_CONVERSION_TO<Metres>);
+}
+
+TEST(UnitTest, EquivalentUnitsAreTheSameType) {
+	static_assert(std::is_same_v<decltype(Kilograms{} * MPS2{}), Newtons>);
+	static_assert(std::is_same_v<decltype(MPS2{} * Kilograms{}), Newtons>);
+	static_assert(std::is_same_v<decltype(Kilograms{} * Metres{} / Seconds{} / Seconds{}), Newtons>);
+	static_assert(std::is_same_v<decltype(Kilograms{} * Metres{} * Metres{} / (Seconds{} * Seconds{})), Joules>);
+	static_assert(std::is_same_v<decltype(Grams{} * Kilometres{}), decltype(Kilograms{} * Metres{})>);
+	static_assert(std::is_same_v<decltype(Metres{} / Metres{}), Dimensionless>);
+	static_assert(std::is_same_v<decltype(Seconds{} * MPS{}), Metres>);
+}
+
+TEST(UnitTest, DimensionsBeyondMechanics) {
+	using Coulombs = decltype(Amperes{} * Seconds{});
+	static_assert(Coulombs::EXPONENT<Dimension::CURRENT> == 1);
+	static_assert(Coulombs::EXPONENT<Dimension::TIME> == 1);
+	static_assert(std::is_same_v<decltype(Coulombs{} / Seconds{}), Amperes>);
+
+	constexpr auto charge = makeValue<Amperes>(2.0f) * 3_s;
+	static_assert(floatEq((charge / 1_min).value<Amperes>(), 0.1f));
+	static_assert(floatEq((makeValue<Kelvins>(3.0f) * 2_kg).value<decltype(Kelvins{} * Grams{})>(), 6000.0f));
+}
+
 TEST(UnitTest, ValueDivisionByUnitless) {
 	constexpr auto twoKg = 4_kg / 2.0f;
 	static_assert(std::is_same_v<std::decay_t<decltype(twoKg)>, Value<Kilograms>>);
@@ -217,6 +250,7 @@ TEST(UnitTest, PrintsValuesWithUnitSuffix) {
 		<< 42_kph << '\n'
 		<< 42_mps2 << '\n'
 		<< 42_N << '\n'
+		<< 42_J << '\n'
 		;
 
 	EXPECT_EQ(
@@ -231,6 +265,7 @@ TEST(UnitTest, PrintsValuesWithUnitSuffix) {
 			"42_km/h\n"
 			"42_m/s2\n"
 			"42_N\n"
+			"42_J\n"
 	);
 }
 
@@ -1,7 +1,9 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <cstring>
 #include <type_traits>
+#include <vector>
 
 #include "type-safety/Xform.hpp"
 
@@ -79,4 +81,30 @@ TEST(XformTest, ImplicitlyConvertibleSpacesMatch) {
 	inSequence(inSequence(worldToPlayer, playerAt1ToPlayerAt2), playerToCamera);
 }
 
+TEST(XformTest, CopiesMatrixOfNonConstXform) {
+	auto source = Xform<space::World, space::Player>{};
+	source.matrix().get(1, 2) = 42.0f;
+
+	auto copy = source;
+	EXPECT_EQ(copy.matrix().get(1, 2), 42.0f);
+}
+
+TEST(XformTest, XformArraysAreRelocatableWithMemcpy) {
+	auto source = std::vector<Xform<space::PlayerAtFrame, space::World>>{};
+	for (auto i = 0; i < 3; ++i) {
+		source.push_back(makeXform(space::PlayerAtFrame{i}, space::World{}));
+		source.back().matrix().get(0, 3) = static_cast<float>(i);
+	}
+
+	auto target = std::vector<Xform<space::PlayerAtFrame, space::World>>(source.rbegin(), source.rend());
+	std::memcpy(target.data(), source.data(), source.size() * sizeof(source.front()));
+
+	for (auto i = 0u; i < target.size(); ++i) {
+		EXPECT_EQ(target[i].matrix().get(0, 3), static_cast<float>(i));
+#ifdef DO_SPACE_RUNTIME_CHECKS
+		EXPECT_EQ(target[i].fromSpace().frameId, static_cast<int>(i));
+#endif /* DO_SPACE_RUNTIME_CHECKS */
+	}
+}
+
 } // anonymous namespace
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "type-safety/Xform.hpp"
+
+namespace fixtures {
+
+// An affine xform exercising every part of the matrix the point layouts skip or keep: a
+// rotation about z, a scale and shear mixing z into y, and a translation.
+template <class FromSpaceT, class ToSpaceT>
+type_safety::Xform<FromSpaceT, ToSpaceT> affineXform() {
+	auto xform = type_safety::Xform<FromSpaceT, ToSpaceT>{};
+	const float elements[4][4] = {
+		{ 0.0f, -1.0f, 0.0f, 10.0f },
+		{ 1.0f, 0.0f, 0.5f, 20.0f },
+		{ 0.0f, 0.0f, 2.0f, 30.0f },
+		{ 0.0f, 0.0f, 0.0f, 1.0f },
+	};
+	for (auto row = 0u; row < 4u; ++row) {
+		for (auto column = 0u; column < 4u; ++column) {
+			xform.matrix().get(row, column) = elements[row][column];
+		}
+	}
+	return xform;
+}
+
+} // namespace fixtures
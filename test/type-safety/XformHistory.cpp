@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+#include "type-safety/XformHistory.hpp"
+
+using namespace type_safety;
+
+namespace /* anonymous */ {
+
+Matrix translation(float x) {
+	auto matrix = Matrix{};
+	for (auto row = 0u; row < 4u; ++row) {
+		for (auto column = 0u; column < 4u; ++column) {
+			matrix.get(row, column) = row == column ? 1.0f : 0.0f;
+		}
+	}
+	matrix.get(0, 3) = x;
+	return matrix;
+}
+
+float translationX(const Xform<space::PlayerAtFrame, space::World>& xform) {
+	return xform.matrix().get(0, 3);
+}
+
+TEST(XformHistoryTest, CapacityIsRoundedUpToAPowerOfTwo) {
+	EXPECT_EQ(XformHistory<>{60}.capacity(), 64u);
+	EXPECT_EQ(XformHistory<>{64}.capacity(), 64u);
+}
+
+TEST(XformHistoryTest, EmptyHistoryHasNoFrames) {
+	const auto history = XformHistory<>{8};
+	EXPECT_FALSE(history.latestFrame().has_value());
+	EXPECT_FALSE(history.at(0).has_value());
+	EXPECT_FALSE(history.interpolated(0.5f).has_value());
+}
+
+TEST(XformHistoryTest, LooksUpRecordedFrames) {
+	auto history = XformHistory<>{8};
+	for (auto frame = 100; frame < 105; ++frame) {
+		history.record(frame, translation(static_cast<float>(frame)));
+	}
+
+	EXPECT_EQ(history.latestFrame(), 104);
+	const auto xform = history.at(102);
+	ASSERT_TRUE(xform.has_value());
+	EXPECT_FLOAT_EQ(translationX(*xform), 102.0f);
+#ifdef DO_SPACE_RUNTIME_CHECKS
+	EXPECT_EQ(xform->fromSpace().frameId, 102);
+#endif /* DO_SPACE_RUNTIME_CHECKS */
+	EXPECT_FALSE(history.at(99).has_value());
+	EXPECT_FALSE(history.at(105).has_value());
+}
+
+TEST(XformHistoryTest, EvictsFramesOlderThanCapacity) {
+	auto history = XformHistory<>{4};
+	for (auto frame = 0; frame < 10; ++frame) {
+		history.record(frame, translation(static_cast<float>(frame)));
+	}
+
+	for (auto frame = 0; frame < 6; ++frame) {
+		EXPECT_FALSE(history.at(frame).has_value()) << frame;
+	}
+	for (auto frame = 6; frame < 10; ++frame) {
+		EXPECT_TRUE(history.at(frame).has_value()) << frame;
+	}
+}
+
+TEST(XformHistoryTest, HandlesNegativeFrameIds) {
+	auto history = XformHistory<>{4};
+	history.record(-1, translation(-1.0f));
+	history.record(0, translation(0.0f));
+
+	EXPECT_FLOAT_EQ(translationX(*history.at(-1)), -1.0f);
+	EXPECT_FLOAT_EQ(translationX(*history.interpolated(-0.5f)), -0.5f);
+}
+
+TEST(XformHistoryTest, InterpolatesBetweenFrames) {
+	auto history = XformHistory<>{8};
+	history.record(10, translation(1.0f));
+	history.record(11, translation(3.0f));
+
+	EXPECT_FLOAT_EQ(translationX(*history.interpolated(10.25f)), 1.5f);
+	EXPECT_FLOAT_EQ(translationX(*history.interpolated(10.0f)), 1.0f);
+	EXPECT_FLOAT_EQ(history.interpolated(10.5f)->matrix().get(1, 1), 1.0f);
+	EXPECT_FALSE(history.interpolated(11.5f).has_value());
+	EXPECT_FALSE(history.interpolated(9.5f).has_value());
+}
+
+TEST(XformHistoryTest, ConcurrentLookupsSeeRecordedMatrices) {
+	constexpr auto FRAMES = 50000;
+
+	auto history = XformHistory<>{16};
+	auto done = std::atomic<bool>{false};
+	auto wrongMatrices = std::atomic<int>{0};
+
+	auto reader = std::thread{[&]() {
+		while (!done.load()) {
+			const auto latest = history.latestFrame();
+			if (!latest) {
+				continue;
+			}
+			for (auto frame = *latest - 15; frame <= *latest; ++frame) {
+				const auto xform = history.at(frame);
+				if (xform && translationX(*xform) != static_cast<float>(frame)) {
+					++wrongMatrices;
+				}
+			}
+		}
+	}};
+
+	for (auto frame = 0; frame < FRAMES; ++frame) {
+		history.record(frame, translation(static_cast<float>(frame)));
+	}
+	done = true;
+	reader.join();
+
+	EXPECT_EQ(wrongMatrices.load(), 0);
+}
+
+} // anonymous namespace
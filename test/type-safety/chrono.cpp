@@ -0,0 +1,44 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <type_traits>
+
+#include "type-safety/chrono.hpp"
+
+using namespace type_safety;
+using namespace type_safety::unit_literals;
+
+namespace /* anonymous */ {
+
+TEST(ChronoTest, DurationKeepsItsPeriod) {
+	constexpr auto value = fromDuration(std::chrono::milliseconds{16});
+	static_assert(std::is_same_v<decltype(value), const Value<Milliseconds>>);
+	static_assert(floatEq(value.value<Milliseconds>(), 16.0f));
+	static_assert(floatEq(value.value<Seconds>(), 0.016f));
+}
+
+TEST(ChronoTest, ClockDurationsAreNanoseconds) {
+	using Duration = std::chrono::steady_clock::duration;
+	if constexpr (std::is_same_v<Duration::period, std::nano>) {
+		static_assert(std::is_same_v<decltype(fromDuration(Duration{})), Value<Nanoseconds>>);
+	}
+
+	constexpr auto value = fromDuration(std::chrono::nanoseconds{1500});
+	static_assert(floatEq(value.value<Microseconds>(), 1.5f));
+}
+
+TEST(ChronoTest, ValueConvertsToDurationOfItsUnit) {
+	constexpr auto duration = toDuration(250_us);
+	static_assert(std::is_same_v<decltype(duration), const std::chrono::duration<float, std::micro>>);
+	static_assert(floatEq(duration.count(), 250.0f));
+
+	const auto seconds = std::chrono::duration_cast<std::chrono::duration<float>>(toDuration(1.5_min));
+	EXPECT_FLOAT_EQ(seconds.count(), 90.0f);
+}
+
+TEST(ChronoTest, RoundTripIsIdentity) {
+	constexpr auto value = 42.0_ms;
+	static_assert(floatEq(fromDuration(toDuration(value)).value<Milliseconds>(), 42.0f));
+}
+
+} // anonymous namespace
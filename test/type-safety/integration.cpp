@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "type-safety/integration.hpp"
+
+using namespace type_safety;
+using namespace type_safety::unit_literals;
+
+namespace /* anonymous */ {
+
+// Not a multiple of any packet width, so every test covers the scalar tail too
+constexpr auto PARTICLES = std::size_t{37};
+
+TEST(IntegrationTest, SemiImplicitEulerUsesTheUpdatedVelocity) {
+	auto positions = std::vector<Distance>(PARTICLES, 0_m);
+	auto velocities = std::vector<Speed>(PARTICLES, 1_mps);
+	const auto accelerations = std::vector<Acceleration>(PARTICLES, 2_mps2);
+
+	semiImplicitEuler(positions.data(), velocities.data(), accelerations.data(), PARTICLES, 0.5_s);
+
+	for (auto i = 0u; i < PARTICLES; ++i) {
+		EXPECT_FLOAT_EQ(velocities[i].value<MPS>(), 2.0f);
+		EXPECT_FLOAT_EQ(positions[i].value<Metres>(), 1.0f);
+	}
+}
+
+TEST(IntegrationTest, SemiImplicitEulerUnderConstantAcceleration) {
+	constexpr auto STEPS = 100;
+	constexpr auto DT = 0.01f;
+
+	auto positions = std::vector<Distance>(PARTICLES);
+	auto velocities = std::vector<Speed>(PARTICLES);
+	auto accelerations = std::vector<Acceleration>(PARTICLES);
+	for (auto i = 0u; i < PARTICLES; ++i) {
+		positions[i] = makeValue<Metres>(static_cast<float>(i));
+		velocities[i] = makeValue<MPS>(1.0f);
+		accelerations[i] = makeValue<MPS2>(-9.81f);
+	}
+
+	for (auto step = 0; step < STEPS; ++step) {
+		semiImplicitEuler(positions.data(), velocities.data(), accelerations.data(), PARTICLES, makeValue<Seconds>(DT));
+	}
+
+	// x_n = x_0 + v_0 * t + a * dt^2 * n * (n + 1) / 2
+	const auto t = STEPS * DT;
+	const auto expectedOffset = t - 9.81f * DT * DT * STEPS * (STEPS + 1) / 2.0f;
+	for (auto i = 0u; i < PARTICLES; ++i) {
+		EXPECT_NEAR(positions[i].value<Metres>(), static_cast<float>(i) + expectedOffset, 1e-3f);
+		EXPECT_NEAR(velocities[i].value<MPS>(), 1.0f - 9.81f * t, 1e-3f);
+	}
+}
+
+TEST(IntegrationTest, VelocityVerletIsExactUnderConstantAcceleration) {
+	constexpr auto STEPS = 100;
+
+	auto positions = std::vector<Distance>(PARTICLES, 0_m);
+	auto velocities = std::vector<Speed>(PARTICLES, 1_mps);
+	auto accelerations = std::vector<Acceleration>(PARTICLES, -9.81_mps2);
+
+	for (auto step = 0; step < STEPS; ++step) {
+		velocityVerlet(positions.data(), velocities.data(), accelerations.data(), PARTICLES, 10_ms,
+			[](const Distance*, Acceleration*, std::size_t) {
+			});
+	}
+
+	for (auto i = 0u; i < PARTICLES; ++i) {
+		EXPECT_NEAR(positions[i].value<Metres>(), 1.0f - 0.5f * 9.81f, 1e-3f);
+		EXPECT_NEAR(velocities[i].value<MPS>(), 1.0f - 9.81f, 1e-3f);
+	}
+}
+
+TEST(IntegrationTest, VelocityVerletConservesOscillatorEnergy) {
+	constexpr auto STEPS = 1000;
+	const auto stiffness = 4.0_mps2 / 1_m;
+
+	auto positions = std::vector<Distance>(PARTICLES, 1_m);
+	auto velocities = std::vector<Speed>(PARTICLES, 0_mps);
+	auto accelerations = std::vector<Acceleration>(PARTICLES);
+	const auto computeAccelerations = [stiffness](const Distance* xs, Acceleration* as, std::size_t count) {
+		for (auto i = 0u; i < count; ++i) {
+			as[i] = -1.0f * stiffness * xs[i];
+		}
+	};
+	computeAccelerations(positions.data(), accelerations.data(), PARTICLES);
+
+	for (auto step = 0; step < STEPS; ++step) {
+		velocityVerlet(positions.data(), velocities.data(), accelerations.data(), PARTICLES, 10_ms, computeAccelerations);
+	}
+
+	for (auto i = 0u; i < PARTICLES; ++i) {
+		const auto x = positions[i].value<Metres>();
+		const auto v = velocities[i].value<MPS>();
+		EXPECT_NEAR(v * v + 4.0f * x * x, 4.0f, 1e-3f);
+	}
+}
+
+TEST(IntegrationTest, ConvertsMixedUnits) {
+	auto positions = std::vector<Value<Kilometres>>(PARTICLES, 1_km);
+	auto velocities = std::vector<Value<KPH>>(PARTICLES, 36_kph);
+	const auto accelerations = std::vector<Acceleration>(PARTICLES, 1_mps2);
+
+	semiImplicitEuler(positions.data(), velocities.data(), accelerations.data(), PARTICLES, 1000_ms);
+
+	for (auto i = 0u; i < PARTICLES; ++i) {
+		// 10 m/s + 1 m/s^2 * 1 s = 11 m/s, covering 11 m in the second
+		EXPECT_NEAR(velocities[i].value<MPS>(), 11.0f, 1e-4f);
+		EXPECT_NEAR(positions[i].value<Metres>(), 1011.0f, 1e-2f);
+	}
+}
+
+TEST(IntegrationTest, ChunkedStepMatchesSerialStep) {
+	constexpr auto COUNT = std::size_t{1001};
+
+	auto serialPositions = std::vector<Distance>(COUNT);
+	auto serialVelocities = std::vector<Speed>(COUNT);
+	auto accelerations = std::vector<Acceleration>(COUNT);
+	for (auto i = 0u; i < COUNT; ++i) {
+		serialPositions[i] = makeValue<Metres>(static_cast<float>(i));
+		serialVelocities[i] = makeValue<MPS>(static_cast<float>(i % 7));
+		accelerations[i] = makeValue<MPS2>(static_cast<float>(i % 5) - 2.0f);
+	}
+	auto chunkedPositions = serialPositions;
+	auto chunkedVelocities = serialVelocities;
+
+	semiImplicitEuler(serialPositions.data(), serialVelocities.data(), accelerations.data(), COUNT, 0.1_s);
+	semiImplicitEuler(chunkedPositions.data(), chunkedVelocities.data(), accelerations.data(), COUNT, 0.1_s,
+		Chunking{4, 100});
+
+	for (auto i = 0u; i < COUNT; ++i) {
+		EXPECT_EQ(chunkedPositions[i].value<Metres>(), serialPositions[i].value<Metres>());
+		EXPECT_EQ(chunkedVelocities[i].value<MPS>(), serialVelocities[i].value<MPS>());
+	}
+}
+
+} // anonymous namespace
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "type-safety/metrics.hpp"
+
+using namespace type_safety;
+using namespace type_safety::unit_literals;
+
+namespace /* anonymous */ {
+
+template <class FunctionT>
+void runThreads(int threadCount, FunctionT function) {
+	auto threads = std::vector<std::thread>{};
+	for (auto thread = 0; thread < threadCount; ++thread) {
+		threads.emplace_back(function);
+	}
+	for (auto& thread : threads) {
+		thread.join();
+	}
+}
+
+TEST(MetricsTest, ShardCountIsAPowerOfTwo) {
+	const auto counter = Counter<Metres>{};
+	EXPECT_GE(counter.shardCount(), 1u);
+	EXPECT_EQ(counter.shardCount() & (counter.shardCount() - 1), 0u);
+	EXPECT_EQ(Gauge<Kilograms>{4}.shardCount(), 4u);
+}
+
+TEST(MetricsTest, CounterKeepsItsUnit) {
+	auto counter = Counter<Metres>{};
+	counter.add(1.5_m);
+	counter.add(2_km);
+
+	const auto total = counter.value();
+	static_assert(std::is_same_v<decltype(total), const Value<Metres>>);
+	EXPECT_FLOAT_EQ(total.value<Metres>(), 2001.5f);
+}
+
+TEST(MetricsTest, CounterMergesThreads) {
+	constexpr auto THREADS = 8;
+	constexpr auto ADDS = 10000;
+
+	auto counter = Counter<Joules>{2};
+	runThreads(THREADS, [&counter]() {
+		for (auto i = 0; i < ADDS; ++i) {
+			counter.add(0.25_J);
+		}
+	});
+
+	EXPECT_FLOAT_EQ(counter.value().value<Joules>(), THREADS * ADDS * 0.25f);
+}
+
+TEST(MetricsTest, CounterDoesNotLoseSmallIncrementsOnLargeTotals) {
+	auto counter = Counter<Metres>{1};
+	counter.add(100_km);
+	auto floatTotal = (100_km).value<Metres>();
+	for (auto i = 0; i < 1000; ++i) {
+		counter.add(makeValue<Milimetres>(1.0f));
+		floatTotal += 0.001f;
+	}
+
+	EXPECT_FLOAT_EQ(counter.value().value<Metres>(), 100001.0f);
+	EXPECT_NE(floatTotal, 100001.0f);
+}
+
+TEST(MetricsTest, CounterResets) {
+	auto counter = Counter<Seconds>{};
+	counter.add(3_s);
+	counter.reset();
+	EXPECT_EQ(counter.value(), 0_s);
+}
+
+TEST(MetricsTest, GaugeGoesUpAndDown) {
+	constexpr auto THREADS = 4;
+	constexpr auto LOADS = 1000;
+
+	auto inTransit = Gauge<Kilograms>{};
+	runThreads(THREADS, [&inTransit]() {
+		for (auto i = 0; i < LOADS; ++i) {
+			inTransit.add(2_kg);
+			inTransit.subtract(1500_g);
+		}
+	});
+
+	EXPECT_FLOAT_EQ(inTransit.value().value<Kilograms>(), THREADS * LOADS * 0.5f);
+}
+
+TEST(MetricsTest, GaugeSetReplacesAllShards) {
+	auto gauge = Gauge<Kilograms>{4};
+	runThreads(4, [&gauge]() {
+		gauge.add(1_kg);
+	});
+	gauge.set(250_g);
+	EXPECT_FLOAT_EQ(gauge.value().value<Grams>(), 250.0f);
+
+	gauge.subtract(1_kg);
+	EXPECT_FLOAT_EQ(gauge.value().value<Kilograms>(), -0.75f);
+}
+
+TEST(MetricsTest, CoarserQuantumRounds) {
+	auto counter = Counter<Metres, std::milli>{1};
+	counter.add(makeValue<Metres>(0.0004f));
+	counter.add(makeValue<Metres>(0.0006f));
+	EXPECT_FLOAT_EQ(counter.value().value<Metres>(), 0.001f);
+}
+
+} // anonymous namespace
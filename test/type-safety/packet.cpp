@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "type-safety/packet.hpp"
+#include "type-safety/XformFixtures.hpp"
+
+using namespace type_safety;
+
+namespace /* anonymous */ {
+
+template <std::size_t W>
+struct Width : std::integral_constant<std::size_t, W> {
+};
+
+template <class WidthT>
+class PacketTest : public testing::Test {
+public:
+
+	static constexpr auto W = WidthT::value;
+
+	static float laneValue(std::size_t lane) {
+		return static_cast<float>(lane) * 0.5f - 2.0f;
+	}
+
+};
+
+using Widths = testing::Types<Width<4>, Width<8>, Width<16>>;
+TYPED_TEST_CASE(PacketTest, Widths);
+
+// The packet and scalar paths may contract multiplications and additions into FMAs
+// differently, so sums of terms of up to magnitude, possibly cancelling to zero, agree within
+// a few ulp of magnitude rather than of the result.
+void expectVec3Near(const Vec3& actual, const Vec3& expected, float magnitude) {
+	for (auto i = 0u; i < 3u; ++i) {
+		EXPECT_NEAR(actual.get(i), expected.get(i), 4.0f * std::numeric_limits<float>::epsilon() * magnitude);
+	}
+}
+
+TYPED_TEST(PacketTest, ValueArithmeticsMatchScalars) {
+	constexpr auto W = TestFixture::W;
+	auto distances = std::vector<Value<Metres>>{};
+	auto times = std::vector<Value<Seconds>>{};
+	for (auto lane = 0u; lane < W; ++lane) {
+		distances.push_back(makeValue<Metres>(TestFixture::laneValue(lane)));
+		times.push_back(makeValue<Seconds>(1.0f + lane));
+	}
+
+	const auto d = ValueN<Metres, W>::load(distances.data());
+	const auto t = ValueN<Seconds, W>::load(times.data());
+	const auto offset = ValueN<Kilometres, W>{makeValue<Kilometres>(0.001f)};
+
+	const auto speeds = (d + offset - d * 0.5f) / t;
+	static_assert(std::is_same_v<decltype(speeds), const ValueN<MPS, W>>);
+
+	auto stored = std::vector<Value<MPS>>(W);
+	speeds.store(stored.data());
+	for (auto lane = 0u; lane < W; ++lane) {
+		const auto expected = (distances[lane] + makeValue<Kilometres>(0.001f) - distances[lane] * 0.5f) / times[lane];
+		EXPECT_FLOAT_EQ(stored[lane].template value<MPS>(), expected.value<MPS>());
+		EXPECT_FLOAT_EQ(speeds.get(lane).template value<MPS>(), expected.value<MPS>());
+	}
+}
+
+TYPED_TEST(PacketTest, ValueConvertsBetweenCompatibleUnits) {
+	constexpr auto W = TestFixture::W;
+	const auto kms = ValueN<Kilometres, W>{makeValue<Kilometres>(2.0f)};
+	const auto ms = ValueN<Metres, W>{kms};
+
+	for (auto lane = 0u; lane < W; ++lane) {
+		EXPECT_FLOAT_EQ(ms.get(lane).template value<Metres>(), 2000.0f);
+		EXPECT_FLOAT_EQ(kms.template values<Metres>().get(lane), 2000.0f);
+	}
+}
+
+TYPED_TEST(PacketTest, AngleArithmeticsMatchScalars) {
+	constexpr auto W = TestFixture::W;
+	auto angles = std::vector<Angle>{};
+	for (auto lane = 0u; lane < W; ++lane) {
+		angles.push_back(Angle{radiansTag, TestFixture::laneValue(lane)});
+	}
+
+	const auto a = AngleN<W>::load(angles.data());
+	const auto result = -(a * 2.0f - AngleN<W>{Angle{degreesTag, 90.0f}}) / 4.0f + a;
+
+	auto stored = std::vector<Angle>(W, Angle{radiansTag, 0.0f});
+	result.store(stored.data());
+	for (auto lane = 0u; lane < W; ++lane) {
+		const auto expected = -(angles[lane] * 2.0f - Angle{degreesTag, 90.0f}) / 4.0f + angles[lane];
+		EXPECT_FLOAT_EQ(stored[lane].radians(), expected.radians());
+		EXPECT_FLOAT_EQ(result.get(lane).radians(), expected.radians());
+	}
+}
+
+TYPED_TEST(PacketTest, Vec3LoadsAndStoresBlocksAndInterleavedTriples) {
+	constexpr auto W = TestFixture::W;
+	auto interleaved = std::vector<float>{};
+	for (auto lane = 0u; lane < W; ++lane) {
+		const auto f = TestFixture::laneValue(lane);
+		interleaved.insert(interleaved.end(), { f, 2.0f * f, -f });
+	}
+
+	const auto v = Vec3N<W>::loadInterleaved(interleaved.data());
+	auto block = Vec3Block<W>{};
+	v.store(block);
+	for (auto lane = 0u; lane < W; ++lane) {
+		EXPECT_FLOAT_EQ(block.x[lane], interleaved[3 * lane]);
+		EXPECT_FLOAT_EQ(block.y[lane], interleaved[3 * lane + 1]);
+		EXPECT_FLOAT_EQ(block.z[lane], interleaved[3 * lane + 2]);
+	}
+
+	auto roundTripped = std::vector<float>(3 * W);
+	Vec3N<W>::load(block).storeInterleaved(roundTripped.data());
+	EXPECT_EQ(roundTripped, interleaved);
+}
+
+TYPED_TEST(PacketTest, PointsAndVectorsMatchCompactPoints) {
+	constexpr auto W = TestFixture::W;
+	auto points = std::vector<CompactPoint<space::World, Metres>>{};
+	auto vectors = std::vector<CompactVector<space::World, Kilometres>>{};
+	for (auto lane = 0u; lane < W; ++lane) {
+		const auto f = TestFixture::laneValue(lane);
+		points.emplace_back(Vec3{f, -f, 2.0f * f});
+		vectors.emplace_back(Vec3{0.001f * f, 0.002f, -0.001f});
+	}
+
+	const auto p = PointN<space::World, Metres, W>::load(points.data());
+	const auto v = VectorN<space::World, Kilometres, W>::load(vectors.data());
+	const auto moved = p + v - (p - p) * 2.0f;
+	const auto lengthsSquared = dot(v, v);
+	static_assert(std::is_same_v<decltype(moved), const PointN<space::World, Metres, W>>);
+
+	auto stored = std::vector<CompactPoint<space::World, Metres>>(W);
+	moved.store(stored.data());
+	for (auto lane = 0u; lane < W; ++lane) {
+		const auto expected = points[lane] + vectors[lane] - (points[lane] - points[lane]) * 2.0f;
+		// The largest operand, p's z or v's y in metres
+		const auto magnitude = std::max(2.0f * std::abs(TestFixture::laneValue(lane)), 2.0f);
+		expectVec3Near(stored[lane].xyz(), expected.xyz(), magnitude);
+		expectVec3Near(moved.get(lane).xyz(), expected.xyz(), magnitude);
+
+		const auto& xyz = vectors[lane].xyz();
+		const auto expectedLengthSquared = xyz.get(0) * xyz.get(0) + xyz.get(1) * xyz.get(1) + xyz.get(2) * xyz.get(2);
+		EXPECT_FLOAT_EQ(lengthsSquared.get(lane).template value<decltype(Kilometres{} * Kilometres{})>(), expectedLengthSquared);
+	}
+}
+
+TYPED_TEST(PacketTest, XformApplyMatchesCompactPoints) {
+	constexpr auto W = TestFixture::W;
+	const auto xform = fixtures::affineXform<space::World, space::Camera>();
+	auto points = std::vector<CompactPoint<space::World, Metres>>{};
+	auto vectors = std::vector<CompactVector<space::World, Metres>>{};
+	for (auto lane = 0u; lane < W; ++lane) {
+		const auto f = TestFixture::laneValue(lane);
+		points.emplace_back(Vec3{f, -f, 2.0f * f});
+		vectors.emplace_back(Vec3{-f, f, 0.5f * f});
+	}
+
+	const auto transformedPoints = applyPacket(xform, PointN<space::World, Metres, W>::load(points.data()));
+	const auto transformedVectors = applyPacket(xform, VectorN<space::World, Metres, W>::load(vectors.data()));
+	static_assert(std::is_same_v<decltype(transformedPoints), const PointN<space::Camera, Metres, W>>);
+
+	for (auto lane = 0u; lane < W; ++lane) {
+		// The translation, or twice the largest coordinate
+		const auto magnitude = 30.0f + 4.0f * std::abs(TestFixture::laneValue(lane));
+		expectVec3Near(transformedPoints.get(lane).xyz(), xform.apply(points[lane]).xyz(), magnitude);
+		expectVec3Near(transformedVectors.get(lane).xyz(), xform.apply(vectors[lane]).xyz(), magnitude);
+	}
+}
+
+} // anonymous namespace
@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "type-safety/profiling.hpp"
+
+using namespace type_safety;
+using namespace type_safety::unit_literals;
+
+namespace /* anonymous */ {
+
+TEST(ProfilingTest, SmallLatenciesHaveABucketEach) {
+	for (auto nanoseconds = 0u; nanoseconds < LATENCY_SUB_BUCKETS; ++nanoseconds) {
+		EXPECT_EQ(latencyBucket(nanoseconds), nanoseconds);
+		EXPECT_EQ(latencyBucketLowerBound(nanoseconds), nanoseconds);
+		EXPECT_EQ(latencyBucketUpperBound(nanoseconds), nanoseconds + 1);
+	}
+}
+
+TEST(ProfilingTest, BucketsContainTheirBounds) {
+	for (auto bucket = std::size_t{0}; bucket + 1 < LATENCY_BUCKET_COUNT; ++bucket) {
+		const auto lower = latencyBucketLowerBound(bucket);
+		const auto upper = latencyBucketUpperBound(bucket);
+		ASSERT_LT(lower, upper);
+		EXPECT_EQ(latencyBucket(lower), bucket);
+		EXPECT_EQ(latencyBucket(upper - 1), bucket);
+		EXPECT_LE((upper - lower) * LATENCY_SUB_BUCKETS, std::max<std::uint64_t>(lower, LATENCY_SUB_BUCKETS));
+	}
+}
+
+TEST(ProfilingTest, HugeLatenciesLandInTheLastBucket) {
+	EXPECT_EQ(latencyBucket(std::uint64_t{1} << LATENCY_MAX_OCTAVE), LATENCY_BUCKET_COUNT - 1);
+	EXPECT_EQ(latencyBucket(~std::uint64_t{0}), LATENCY_BUCKET_COUNT - 1);
+	EXPECT_EQ(latencyBucket((std::uint64_t{1} << LATENCY_MAX_OCTAVE) - 1), LATENCY_BUCKET_COUNT - 1);
+}
+
+TEST(ProfilingTest, SnapshotCountsRecordedLatencies) {
+	auto histogram = LatencyHistogram{};
+	histogram.record(100_ns);
+	histogram.record(100_ns);
+	histogram.record(1.0_us);
+	histogram.recordNanoseconds(2000);
+
+	const auto snapshot = histogram.snapshot();
+	EXPECT_EQ(snapshot.count(), 4u);
+	EXPECT_EQ(snapshot.count(latencyBucket(100)), 2u);
+	EXPECT_EQ(snapshot.count(latencyBucket(1000)), 1u);
+	EXPECT_EQ(snapshot.count(latencyBucket(2000)), 1u);
+	EXPECT_FLOAT_EQ(snapshot.mean().value<Nanoseconds>(), 800.0f);
+}
+
+TEST(ProfilingTest, PercentilesAreWithinABucket) {
+	auto histogram = LatencyHistogram{};
+	for (auto nanoseconds = 1u; nanoseconds <= 1000u; ++nanoseconds) {
+		histogram.recordNanoseconds(nanoseconds);
+	}
+
+	const auto snapshot = histogram.snapshot();
+	const auto median = snapshot.percentile(0.5f).value<Nanoseconds>();
+	EXPECT_NEAR(median, 500.0f, 500.0f / LATENCY_SUB_BUCKETS);
+	const auto p99 = snapshot.percentile(0.99f).value<Nanoseconds>();
+	EXPECT_NEAR(p99, 990.0f, 990.0f / LATENCY_SUB_BUCKETS);
+	const auto max = snapshot.percentile(1.0f);
+	EXPECT_LE(snapshot.lowerBound(latencyBucket(1000)).value<Nanoseconds>(), max.value<Nanoseconds>());
+	EXPECT_GE(snapshot.upperBound(latencyBucket(1000)).value<Nanoseconds>(), max.value<Nanoseconds>());
+}
+
+TEST(ProfilingTest, EmptySnapshotIsZero) {
+	const auto snapshot = LatencySnapshot{};
+	EXPECT_EQ(snapshot.count(), 0u);
+	EXPECT_EQ(snapshot.mean().value<Nanoseconds>(), 0.0f);
+	EXPECT_EQ(snapshot.percentile(0.5f).value<Nanoseconds>(), 0.0f);
+}
+
+TEST(ProfilingTest, MergeAddsCounts) {
+	auto first = LatencyHistogram{};
+	first.recordNanoseconds(10);
+	auto second = LatencyHistogram{};
+	second.recordNanoseconds(10);
+	second.recordNanoseconds(5000);
+
+	auto snapshot = first.snapshot();
+	snapshot.merge(second.snapshot());
+	EXPECT_EQ(snapshot.count(), 3u);
+	EXPECT_EQ(snapshot.count(latencyBucket(10)), 2u);
+	EXPECT_EQ(snapshot.count(latencyBucket(5000)), 1u);
+	EXPECT_FLOAT_EQ(snapshot.mean().value<Nanoseconds>(), 5020.0f / 3.0f);
+}
+
+TEST(ProfilingTest, PerThreadHistogramMergesThreads) {
+	constexpr auto THREADS = 4;
+	constexpr auto RECORDS = 1000;
+
+	auto histogram = PerThreadLatencyHistogram{};
+	auto threads = std::vector<std::thread>{};
+	for (auto thread = 0; thread < THREADS; ++thread) {
+		threads.emplace_back([&histogram, thread]() {
+			for (auto i = 0; i < RECORDS; ++i) {
+				histogram.local().recordNanoseconds(static_cast<std::uint64_t>(thread));
+			}
+		});
+	}
+	for (auto& thread : threads) {
+		thread.join();
+	}
+
+	const auto snapshot = histogram.snapshot();
+	EXPECT_EQ(snapshot.count(), static_cast<std::uint64_t>(THREADS * RECORDS));
+	for (auto thread = 0; thread < THREADS; ++thread) {
+		EXPECT_EQ(snapshot.count(static_cast<std::size_t>(thread)), static_cast<std::uint64_t>(RECORDS));
+	}
+}
+
+TEST(ProfilingTest, LocalHistogramIsStablePerThread) {
+	auto first = PerThreadLatencyHistogram{};
+	auto second = PerThreadLatencyHistogram{};
+	EXPECT_EQ(&first.local(), &first.local());
+	EXPECT_NE(&first.local(), &second.local());
+}
+
+TEST(ProfilingTest, ScopedTimerRecordsWhenEnabled) {
+	auto histogram = PerThreadLatencyHistogram{};
+	{
+		const auto timer = ScopedTimer{histogram};
+		std::this_thread::sleep_for(std::chrono::milliseconds{1});
+	}
+
+	const auto snapshot = histogram.snapshot();
+#ifdef TYPE_SAFETY_PROFILING
+	EXPECT_EQ(snapshot.count(), 1u);
+	EXPECT_GE(snapshot.mean().value<Milliseconds>(), 0.5f);
+#else
+	EXPECT_EQ(snapshot.count(), 0u);
+#endif /* TYPE_SAFETY_PROFILING */
+}
+
+} // anonymous namespace
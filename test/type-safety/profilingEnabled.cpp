@@ -0,0 +1,62 @@
+// profiling.hpp with the ScopedTimers enabled - profiling.cpp tests it as built by default
+#define TYPE_SAFETY_PROFILING
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstddef>
+
+#include "type-safety/profiling.hpp"
+
+using namespace type_safety;
+
+namespace /* anonymous */ {
+
+constexpr auto TIMED = std::chrono::milliseconds{1};
+
+// A bucket is at most 1/8 of its lower bound wide
+constexpr auto TOLERANCE_MILLISECONDS = 1.0f / LATENCY_SUB_BUCKETS;
+
+// Spins rather than sleeps, so that the thread isn't descheduled for longer than asked
+void busyWait(std::chrono::steady_clock::duration duration) {
+	const auto start = std::chrono::steady_clock::now();
+	while (std::chrono::steady_clock::now() - start < duration) {
+	}
+}
+
+void expectOneMillisecondSample(const LatencySnapshot& snapshot) {
+	ASSERT_EQ(snapshot.count(), 1u);
+	EXPECT_NEAR(snapshot.mean().value<Milliseconds>(), 1.0f, TOLERANCE_MILLISECONDS);
+	EXPECT_NEAR(snapshot.percentile(0.5f).value<Milliseconds>(), 1.0f, TOLERANCE_MILLISECONDS);
+}
+
+TEST(ProfilingEnabledTest, ScopedTimerRecordsIntoHistogram) {
+	auto histogram = LatencyHistogram{};
+	{
+		const auto timer = ScopedTimer{histogram};
+		busyWait(TIMED);
+	}
+
+	expectOneMillisecondSample(histogram.snapshot());
+}
+
+TEST(ProfilingEnabledTest, ScopedTimerRecordsIntoLocalHistogram) {
+	auto histogram = PerThreadLatencyHistogram{};
+	{
+		const auto timer = ScopedTimer{histogram};
+		busyWait(TIMED);
+	}
+
+	expectOneMillisecondSample(histogram.local().snapshot());
+	expectOneMillisecondSample(histogram.snapshot());
+}
+
+TEST(ProfilingEnabledTest, ClockConvertsTicksToNanoseconds) {
+	const auto start = detail::ProfilingClock::start();
+	busyWait(TIMED);
+	const auto nanoseconds = detail::ProfilingClock::toNanoseconds(detail::ProfilingClock::now() - start);
+
+	EXPECT_NEAR(static_cast<float>(nanoseconds) / 1e6f, 1.0f, TOLERANCE_MILLISECONDS);
+}
+
+} // anonymous namespace
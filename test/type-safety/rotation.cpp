@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <cmath>
+#include <vector>
+
+#include "type-safety/rotation.hpp"
+
+using namespace type_safety;
+using namespace type_safety::angle_literals;
+
+namespace /* anonymous */ {
+
+Matrix referenceAxisRotation(int axis, Angle a) {
+	const auto s = std::sin(a.radians());
+	const auto c = std::cos(a.radians());
+	const auto u = static_cast<std::size_t>((axis + 1) % 3);
+	const auto v = static_cast<std::size_t>((axis + 2) % 3);
+
+	auto result = Matrix{};
+	for (auto row = 0u; row < 4u; ++row) {
+		for (auto column = 0u; column < 4u; ++column) {
+			result.get(row, column) = (row == column) ? 1.0f : 0.0f;
+		}
+	}
+	result.get(u, u) = c;
+	result.get(u, v) = -s;
+	result.get(v, u) = s;
+	result.get(v, v) = c;
+	return result;
+}
+
+Matrix referenceRotation(Angle pitch, Angle yaw, Angle roll, const int (&axes)[3]) {
+	const Angle angles[] = { pitch, yaw, roll };
+	auto result = referenceAxisRotation(axes[0], angles[axes[0]]);
+	result = referenceAxisRotation(axes[1], angles[axes[1]]) * result;
+	result = referenceAxisRotation(axes[2], angles[axes[2]]) * result;
+	return result;
+}
+
+void expectMatrixNear(const Matrix& actual, const Matrix& expected, float maxError) {
+	for (auto row = 0u; row < 4u; ++row) {
+		for (auto column = 0u; column < 4u; ++column) {
+			EXPECT_NEAR(actual.get(row, column), expected.get(row, column), maxError)
+				<< "at (" << row << ", " << column << ")";
+		}
+	}
+}
+
+TEST(RotationTest, EulerRotationMatchesElementaryRotationProduct) {
+	const RotationOrder orders[] = {
+		RotationOrder::XYZ, RotationOrder::XZY, RotationOrder::YXZ,
+		RotationOrder::YZX, RotationOrder::ZXY, RotationOrder::ZYX,
+		};
+	const int axes[][3] = { { 0, 1, 2 }, { 0, 2, 1 }, { 1, 0, 2 }, { 1, 2, 0 }, { 2, 0, 1 }, { 2, 1, 0 } };
+
+	for (auto i = 0u; i < 6u; ++i) {
+		const auto xform = makeRotationXform<space::World, space::Camera>(0.42_rad, 3.14_rad, -2.71_rad, orders[i]);
+		expectMatrixNear(xform.matrix(), referenceRotation(0.42_rad, 3.14_rad, -2.71_rad, axes[i]), 1e-6f);
+	}
+}
+
+TEST(RotationTest, RotatesPointsRightHanded) {
+	const auto yawLeft = makeRotationXform<space::World, space::Player>(0.0_rad, 90.0_deg, 0.0_rad, RotationOrder::ZXY);
+	const auto p = yawLeft.apply(Point<space::World>{Vec3{1.0f, 2.0f, 3.0f}});
+
+	EXPECT_NEAR(p.vector().get(0), 3.0f, 1e-6f);
+	EXPECT_NEAR(p.vector().get(1), 2.0f, 1e-6f);
+	EXPECT_NEAR(p.vector().get(2), -1.0f, 1e-6f);
+	EXPECT_EQ(p.vector().get(3), 1.0f);
+}
+
+TEST(RotationTest, AxisAngleRotationMatchesEulerRotation) {
+	const auto aboutX = makeRotationXform<space::World, space::Camera>(Vector<space::World>{Vec3{1.0f, 0.0f, 0.0f}}, 0.7_rad);
+	const auto aboutY = makeRotationXform<space::World, space::Camera>(Vector<space::World>{Vec3{0.0f, 1.0f, 0.0f}}, 0.7_rad);
+	const auto aboutZ = makeRotationXform<space::World, space::Camera>(Vector<space::World>{Vec3{0.0f, 0.0f, 1.0f}}, 0.7_rad);
+
+	expectMatrixNear(aboutX.matrix(), referenceAxisRotation(0, 0.7_rad), 1e-6f);
+	expectMatrixNear(aboutY.matrix(), referenceAxisRotation(1, 0.7_rad), 1e-6f);
+	expectMatrixNear(aboutZ.matrix(), referenceAxisRotation(2, 0.7_rad), 1e-6f);
+
+	const auto k = 1.0f / std::sqrt(3.0f);
+	const auto diagonal = makeRotationXform<space::World, space::Camera>(Vector<space::World>{Vec3{k, k, k}}, 120.0_deg);
+	const auto p = diagonal.apply(Point<space::World>{Vec3{1.0f, 0.0f, 0.0f}});
+	EXPECT_NEAR(p.vector().get(0), 0.0f, 1e-6f);
+	EXPECT_NEAR(p.vector().get(1), 1.0f, 1e-6f);
+	EXPECT_NEAR(p.vector().get(2), 0.0f, 1e-6f);
+}
+
+TEST(RotationTest, BatchMatchesSingleRotation) {
+	// Not a multiple of the packet width, so that the tail is exercised too
+	const auto count = 11u;
+	auto pitches = std::vector<Angle>{};
+	auto yaws = std::vector<Angle>{};
+	auto rolls = std::vector<Angle>{};
+	for (auto i = 0u; i < count; ++i) {
+		pitches.emplace_back(radiansTag, 0.3f * static_cast<float>(i));
+		yaws.emplace_back(radiansTag, -0.7f * static_cast<float>(i));
+		rolls.emplace_back(radiansTag, 1.1f * static_cast<float>(i));
+	}
+
+	auto xforms = std::vector<Xform<space::World, space::Camera>>(count);
+	makeRotationXforms(pitches.data(), yaws.data(), rolls.data(), RotationOrder::YXZ, xforms.data(), count);
+
+	for (auto i = 0u; i < count; ++i) {
+		const auto expected =
+			makeRotationXform<space::World, space::Camera>(pitches[i], yaws[i], rolls[i], RotationOrder::YXZ);
+		// Within rounding, as the compiler may contract the SIMD and scalar kernels differently
+		expectMatrixNear(xforms[i].matrix(), expected.matrix(), 1e-6f);
+	}
+}
+
+} // anonymous namespace
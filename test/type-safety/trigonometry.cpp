@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <cmath>
+#include <vector>
+
+#include "type-safety/trigonometry.hpp"
+
+using namespace type_safety;
+using namespace type_safety::angle_literals;
+
+namespace /* anonymous */ {
+
+std::vector<Angle> angleRange(float from, float to, std::size_t count) {
+	auto result = std::vector<Angle>{};
+	result.reserve(count);
+	for (auto i = 0u; i < count; ++i) {
+		result.emplace_back(radiansTag, from + (to - from) * static_cast<float>(i) / static_cast<float>(count - 1));
+	}
+	return result;
+}
+
+template <TrigPrecision PRECISION>
+void expectSinCosWithin(float range, double maxError) {
+	// Odd count so that the batch tail is exercised too
+	const auto angles = angleRange(-range, range, 10001);
+	auto sines = std::vector<float>(angles.size());
+	auto cosines = std::vector<float>(angles.size());
+
+	sincos<PRECISION>(angles.data(), sines.data(), cosines.data(), angles.size());
+
+	for (auto i = 0u; i < angles.size(); ++i) {
+		const auto x = static_cast<double>(angles[i].radians());
+		EXPECT_NEAR(sines[i], std::sin(x), maxError) << "x = " << x;
+		EXPECT_NEAR(cosines[i], std::cos(x), maxError) << "x = " << x;
+		EXPECT_NEAR(sin<PRECISION>(angles[i]), sines[i], 1e-7);
+		EXPECT_NEAR(cos<PRECISION>(angles[i]), cosines[i], 1e-7);
+	}
+}
+
+TEST(TrigonometryTest, FastSinCosErrorBound) {
+	expectSinCosWithin<TrigPrecision::FAST>(PI, 3.5e-5);
+	expectSinCosWithin<TrigPrecision::FAST>(1000.0f, 7e-5);
+}
+
+TEST(TrigonometryTest, MediumSinCosErrorBound) {
+	expectSinCosWithin<TrigPrecision::MEDIUM>(PI, 1.5e-7);
+	expectSinCosWithin<TrigPrecision::MEDIUM>(1000.0f, 1.5e-7);
+}
+
+TEST(TrigonometryTest, AccurateSinCosErrorBound) {
+	expectSinCosWithin<TrigPrecision::ACCURATE>(PI, 1e-7);
+	expectSinCosWithin<TrigPrecision::ACCURATE>(1000.0f, 1e-7);
+}
+
+TEST(TrigonometryTest, QuadrantSigns) {
+	EXPECT_NEAR(sin(90_deg), 1.0f, 1e-6f);
+	EXPECT_NEAR(sin(-90_deg), -1.0f, 1e-6f);
+	EXPECT_NEAR(cos(180_deg), -1.0f, 1e-6f);
+	EXPECT_NEAR(cos(270_deg), 0.0f, 1e-6f);
+	EXPECT_NEAR(sin(210_deg), -0.5f, 1e-6f);
+	EXPECT_NEAR(tan(45_deg), 1.0f, 1e-6f);
+	EXPECT_NEAR(tan(-60_deg), -std::sqrt(3.0f), 1e-5f);
+
+	auto angles = std::vector<Angle>{30_deg, 45_deg, 120_deg, -135_deg, 300_deg};
+	auto tangents = std::vector<float>(angles.size());
+	tan(angles.data(), tangents.data(), angles.size());
+	for (auto i = 0u; i < angles.size(); ++i) {
+		EXPECT_NEAR(tangents[i], std::tan(angles[i].radians()), 1e-5f);
+	}
+}
+
+TEST(TrigonometryTest, Atan2ReturnsAngleInAllOctants) {
+	static_assert(std::is_same_v<decltype(type_safety::atan2(1.0f, 1.0f)), Angle>);
+
+	auto ys = std::vector<float>{};
+	auto xs = std::vector<float>{};
+	for (auto y = -3.0f; y <= 3.0f; y += 0.25f) {
+		for (auto x = -3.0f; x <= 3.0f; x += 0.25f) {
+			ys.push_back(y);
+			xs.push_back(x);
+		}
+	}
+
+	auto results = std::vector<Angle>(ys.size());
+	type_safety::atan2(ys.data(), xs.data(), results.data(), ys.size());
+
+	for (auto i = 0u; i < ys.size(); ++i) {
+		const auto expected = std::atan2(static_cast<double>(ys[i]), static_cast<double>(xs[i]));
+		EXPECT_NEAR(results[i].radians(), expected, 4e-7);
+		EXPECT_NEAR(type_safety::atan2<TrigPrecision::ACCURATE>(ys[i], xs[i]).radians(), expected, 4e-7);
+		EXPECT_NEAR(type_safety::atan2<TrigPrecision::FAST>(ys[i], xs[i]).radians(), expected, 7e-4);
+	}
+
+	EXPECT_EQ(type_safety::atan2(0.0f, 0.0f), 0_rad);
+	EXPECT_NEAR(type_safety::atan2(0.0f, -1.0f).radians(), detail::FULL_PI, 1e-7f);
+}
+
+} // anonymous namespace
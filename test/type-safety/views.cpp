@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "type-safety/views.hpp"
+
+using namespace type_safety;
+
+namespace /* anonymous */ {
+
+using PlayerPoint = Point<space::Player, Metres>;
+using WorldPoint = Point<space::World, Metres>;
+using CameraPoint = Point<space::Camera, Metres>;
+
+Matrix translation(float x, float y, float z) {
+	auto matrix = Matrix{};
+	for (auto row = 0u; row < 4u; ++row) {
+		for (auto column = 0u; column < 4u; ++column) {
+			matrix.get(row, column) = row == column ? 1.0f : 0.0f;
+		}
+	}
+	matrix.get(0, 3) = x;
+	matrix.get(1, 3) = y;
+	matrix.get(2, 3) = z;
+	return matrix;
+}
+
+Matrix scale(float factor) {
+	auto matrix = translation(0.0f, 0.0f, 0.0f);
+	for (auto axis = 0u; axis < 3u; ++axis) {
+		matrix.get(axis, axis) = factor;
+	}
+	return matrix;
+}
+
+// More points than a block, so forEach goes through a full block and a partial one
+std::vector<PlayerPoint> makePoints() {
+	auto points = std::vector<PlayerPoint>{};
+	for (auto i = 0u; i < views::BLOCK_SIZE + 10u; ++i) {
+		points.emplace_back(Vec3{static_cast<float>(i), 1.0f, -static_cast<float>(i)});
+	}
+	return points;
+}
+
+template <class ViewT>
+std::vector<typename ViewT::value_type> collectForEach(const ViewT& view) {
+	auto result = std::vector<typename ViewT::value_type>{};
+	view.forEach([&](const auto& point) { result.push_back(point); });
+	return result;
+}
+
+template <class ViewT>
+std::vector<typename ViewT::value_type> collectIterated(const ViewT& view) {
+	auto result = std::vector<typename ViewT::value_type>{};
+	std::copy(view.begin(), view.end(), std::back_inserter(result));
+	return result;
+}
+
+template <class SpaceT>
+void expectPointsEq(const std::vector<Point<SpaceT, Metres>>& actual, const std::vector<Point<SpaceT, Metres>>& expected) {
+	ASSERT_EQ(actual.size(), expected.size());
+	for (auto i = 0u; i < actual.size(); ++i) {
+		for (auto coordinate = 0u; coordinate < 4u; ++coordinate) {
+			EXPECT_FLOAT_EQ(actual[i].vector().get(coordinate), expected[i].vector().get(coordinate));
+		}
+	}
+}
+
+TEST(ViewsTest, XformedAppliesXform) {
+	const auto points = makePoints();
+	const auto playerToWorld = Xform<space::Player, space::World>{translation(1.0f, 2.0f, 3.0f)};
+
+	auto expected = std::vector<WorldPoint>{};
+	for (const auto& point : points) {
+		expected.push_back(playerToWorld.apply(point));
+	}
+
+	const auto view = points | views::xformed(playerToWorld);
+	expectPointsEq(collectForEach(view), expected);
+	expectPointsEq(collectIterated(view), expected);
+}
+
+TEST(ViewsTest, ConsecutiveXformsFoldIntoOne) {
+	const auto points = makePoints();
+	const auto playerToWorld = Xform<space::Player, space::World>{translation(1.0f, 2.0f, 3.0f)};
+	const auto worldToCamera = Xform<space::World, space::Camera>{scale(2.0f)};
+
+	const auto view = points | views::xformed(playerToWorld) | views::xformed(worldToCamera);
+	static_assert(std::is_same_v<
+		std::decay_t<decltype(view)>,
+		XformedView<PointSpan<PlayerPoint>, space::Player, space::Camera>
+		>);
+
+	auto expected = std::vector<CameraPoint>{};
+	for (const auto& point : points) {
+		expected.push_back(worldToCamera.apply(playerToWorld.apply(point)));
+	}
+	expectPointsEq(collectForEach(view), expected);
+	expectPointsEq(collectIterated(view), expected);
+}
+
+TEST(ViewsTest, FilteredKeepsAcceptedPoints) {
+	const auto points = makePoints();
+	const auto playerToWorld = Xform<space::Player, space::World>{translation(-10.0f, 0.0f, 0.0f)};
+	const auto inFront = [](const WorldPoint& point) { return point.vector().get(0) > 0.0f; };
+
+	auto expected = std::vector<WorldPoint>{};
+	for (const auto& point : points) {
+		const auto worldPoint = playerToWorld.apply(point);
+		if (inFront(worldPoint)) {
+			expected.push_back(worldPoint);
+		}
+	}
+
+	const auto view = points | views::xformed(playerToWorld) | views::filtered(inFront);
+	expectPointsEq(collectForEach(view), expected);
+	expectPointsEq(collectIterated(view), expected);
+}
+
+TEST(ViewsTest, XformsAfterFilter) {
+	const auto points = makePoints();
+	const auto playerToWorld = Xform<space::Player, space::World>{translation(0.0f, 0.0f, 5.0f)};
+	const auto even = [](const PlayerPoint& point) { return static_cast<int>(point.vector().get(0)) % 2 == 0; };
+
+	auto expected = std::vector<WorldPoint>{};
+	for (const auto& point : points) {
+		if (even(point)) {
+			expected.push_back(playerToWorld.apply(point));
+		}
+	}
+
+	const auto view = views::all(points.data(), points.size()) | views::filtered(even) | views::xformed(playerToWorld);
+	expectPointsEq(collectForEach(view), expected);
+	expectPointsEq(collectIterated(view), expected);
+}
+
+TEST(ViewsTest, EmptySourceYieldsNothing) {
+	const auto points = std::vector<PlayerPoint>{};
+	const auto view = points | views::xformed(Xform<space::Player, space::World>{translation(1.0f, 0.0f, 0.0f)});
+	EXPECT_TRUE(collectForEach(view).empty());
+	EXPECT_EQ(view.begin(), view.end());
+}
+
+} // anonymous namespace